@@ -212,6 +212,9 @@ COMMON_C_DEFS += \
 	-DUSE_FLASH_READ_MODIFY_WRITE\
 	-DUSE_FUOTA
 LBM_BUILD_OPTIONS += LBM_FUOTA=yes LBM_FUOTA_VERSION=$(FUOTA_VERSION)
+ifeq ($(FUOTA_MATRIX_IN_FLASH),yes)
+LBM_BUILD_OPTIONS += LBM_FUOTA_MATRIX_IN_FLASH=yes
+endif
 endif
 
 ifeq ($(ALLOW_STORE_AND_FORWARD),yes)
@@ -220,9 +223,15 @@ COMMON_C_DEFS += \
 LBM_BUILD_OPTIONS += LBM_STORE_AND_FORWARD=yes
 endif
 
+ifeq ($(USE_FLASH_KV),yes)
+COMMON_C_DEFS += \
+	-DUSE_FLASH_KV_STORE
+endif
+
 ifneq ($(LBM_NB_OF_STACK),1)
 COMMON_C_DEFS += \
-	-DMULTISTACK
+	-DMULTISTACK \
+	-DNUMBER_OF_STACKS=$(LBM_NB_OF_STACK)
 endif
 
 ifeq ($(APP_DEBUG),yes)
@@ -28,10 +28,15 @@ MODEM_APP_REGION ?= nc
 # Allow fuota (take more RAM, due to read_modify_write feature) and force lbm build with fuota
 ALLOW_FUOTA ?= no
 FUOTA_VERSION ?= 1
+# Keep the FUOTA v2 decoder parity matrix in flash instead of RAM (only on STM32L4)
+FUOTA_MATRIX_IN_FLASH ?= no
 
 # USE LBM Store and forward (take more RAM on STML4, due to read_modify_write feature)
 ALLOW_STORE_AND_FORWARD ?= no
 
+# Save modem, key, lorawan and secure element contexts in a wear-levelled log-structured store (only on STM32L4)
+USE_FLASH_KV ?= no
+
 #TRACE
 LBM_TRACE ?= yes
 APP_TRACE ?= yes
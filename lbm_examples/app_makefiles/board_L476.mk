@@ -39,6 +39,7 @@ BOARD_C_SOURCES = \
 	mcu_drivers/STM32L4xx_HAL_Driver/Src/stm32l4xx_hal_adc.c \
 	mcu_drivers/STM32L4xx_HAL_Driver/Src/stm32l4xx_hal_adc_ex.c \
 	smtc_modem_hal/smtc_modem_hal.c\
+	smtc_modem_hal/smtc_modem_hal_kv.c\
 	mcu_drivers/core/STM32L4xx/system_stm32l4xx.c\
 	smtc_hal_l4/smtc_hal_flash.c\
 	smtc_hal_l4/smtc_hal_gpio.c\
@@ -57,6 +57,9 @@
 #endif
 #if defined( STM32L476xx )
 #include "smtc_hal_flash.h"
+#if defined( USE_FLASH_KV_STORE )
+#include "smtc_modem_hal_kv.h"
+#endif
 #endif
 
 #include "modem_pinout.h"
@@ -89,10 +92,16 @@
 #if defined( STM32L476xx )
 #define ADDR_FLASH_FUOTA ADDR_FLASH_PAGE_150
 #define ADDR_FLASH_STORE_AND_FORWARD ADDR_FLASH_PAGE_200
+#define ADDR_FLASH_LORAWAN_JOURNAL ADDR_FLASH_PAGE_240  // one page per stack
 #define ADDR_FLASH_SECURE_ELEMENT_CONTEXT ADDR_FLASH_PAGE_252
 #define ADDR_FLASH_MODEM_CONTEXT ADDR_FLASH_PAGE_253
 #define ADDR_FLASH_LORAWAN_CONTEXT ADDR_FLASH_PAGE_254
 #define ADDR_FLASH_MODEM_KEY_CONTEXT ADDR_FLASH_PAGE_255
+#define ADDR_FLASH_FUOTA_MATRIX FLASH_PAGE_ADDR( 256 )  // second bank, the decoder erases at most 255 pages at once
+
+// With the kv store, modem, key, lorawan and secure element contexts share a ring of pages instead of a page each
+#define ADDR_FLASH_KV_STORE ADDR_FLASH_PAGE_252
+#define FLASH_KV_STORE_NB_PAGES 4
 #endif
 
 #if defined( STM32L073xx )
@@ -122,11 +131,33 @@ __attribute__( ( section( ".noinit" ) ) ) static uint8_t          crashlog_buff_
 __attribute__( ( section( ".noinit" ) ) ) static volatile uint8_t crashlog_length_noinit;
 __attribute__( ( section( ".noinit" ) ) ) static volatile bool    crashlog_available_noinit;
 
+#if defined( STM32L476xx ) && defined( USE_FLASH_KV_STORE )
+static const smtc_modem_hal_kv_flash_t kv_flash = {
+    .base_addr    = ADDR_FLASH_KV_STORE,
+    .page_size    = ADDR_FLASH_PAGE_SIZE,
+    .nb_pages     = FLASH_KV_STORE_NB_PAGES,
+    .erase_page   = hal_flash_erase_page,
+    .write_buffer = hal_flash_write_buffer,
+    .read_buffer  = hal_flash_read_buffer,
+};
+static bool kv_is_initialized = false;
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
 
+#if defined( STM32L476xx ) && defined( USE_FLASH_KV_STORE )
+/**
+ * @brief Check if a context is saved in the kv store, mount the store on first use
+ *
+ * @param [in] ctx_type Type of modem context
+ * @return true if the context is handled by the kv store
+ */
+static bool modem_hal_kv_is_used( const modem_context_type_t ctx_type );
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -200,6 +231,14 @@ void smtc_modem_hal_enable_modem_irq( void )
 void smtc_modem_hal_context_restore( const modem_context_type_t ctx_type, uint32_t offset, uint8_t* buffer,
                                      const uint32_t size )
 {
+#if defined( STM32L476xx ) && defined( USE_FLASH_KV_STORE )
+    if( modem_hal_kv_is_used( ctx_type ) == true )
+    {
+        smtc_modem_hal_kv_restore( ctx_type, offset, buffer, size );
+        return;
+    }
+#endif
+
     // Offset is only used for fuota and store and forward purpose and for multistack features. To avoid ram consumption
     // the use of hal_flash_read_modify_write is only done in these cases
     switch( ctx_type )
@@ -242,6 +281,12 @@ void smtc_modem_hal_context_restore( const modem_context_type_t ctx_type, uint32
     case CONTEXT_STORE_AND_FORWARD:
         hal_flash_read_buffer( ADDR_FLASH_STORE_AND_FORWARD + offset, buffer, size );
         break;
+    case CONTEXT_LORAWAN_STACK_JOURNAL:
+        hal_flash_read_buffer( ADDR_FLASH_LORAWAN_JOURNAL + offset, buffer, size );
+        break;
+    case CONTEXT_FUOTA_MATRIX:
+        hal_flash_read_buffer( ADDR_FLASH_FUOTA_MATRIX + offset, buffer, size );
+        break;
 #endif
     default:
         mcu_panic( );
@@ -252,6 +297,17 @@ void smtc_modem_hal_context_restore( const modem_context_type_t ctx_type, uint32
 void smtc_modem_hal_context_store( const modem_context_type_t ctx_type, uint32_t offset, const uint8_t* buffer,
                                    const uint32_t size )
 {
+#if defined( STM32L476xx ) && defined( USE_FLASH_KV_STORE )
+    if( modem_hal_kv_is_used( ctx_type ) == true )
+    {
+        if( smtc_modem_hal_kv_store( ctx_type, offset, buffer, size ) == false )
+        {
+            mcu_panic( );
+        }
+        return;
+    }
+#endif
+
     // Offset is only used for fuota and store and forward purpose and for multistack features. To avoid ram consumption
     // the use of hal_flash_read_modify_write is only done in these cases
     switch( ctx_type )
@@ -286,7 +342,8 @@ void smtc_modem_hal_context_store( const modem_context_type_t ctx_type, uint32_t
         break;
     case CONTEXT_LORAWAN_STACK:
 #if defined( MULTISTACK )
-        // In case code is built for multiple stacks, read_modify_write feature is mandatory
+        // In case code is built for multiple stacks, read_modify_write feature is mandatory. Every save rewrites the
+        // page shared by all stacks: build with USE_FLASH_KV=yes to store each stack context as its own record
         hal_flash_read_modify_write( ADDR_FLASH_LORAWAN_CONTEXT + offset, buffer, size );
 #else
         hal_flash_erase_page( ADDR_FLASH_LORAWAN_CONTEXT, 1 );
@@ -310,6 +367,14 @@ void smtc_modem_hal_context_store( const modem_context_type_t ctx_type, uint32_t
     case CONTEXT_STORE_AND_FORWARD:
         hal_flash_write_buffer( ADDR_FLASH_STORE_AND_FORWARD + offset, buffer, size );
         break;
+    case CONTEXT_LORAWAN_STACK_JOURNAL:
+        // Journal records are only appended in erased flash, the page is erased by lr1mac on compaction
+        hal_flash_write_buffer( ADDR_FLASH_LORAWAN_JOURNAL + offset, buffer, size );
+        break;
+    case CONTEXT_FUOTA_MATRIX:
+        // Matrix rows are written once in erased flash, the pages are erased by the decoder at session start
+        hal_flash_write_buffer( ADDR_FLASH_FUOTA_MATRIX + offset, buffer, size );
+        break;
 #endif
     default:
         mcu_panic( );
@@ -325,6 +390,12 @@ void smtc_modem_hal_context_flash_pages_erase( const modem_context_type_t ctx_ty
     case CONTEXT_STORE_AND_FORWARD:
         hal_flash_erase_page( ADDR_FLASH_STORE_AND_FORWARD + offset, nb_page );
         break;
+    case CONTEXT_LORAWAN_STACK_JOURNAL:
+        hal_flash_erase_page( ADDR_FLASH_LORAWAN_JOURNAL + offset, nb_page );
+        break;
+    case CONTEXT_FUOTA_MATRIX:
+        hal_flash_erase_page( ADDR_FLASH_FUOTA_MATRIX + offset, nb_page );
+        break;
 #endif
     default:
         mcu_panic( );
@@ -559,4 +630,23 @@ void smtc_modem_hal_user_lbm_irq( void )
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
+#if defined( STM32L476xx ) && defined( USE_FLASH_KV_STORE )
+static bool modem_hal_kv_is_used( const modem_context_type_t ctx_type )
+{
+    // fuota, store and forward and lorawan journal are bulk or already append-only areas, they keep their own pages
+    if( ( ctx_type != CONTEXT_MODEM ) && ( ctx_type != CONTEXT_KEY_MODEM ) && ( ctx_type != CONTEXT_LORAWAN_STACK ) &&
+        ( ctx_type != CONTEXT_SECURE_ELEMENT ) )
+    {
+        return false;
+    }
+
+    if( kv_is_initialized == false )
+    {
+        smtc_modem_hal_kv_init( &kv_flash );
+        kv_is_initialized = true;
+    }
+    return true;
+}
+#endif
+
 /* --- EOF ------------------------------------------------------------------ */
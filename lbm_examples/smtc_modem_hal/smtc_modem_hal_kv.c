@@ -0,0 +1,466 @@
+/*!
+ * \file      smtc_modem_hal_kv.c
+ *
+ * \brief     Log-structured key-value store for modem contexts in flash
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <string.h>   // memset
+
+#include "smtc_modem_hal_kv.h"
+#include "smtc_hal_dbg_trace.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE MACROS-----------------------------------------------------------
+ */
+
+/**
+ * @brief Round a size up to the flash write granularity
+ */
+#define KV_ALIGN_UP( size ) ( ( ( size ) + ( KV_WRITE_GRANULARITY - 1 ) ) & ~( KV_WRITE_GRANULARITY - 1 ) )
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#define KV_WRITE_GRANULARITY 8u
+#define KV_PAGE_MAGIC 0x314B5650u  // "PVK1"
+#define KV_COPY_CHUNK_SIZE 32u
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE TYPES -----------------------------------------------------------
+ */
+
+/**
+ * @brief Page header, programmed once all live records have been copied in the page
+ */
+typedef struct kv_page_header_s
+{
+    uint32_t magic;
+    uint32_t seq;  // incremented each time the head moves to the next page
+    uint32_t rfu;
+    uint32_t crc;  // !! crc MUST be the last field of the structure !!
+} kv_page_header_t;
+
+/**
+ * @brief Record header, followed by the record data padded to the write granularity
+ */
+typedef struct kv_record_header_s
+{
+    uint8_t  type;
+    uint8_t  rfu;
+    uint16_t size;
+    uint32_t offset;
+    uint32_t version;
+    uint32_t crc;  // crc of the header fields above and of the record data
+} kv_record_header_t;
+
+typedef struct kv_index_s
+{
+    bool     used;
+    uint8_t  type;
+    uint16_t size;
+    uint32_t offset;
+    uint32_t addr;  // flash address of the record header
+} kv_index_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE VARIABLES -------------------------------------------------------
+ */
+
+static const smtc_modem_hal_kv_flash_t* kv_flash = NULL;
+
+static kv_index_t kv_index[SMTC_MODEM_HAL_KV_MAX_KEYS];
+static uint8_t    kv_head_page;
+static uint32_t   kv_head_seq;
+static uint32_t   kv_write_addr;
+static uint32_t   kv_version;
+static uint32_t   kv_erase_count;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+static uint32_t    kv_crc_update( uint32_t crc, const uint8_t* buffer, uint32_t size );
+static uint32_t    kv_page_addr( uint8_t page );
+static bool        kv_is_erased( const uint8_t* buffer, uint32_t size );
+static void        kv_program( uint32_t addr, const uint8_t* buffer, uint32_t size );
+static void        kv_erase( uint8_t page );
+static void        kv_commit_page( uint8_t page, uint32_t seq );
+static bool        kv_read_page_header( uint8_t page, kv_page_header_t* header );
+static bool        kv_check_record( uint32_t addr, const kv_record_header_t* header );
+static void        kv_scan_head( void );
+static bool        kv_compact( void );
+static kv_index_t* kv_index_find( uint8_t type, uint32_t offset, bool alloc );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void smtc_modem_hal_kv_init( const smtc_modem_hal_kv_flash_t* flash )
+{
+    kv_page_header_t header;
+    bool             head_found = false;
+
+    kv_flash       = flash;
+    kv_erase_count = 0;
+
+    // The head page is the valid page with the highest sequence, only the page headers are read here
+    for( uint8_t page = 0; page < kv_flash->nb_pages; page++ )
+    {
+        if( ( kv_read_page_header( page, &header ) == true ) &&
+            ( ( head_found == false ) || ( ( int32_t ) ( header.seq - kv_head_seq ) > 0 ) ) )
+        {
+            head_found   = true;
+            kv_head_page = page;
+            kv_head_seq  = header.seq;
+        }
+    }
+
+    if( head_found == false )
+    {
+        SMTC_HAL_TRACE_WARNING( "kv: no valid page, format\n" );
+        kv_head_page = 0;
+        kv_head_seq  = 1;
+        kv_erase( kv_head_page );
+        kv_commit_page( kv_head_page, kv_head_seq );
+    }
+
+    kv_scan_head( );
+}
+
+void smtc_modem_hal_kv_restore( uint8_t type, uint32_t offset, uint8_t* buffer, uint32_t size )
+{
+    memset( buffer, 0xFF, size );
+
+    if( kv_flash == NULL )
+    {
+        return;
+    }
+
+    kv_index_t* entry = kv_index_find( type, offset, false );
+    if( entry != NULL )
+    {
+        kv_flash->read_buffer( entry->addr + sizeof( kv_record_header_t ), buffer,
+                               ( size < entry->size ) ? size : entry->size );
+    }
+}
+
+bool smtc_modem_hal_kv_store( uint8_t type, uint32_t offset, const uint8_t* buffer, uint32_t size )
+{
+    if( ( kv_flash == NULL ) || ( size > UINT16_MAX ) )
+    {
+        return false;
+    }
+
+    kv_index_t* entry = kv_index_find( type, offset, true );
+    if( entry == NULL )
+    {
+        SMTC_HAL_TRACE_ERROR( "kv: no more key available\n" );
+        return false;
+    }
+
+    uint32_t record_size = sizeof( kv_record_header_t ) + KV_ALIGN_UP( size );
+    if( ( kv_write_addr + record_size ) > ( kv_page_addr( kv_head_page ) + kv_flash->page_size ) )
+    {
+        if( ( kv_compact( ) == false ) ||
+            ( ( kv_write_addr + record_size ) > ( kv_page_addr( kv_head_page ) + kv_flash->page_size ) ) )
+        {
+            SMTC_HAL_TRACE_ERROR( "kv: no more space for key %u\n", type );
+            return false;
+        }
+    }
+
+    kv_record_header_t header = {
+        .type    = type,
+        .rfu     = 0,
+        .size    = ( uint16_t ) size,
+        .offset  = offset,
+        .version = kv_version++,
+    };
+    header.crc = kv_crc_update( 0xFFFFFFFF, ( const uint8_t* ) &header, sizeof( header ) - sizeof( header.crc ) );
+    header.crc = ~kv_crc_update( header.crc, buffer, size );
+
+    // Header is programmed first: a record torn by a reset is never mistaken for free space
+    kv_program( kv_write_addr, ( const uint8_t* ) &header, sizeof( header ) );
+    kv_program( kv_write_addr + sizeof( header ), buffer, size );
+
+    entry->used   = true;
+    entry->type   = type;
+    entry->offset = offset;
+    entry->size   = ( uint16_t ) size;
+    entry->addr   = kv_write_addr;
+    kv_write_addr += record_size;
+
+    return true;
+}
+
+uint32_t smtc_modem_hal_kv_get_erase_count( void )
+{
+    return kv_erase_count;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static uint32_t kv_crc_update( uint32_t crc, const uint8_t* buffer, uint32_t size )
+{
+    for( uint32_t i = 0; i < size; i++ )
+    {
+        crc ^= buffer[i];
+        for( uint8_t bit = 0; bit < 8; bit++ )
+        {
+            crc = ( crc >> 1 ) ^ ( 0xEDB88320u & ( -( crc & 1u ) ) );
+        }
+    }
+    return crc;
+}
+
+static uint32_t kv_page_addr( uint8_t page )
+{
+    return kv_flash->base_addr + ( ( uint32_t ) page * kv_flash->page_size );
+}
+
+static bool kv_is_erased( const uint8_t* buffer, uint32_t size )
+{
+    for( uint32_t i = 0; i < size; i++ )
+    {
+        if( buffer[i] != 0xFF )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void kv_program( uint32_t addr, const uint8_t* buffer, uint32_t size )
+{
+    uint32_t aligned_size = size & ~( KV_WRITE_GRANULARITY - 1 );
+
+    if( aligned_size != 0 )
+    {
+        kv_flash->write_buffer( addr, buffer, aligned_size );
+    }
+    if( aligned_size != size )
+    {
+        // the flash driver programs whole double words: pad the tail in a local buffer
+        uint8_t tail[KV_WRITE_GRANULARITY];
+        memset( tail, 0xFF, sizeof( tail ) );
+        memcpy( tail, buffer + aligned_size, size - aligned_size );
+        kv_flash->write_buffer( addr + aligned_size, tail, sizeof( tail ) );
+    }
+}
+
+static void kv_erase( uint8_t page )
+{
+    kv_flash->erase_page( kv_page_addr( page ), 1 );
+    kv_erase_count++;
+}
+
+static void kv_commit_page( uint8_t page, uint32_t seq )
+{
+    kv_page_header_t header = {
+        .magic = KV_PAGE_MAGIC,
+        .seq   = seq,
+        .rfu   = 0,
+    };
+    header.crc = ~kv_crc_update( 0xFFFFFFFF, ( const uint8_t* ) &header, sizeof( header ) - sizeof( header.crc ) );
+    kv_program( kv_page_addr( page ), ( const uint8_t* ) &header, sizeof( header ) );
+}
+
+static bool kv_read_page_header( uint8_t page, kv_page_header_t* header )
+{
+    kv_flash->read_buffer( kv_page_addr( page ), ( uint8_t* ) header, sizeof( kv_page_header_t ) );
+
+    return ( header->magic == KV_PAGE_MAGIC ) &&
+           ( header->crc ==
+             ~kv_crc_update( 0xFFFFFFFF, ( const uint8_t* ) header, sizeof( kv_page_header_t ) - sizeof( header->crc ) ) );
+}
+
+static bool kv_check_record( uint32_t addr, const kv_record_header_t* header )
+{
+    uint8_t  chunk[KV_COPY_CHUNK_SIZE];
+    uint32_t crc = kv_crc_update( 0xFFFFFFFF, ( const uint8_t* ) header, sizeof( *header ) - sizeof( header->crc ) );
+
+    for( uint32_t done = 0; done < header->size; )
+    {
+        uint32_t len = header->size - done;
+        if( len > sizeof( chunk ) )
+        {
+            len = sizeof( chunk );
+        }
+        kv_flash->read_buffer( addr + sizeof( *header ) + done, chunk, len );
+        crc = kv_crc_update( crc, chunk, len );
+        done += len;
+    }
+    return ( ~crc == header->crc );
+}
+
+static void kv_scan_head( void )
+{
+    kv_record_header_t header;
+    uint32_t           page_end = kv_page_addr( kv_head_page ) + kv_flash->page_size;
+
+    memset( kv_index, 0, sizeof( kv_index ) );
+    kv_version    = 0;
+    kv_write_addr = kv_page_addr( kv_head_page ) + sizeof( kv_page_header_t );
+
+    while( ( kv_write_addr + sizeof( header ) ) <= page_end )
+    {
+        kv_flash->read_buffer( kv_write_addr, ( uint8_t* ) &header, sizeof( header ) );
+
+        if( kv_is_erased( ( const uint8_t* ) &header, sizeof( header ) ) == true )
+        {
+            break;
+        }
+
+        uint32_t record_size = sizeof( header ) + KV_ALIGN_UP( header.size );
+        if( ( ( kv_write_addr + record_size ) > page_end ) || ( kv_check_record( kv_write_addr, &header ) == false ) )
+        {
+            // Torn record: the page cannot be appended anymore, the next store moves to the next page
+            SMTC_HAL_TRACE_WARNING( "kv: invalid record at 0x%08x\n", kv_write_addr );
+            kv_write_addr = page_end;
+            break;
+        }
+
+        kv_index_t* entry = kv_index_find( header.type, header.offset, true );
+        if( entry != NULL )
+        {
+            entry->used   = true;
+            entry->type   = header.type;
+            entry->offset = header.offset;
+            entry->size   = header.size;
+            entry->addr   = kv_write_addr;
+        }
+        if( ( int32_t ) ( header.version - kv_version ) >= 0 )
+        {
+            kv_version = header.version + 1;
+        }
+        kv_write_addr += record_size;
+    }
+}
+
+static bool kv_compact( void )
+{
+    uint8_t  chunk[KV_COPY_CHUNK_SIZE];
+    uint32_t new_addr[SMTC_MODEM_HAL_KV_MAX_KEYS];
+    uint8_t  new_page  = ( kv_head_page + 1 ) % kv_flash->nb_pages;
+    uint32_t dst       = kv_page_addr( new_page ) + sizeof( kv_page_header_t );
+    uint32_t live_size = 0;
+
+    // Check that the live records fit in a page before erasing anything, otherwise keep the current head page
+    for( uint8_t i = 0; i < SMTC_MODEM_HAL_KV_MAX_KEYS; i++ )
+    {
+        if( kv_index[i].used == true )
+        {
+            live_size += sizeof( kv_record_header_t ) + KV_ALIGN_UP( kv_index[i].size );
+        }
+    }
+    if( ( sizeof( kv_page_header_t ) + live_size ) > kv_flash->page_size )
+    {
+        return false;
+    }
+
+    kv_erase( new_page );
+
+    // Copy the latest record of each key, as is, at the beginning of the new page
+    for( uint8_t i = 0; i < SMTC_MODEM_HAL_KV_MAX_KEYS; i++ )
+    {
+        if( kv_index[i].used == false )
+        {
+            continue;
+        }
+
+        uint32_t record_size = sizeof( kv_record_header_t ) + KV_ALIGN_UP( kv_index[i].size );
+        for( uint32_t done = 0; done < record_size; done += sizeof( chunk ) )
+        {
+            uint32_t len = ( ( record_size - done ) > sizeof( chunk ) ) ? sizeof( chunk ) : ( record_size - done );
+            kv_flash->read_buffer( kv_index[i].addr + done, chunk, len );
+            kv_program( dst + done, chunk, len );
+        }
+        new_addr[i] = dst;
+        dst += record_size;
+    }
+
+    // The new page becomes the head page only once its header is programmed, a reset before keeps the previous one
+    kv_commit_page( new_page, kv_head_seq + 1 );
+    kv_head_page  = new_page;
+    kv_head_seq   = kv_head_seq + 1;
+    kv_write_addr = dst;
+
+    // The index follows the records only once the new page is the head page
+    for( uint8_t i = 0; i < SMTC_MODEM_HAL_KV_MAX_KEYS; i++ )
+    {
+        if( kv_index[i].used == true )
+        {
+            kv_index[i].addr = new_addr[i];
+        }
+    }
+
+    return true;
+}
+
+static kv_index_t* kv_index_find( uint8_t type, uint32_t offset, bool alloc )
+{
+    kv_index_t* free_entry = NULL;
+
+    for( uint8_t i = 0; i < SMTC_MODEM_HAL_KV_MAX_KEYS; i++ )
+    {
+        if( kv_index[i].used == false )
+        {
+            if( free_entry == NULL )
+            {
+                free_entry = &kv_index[i];
+            }
+        }
+        else if( ( kv_index[i].type == type ) && ( kv_index[i].offset == offset ) )
+        {
+            return &kv_index[i];
+        }
+    }
+    return ( alloc == true ) ? free_entry : NULL;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -0,0 +1,149 @@
+/*!
+ * \file      smtc_modem_hal_kv.h
+ *
+ * \brief     Log-structured key-value store for modem contexts in flash
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2024. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SMTC_MODEM_HAL_KV_H__
+#define __SMTC_MODEM_HAL_KV_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC MACROS -----------------------------------------------------------
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+
+/**
+ * @brief Maximum number of different keys (context type and offset couples) held by the store
+ *
+ * @remark Each stack owns one LoRaWAN stack context and one secure element context key
+ */
+#ifndef SMTC_MODEM_HAL_KV_MAX_KEYS
+#if defined( NUMBER_OF_STACKS )
+#define SMTC_MODEM_HAL_KV_MAX_KEYS ( 8 + ( 2 * ( NUMBER_OF_STACKS - 1 ) ) )
+#else
+#define SMTC_MODEM_HAL_KV_MAX_KEYS 8
+#endif
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+
+/**
+ * @brief Flash area and flash primitives used by the store
+ *
+ * @remark Flash is written by multiple of 8 bytes and never rewritten before an erase, an erased byte reads 0xFF.
+ *         The area is a ring of nb_pages pages (at least 2), one of them is the head page holding the latest record
+ *         of each key.
+ */
+typedef struct smtc_modem_hal_kv_flash_s
+{
+    uint32_t base_addr;
+    uint16_t page_size;
+    uint8_t  nb_pages;
+    uint8_t ( *erase_page )( uint32_t addr, uint8_t nb_page );
+    uint32_t ( *write_buffer )( uint32_t addr, const uint8_t* buffer, uint32_t size );
+    void ( *read_buffer )( uint32_t addr, uint8_t* buffer, uint32_t size );
+} smtc_modem_hal_kv_flash_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Mount the store: select the head page from the page headers and rebuild the RAM index from this page only
+ *
+ * @remark A blank or corrupted area is formatted
+ *
+ * @param [in] flash Flash description, shall remain valid while the store is used
+ */
+void smtc_modem_hal_kv_init( const smtc_modem_hal_kv_flash_t* flash );
+
+/**
+ * @brief Read the latest record of a key
+ *
+ * @remark Bytes not covered by the record are set to 0xFF, as for a never written flash context
+ *
+ * @param [in]  type   Key type (modem context type)
+ * @param [in]  offset Key offset (context offset)
+ * @param [out] buffer Buffer to write to
+ * @param [in]  size   Number of bytes to read
+ */
+void smtc_modem_hal_kv_restore( uint8_t type, uint32_t offset, uint8_t* buffer, uint32_t size );
+
+/**
+ * @brief Append a new record of a key
+ *
+ * @remark When the head page is full, the live records are copied to the next page of the ring which then becomes
+ *         the head page: this is the only case where a page is erased
+ *
+ * @param [in] type   Key type (modem context type)
+ * @param [in] offset Key offset (context offset)
+ * @param [in] buffer Buffer to write from
+ * @param [in] size   Number of bytes to write
+ *
+ * @return true if the record has been stored
+ */
+bool smtc_modem_hal_kv_store( uint8_t type, uint32_t offset, const uint8_t* buffer, uint32_t size );
+
+/**
+ * @brief Get the number of page erases done by the store since init
+ *
+ * @return uint32_t Number of erased pages
+ */
+uint32_t smtc_modem_hal_kv_get_erase_count( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SMTC_MODEM_HAL_KV_H__
+
+/* --- EOF ------------------------------------------------------------------ */
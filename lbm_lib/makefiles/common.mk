@@ -157,7 +157,8 @@ endif
 
 ifeq ($(LBM_STREAM),yes)
 LBM_C_DEFS += \
-    -DADD_SMTC_STREAM
+    -DADD_SMTC_STREAM \
+    -DSTREAM_NB_OBJECTS=$(LBM_STREAM_NB_OBJECTS)
 endif
 
 ifeq ($(LBM_LFU),yes)
@@ -173,6 +174,10 @@ endif
 ifeq ($(LBM_STORE_AND_FORWARD),yes)
 LBM_C_DEFS += \
     -DADD_SMTC_STORE_AND_FORWARD
+ifeq ($(LBM_STORE_AND_FORWARD_PACKING),yes)
+LBM_C_DEFS += \
+    -DSTORE_AND_FORWARD_PACKED_UPLINK
+endif
 endif
 
 ifeq ($(LBM_FUOTA),yes)
@@ -181,6 +186,7 @@ LBM_C_DEFS += \
 	-DADD_CLASS_B \
 	-DADD_CLASS_C \
 	-DSMTC_MULTICAST \
+	-DSMTC_MULTICAST_NB_GROUPS=$(LBM_MULTICAST_NB_GROUPS) \
 	-DADD_SMTC_ALC_SYNC
     ifneq ($(FUOTA_MAXIMUM_NB_OF_FRAGMENTS),nc)
     LBM_C_DEFS += \
@@ -194,6 +200,10 @@ LBM_C_DEFS += \
     LBM_C_DEFS += \
        	-DFRAG_MAX_REDUNDANCY=$(FUOTA_MAXIMUM_FRAG_REDUNDANCY)
     endif
+	ifeq ($(LBM_FUOTA_MATRIX_IN_FLASH),yes)
+    LBM_C_DEFS += \
+        -DFRAG_DECODER_MATRIX_IN_FLASH
+	endif
 	ifeq ($(LBM_FUOTA_ENABLE_FMP),yes)
     LBM_C_DEFS += \
         -DENABLE_FUOTA_FMP
@@ -222,7 +232,8 @@ else
     
     ifeq ($(LBM_MULTICAST),yes)
     LBM_C_DEFS += \
-    	-DSMTC_MULTICAST
+    	-DSMTC_MULTICAST \
+    	-DSMTC_MULTICAST_NB_GROUPS=$(LBM_MULTICAST_NB_GROUPS)
     endif
 endif
 
@@ -237,6 +248,11 @@ endif
 endif
 endif
 
+ifeq ($(LBM_NVM_JOURNAL),yes)
+LBM_C_DEFS += \
+	-DLR1MAC_NVM_JOURNAL
+endif
+
 ifeq ($(TEST_BYPASS_JOIN_DUTY_CYCLE),yes)
 LBM_C_DEFS += \
 	-DTEST_BYPASS_JOIN_DUTY_CYCLE
@@ -271,6 +287,7 @@ LR1MAC_C_SOURCES += \
 	smtc_modem_core/lr1mac/src/lr1mac_utilities.c\
 	smtc_modem_core/lr1mac/src/smtc_real/src/smtc_real.c\
 	smtc_modem_core/lr1mac/src/services/smtc_duty_cycle.c\
+	smtc_modem_core/lr1mac/src/services/smtc_ch_access_stats.c\
 	smtc_modem_core/lr1mac/src/services/smtc_lbt.c
 
 ifeq ($(LBM_FUOTA),yes)
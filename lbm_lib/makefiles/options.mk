@@ -57,6 +57,9 @@ MODEM_DEEP_TRACE ?= no
 # If radio target is sx128x WW_2G4 is forced 
 REGION ?= ALL
 
+# Bind the single region selected with REGION at build time (regional constants become static const data)
+LBM_SINGLE_REGION ?= no
+
 # Crypto management only for lr11xx targets (SOFT, LR11XX, LR11XX_WITH_CREDENTIALS )
 CRYPTO ?= SOFT
 
@@ -72,11 +75,16 @@ LBM_CLASS_C ?= no
 
 # Multicast feature (at leastclass B or class C shall be activated)
 LBM_MULTICAST ?= no
+# Number of multicast groups, above 4 the soft crypto is required and the secure element context grows
+LBM_MULTICAST_NB_GROUPS ?= 4
 
 # CSMA Feature ( only usable for lr11xx and sx126x targets)
 LBM_CSMA ?= no
 USE_CSMA_BY_DEFAULT ?= no
 
+# Append DevNonce / JoinNonce updates to a flash journal instead of rewriting the full LoRaWAN context
+LBM_NVM_JOURNAL ?= no
+
 #-----------------------------------------------------------------------------
 # LoRaWAN Package related options
 #-----------------------------------------------------------------------------
@@ -92,6 +100,8 @@ LBM_FUOTA_VERSION ?= 1
 FUOTA_MAXIMUM_NB_OF_FRAGMENTS ?= nc
 FUOTA_MAXIMUM_SIZE_OF_FRAGMENTS ?= nc
 FUOTA_MAXIMUM_FRAG_REDUNDANCY ?= nc
+# In case FUOTA v2 is allowed, keep the decoder parity matrix in a flash scratch area instead of RAM
+LBM_FUOTA_MATRIX_IN_FLASH ?= no
 # In case FUOTA is allowed, allow the use of Firmware Management Package
 LBM_FUOTA_ENABLE_FMP ?= yes
 # In case FUOTA is allowed, llow the use of Multi-Package Access Package
@@ -106,6 +116,7 @@ LBM_ALMANAC ?= no
 
 # Stream feature
 LBM_STREAM ?= no
+LBM_STREAM_NB_OBJECTS ?= 1
 
 # Large File Upload feature
 LBM_LFU ?= no
@@ -122,6 +133,8 @@ LBM_GEOLOCATION ?= no
 
 #Store and Forward Management feature
 LBM_STORE_AND_FORWARD ?= no
+# In case Store and Forward is allowed, pack several stored data in one uplink, each prefixed by its length
+LBM_STORE_AND_FORWARD_PACKING ?= no
 
 # Multistack
 NB_OF_STACK ?= 1
\ No newline at end of file
@@ -134,4 +134,18 @@ LBM_C_DEFS += \
 	-DWW2G4_SINGLE_DATARATE
 endif
 
-
+#-----------------------------------------------------------------------------
+# Single region build: the only selected region is bound at compile time
+#-----------------------------------------------------------------------------
+ifeq ($(LBM_SINGLE_REGION),yes)
+ifneq ($(words $(filter-out ALL,$(REGION_LIST))),1)
+$(error LBM_SINGLE_REGION=yes requires exactly one region in REGION (ex: REGION=EU_868))
+endif
+ifeq ($(REGION_AS_923), yes)
+$(error LBM_SINGLE_REGION=yes is not available for AS_923 (frequency group is selected at runtime))
+endif
+ifeq ($(REGION_CN_470), yes)
+$(error LBM_SINGLE_REGION=yes is not available for CN_470 (channel plan is selected at runtime))
+endif
+LBM_C_DEFS += -DSMTC_REAL_SINGLE_REGION
+endif
@@ -133,10 +133,11 @@ typedef enum smtc_modem_region_e
  */
 typedef enum smtc_modem_adr_profile_e
 {
-    SMTC_MODEM_ADR_PROFILE_NETWORK_CONTROLLED = 0x00,  //!< Network Server controlled for static devices
-    SMTC_MODEM_ADR_PROFILE_MOBILE_LONG_RANGE  = 0x01,  //!< Long range distribution for mobile devices
-    SMTC_MODEM_ADR_PROFILE_MOBILE_LOW_POWER   = 0x02,  //!< Low power distribution for mobile devices
-    SMTC_MODEM_ADR_PROFILE_CUSTOM             = 0x03,  //!< User defined distribution
+    SMTC_MODEM_ADR_PROFILE_NETWORK_CONTROLLED   = 0x00,  //!< Network Server controlled for static devices
+    SMTC_MODEM_ADR_PROFILE_MOBILE_LONG_RANGE    = 0x01,  //!< Long range distribution for mobile devices
+    SMTC_MODEM_ADR_PROFILE_MOBILE_LOW_POWER     = 0x02,  //!< Low power distribution for mobile devices
+    SMTC_MODEM_ADR_PROFILE_CUSTOM               = 0x03,  //!< User defined distribution
+    SMTC_MODEM_ADR_PROFILE_MOBILE_LINK_ADAPTIVE = 0x04,  //!< Mobile devices, datarate and power follow the link margin
 } smtc_modem_adr_profile_t;
 
 /**
@@ -161,6 +162,8 @@ typedef struct smtc_modem_version_s
 
 /**
  * @brief Multicast group identifier
+ *
+ * @remark Groups above SMTC_MODEM_MC_GRP_3 are valid up to the LBM_MULTICAST_NB_GROUPS build option minus one
  */
 typedef enum smtc_modem_mc_grp_id_e
 {
@@ -244,6 +247,30 @@ typedef struct smtc_modem_dl_metadata_s
     uint8_t                datarate;
 } smtc_modem_dl_metadata_t;
 
+/**
+ * @brief Channel access statistics learnt by the LBT and CSMA listens on one channel
+ */
+typedef struct smtc_modem_channel_access_stats_s
+{
+    uint32_t freq_hz;             //!< Listened frequency
+    uint16_t nb_listen;           //!< Number of listen done on this frequency
+    uint16_t nb_busy;             //!< Number of listen that found the frequency busy
+    uint8_t  busy_ratio_percent;  //!< Moving average of the busy outcome in percent, weighted toward recent listens
+    int16_t  noise_floor_dbm;     //!< Moving average of the rssi measured by free LBT listens, INT16_MIN if unknown
+} smtc_modem_channel_access_stats_t;
+
+/**
+ * @brief Class C deaf time statistics, the device is deaf when another radio task interrupts the continuous reception
+ */
+typedef struct smtc_modem_class_c_deaf_time_stats_s
+{
+    uint32_t nb_interruption;  //!< Number of interruptions of the continuous reception
+    uint32_t nb_fast_rearm;    //!< Number of reception re-armed without reconfiguring the radio
+    uint32_t last_deaf_ms;     //!< Duration of the last interruption
+    uint32_t max_deaf_ms;      //!< Longest interruption
+    uint32_t total_deaf_ms;    //!< Cumulated duration of all interruptions
+} smtc_modem_class_c_deaf_time_stats_t;
+
 /**
  * @brief Cipher mode for stream service
  */
@@ -262,6 +289,14 @@ typedef enum smtc_modem_file_upload_cipher_mode_e
     SMTC_MODEM_FILE_UPLOAD_AES_WITH_APPSKEY,  //!< Encrypt file using AES with appskey
 } smtc_modem_file_upload_cipher_mode_t;
 
+/**
+ * @brief File upload read callback: copies \p size bytes of the file starting at byte \p offset into \p buffer
+ *
+ * @remark Called from the modem engine, offsets are multiple of 64 bytes and the file shall not change until the end
+ * of the upload session
+ */
+typedef void ( *smtc_modem_file_upload_read_f )( uint32_t offset, uint8_t* buffer, uint16_t size );
+
 /**
  * @brief Modem status
  */
@@ -427,6 +462,7 @@ typedef struct smtc_modem_event_s
     uint8_t                 stack_id;
     smtc_modem_event_type_t event_type;
     uint8_t                 missed_events;  //!< Number of event_type events missed before the current one
+    uint32_t                timestamp_ms;   //!< Modem time in ms when the event occurred
     union
     {
         struct
@@ -436,8 +472,15 @@ typedef struct smtc_modem_event_s
         struct
         {
             smtc_modem_event_txdone_status_t status;
+            uint32_t                         fcnt_up;  //!< Frame counter of the uplink
         } txdone;
         struct
+        {
+            int8_t  rssi;   //!< Signed value in dBm + 64, as in @ref smtc_modem_dl_metadata_t
+            int8_t  snr;    //!< Signed value in dB given in 0.25dB step
+            uint8_t fport;  //!< FPort of the downlink
+        } downdata;
+        struct
         {
             smtc_modem_event_mac_request_status_t status;
         } link_check;
@@ -481,6 +524,10 @@ typedef struct smtc_modem_event_s
         {
             smtc_modem_event_mute_status_t status;
         } mute;
+        struct
+        {
+            uint8_t stream_id;  //!< Stream whose buffer got depleted, 0 for the stream of smtc_modem_stream_init
+        } streamdone;
     } event_data;
 } smtc_modem_event_t;
 
@@ -558,7 +605,9 @@ smtc_modem_return_code_t smtc_modem_request_uplink( uint8_t stack_id, uint8_t fp
 /**
  * @brief Get the modem event
  *
- * @remark This command can be used to retrieve pending events from the modem.
+ * @remark This command can be used to retrieve pending events from the modem. Events are returned in the order they
+ *         occurred, so all pending events can be drained in one pass by calling it until it returns
+ *         SMTC_MODEM_RC_NO_EVENT.
  *
  * @param [out] event                   Structure holding event-related information
  * @param [out] event_pending_count     Number of pending event(s)
@@ -971,6 +1020,9 @@ smtc_modem_return_code_t smtc_modem_adr_set_join_distribution(
  * @brief Set the adaptive data rate (ADR) profile
  *
  * @remark If @ref SMTC_MODEM_ADR_PROFILE_CUSTOM is selected, custom data are taken into account
+ * @remark If @ref SMTC_MODEM_ADR_PROFILE_MOBILE_LINK_ADAPTIVE is selected, the stack keeps a short history of the
+ *         downlink SNR and LinkCheckAns margins and uses the fastest datarate (and lowest tx power) that still keeps
+ *         a 10dB margin on the worst recent sample. The long range distribution is used while the history is stale.
  *
  * @param [in] stack_id        Stack identifier
  * @param [in] adr_profile     ADR profile to be configured
@@ -1227,6 +1279,26 @@ smtc_modem_return_code_t smtc_modem_csma_set_parameters( uint8_t stack_id, uint8
 smtc_modem_return_code_t smtc_modem_csma_get_parameters( uint8_t stack_id, uint8_t* max_ch_change, bool* bo_enabled,
                                                          uint8_t* nb_bo_max );
 
+/**
+ * @brief Get the channel access statistics of one of the channels listened by the LBT or CSMA features
+ *
+ * @remark The modem skips a channel found busy by most of its recent listens and scales the CSMA back-off and the
+ * delay before a new listen with the busy ratio
+ * @remark The statistics are reset by @ref smtc_modem_set_region
+ *
+ * @param [in]  stack_id  Stack identifier
+ * @param [in]  index     Index of the listened channel, from 0 until SMTC_MODEM_RC_INVALID is returned
+ * @param [out] stats     Statistics of this channel
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID           \p stats is NULL or no channel is tracked at \p index
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_get_channel_access_stats( uint8_t stack_id, uint8_t index,
+                                                              smtc_modem_channel_access_stats_t* stats );
+
 /**
  * @brief Get the total charge counter of the modem in mAh
  *
@@ -1268,6 +1340,22 @@ smtc_modem_return_code_t smtc_modem_reset_charge( void );
  */
 smtc_modem_return_code_t smtc_modem_set_class( uint8_t stack_id, smtc_modem_class_t lorawan_class );
 
+/**
+ * @brief Get the Class C deaf time statistics
+ *
+ * @param [in]  stack_id Stack identifier
+ * @param [out] stats    Deaf time statistics accumulated since the modem start
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_INVALID           \p stats is NULL
+ * @retval SMTC_MODEM_RC_FAIL              Class C is not supported by this build
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_class_c_get_deaf_time_stats( uint8_t                               stack_id,
+                                                                 smtc_modem_class_c_deaf_time_stats_t* stats );
+
 /**
  * @brief Set Class B Ping Slot Periodicity
  *
@@ -1675,6 +1763,76 @@ smtc_modem_return_code_t smtc_modem_stream_add_data( uint8_t stack_id, const uin
  */
 smtc_modem_return_code_t smtc_modem_stream_status( uint8_t stack_id, uint16_t* pending, uint16_t* free );
 
+/**
+ * @brief Create and initialize one of several concurrent data streams
+ *
+ * Each stream has its own FPort, redundancy ratio, window length and buffer. Streams with pending data share the
+ * uplinks in turn, one fragment per uplink.
+ *
+ * @remark Stream 0 is the stream used by @ref smtc_modem_stream_init, @ref smtc_modem_stream_add_data and
+ * @ref smtc_modem_stream_status, it is the one driven by the stream commands of the DM downlinks. The number of streams
+ * is set at build time by STREAM_NB_OBJECTS.
+ *
+ * @param [in] stack_id                  Stack identifier
+ * @param [in] stream_id                 Stream identifier
+ * @param [in] f_port                    LoRaWAN FPort on which the stream is sent (0 forces the DM LoRaWAN FPort)
+ * @param [in] cipher_mode               Cipher mode
+ * @param [in] redundancy_ratio_percent  Stream redundancy ratio
+ * @param [in] window_length             Redundancy window length in bytes, at most ROSE_MAX_WL
+ * @param [in] fifo                      4-byte aligned buffer holding the stream data, it shall remain valid until the
+ *                                       stream is re-initialized or the modem is reset. NULL selects the built-in
+ *                                       buffer, only available for stream 0
+ * @param [in] fifo_size                 Size of \p fifo in bytes, at least window_length + 512 + window_length / 8
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID           \p stream_id, FPort, \p window_length or \p fifo is invalid
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_FAIL              \p fifo is too small or already used by another stream
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_stream_object_init( uint8_t stack_id, uint8_t stream_id, uint8_t f_port,
+                                                        smtc_modem_stream_cipher_mode_t cipher_mode,
+                                                        uint8_t redundancy_ratio_percent, uint16_t window_length,
+                                                        uint8_t* fifo, uint16_t fifo_size );
+
+/**
+ * @brief Add data to one of the concurrent data streams
+ *
+ * @param [in] stack_id                     Stack identifier
+ * @param [in] stream_id                    Stream identifier
+ * @param [in] data                         Data to be added to the stream
+ * @param [in] len                          Number of bytes from data to be added to the stream
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_NOT_INIT          \p stream_id was not initialized
+ * @retval SMTC_MODEM_RC_INVALID           \p stream_id is invalid, \p len is not in range [1-254] or \p data is NULL
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode or the streaming buffer is full
+ * @retval SMTC_MODEM_RC_FAIL              Modem is not available (suspended, muted, or not joined)
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_stream_object_add_data( uint8_t stack_id, uint8_t stream_id, const uint8_t* data,
+                                                            uint8_t len );
+
+/**
+ * @brief Return the current status of one of the concurrent data streams
+ *
+ * @param [in]  stack_id                    Stack identifier
+ * @param [in]  stream_id                   Stream identifier
+ * @param [out] pending                     Length of pending data for transmission
+ * @param [out] free                        Length of free space in the buffer
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_NOT_INIT          \p stream_id was not initialized
+ * @retval SMTC_MODEM_RC_INVALID           \p stream_id is invalid, \p pending or \p free are NULL
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_stream_object_status( uint8_t stack_id, uint8_t stream_id, uint16_t* pending,
+                                                          uint16_t* free );
+
 /**
  * @brief Create and initialize a file upload session
  *
@@ -1697,6 +1855,32 @@ smtc_modem_return_code_t smtc_modem_file_upload_init( uint8_t stack_id, uint8_t
                                                       const uint8_t* file, uint16_t file_length,
                                                       uint32_t average_delay_s );
 
+/**
+ * @brief Create and initialize a file upload session reading the file through a callback
+ *
+ * @remark The file is read piece by piece each time a fragment is built (flash, external memory) and is never modified,
+ * encryption is done on the fly
+ *
+ * @param [in] stack_id        Stack identifier
+ * @param [in] index           Index on which the upload is done
+ * @param [in] cipher_mode     Cipher mode
+ * @param [in] read_callback   Callback reading the file
+ * @param [in] file_length     File size in bytes
+ * @param [in] average_delay_s Minimum delay between two file upload fragments in seconds (from the end of an uplink to
+ *                             the start of the next one)
+ *
+ * @return Modem return code as defined in @ref smtc_modem_return_code_t
+ * @retval SMTC_MODEM_RC_OK                Command executed without errors
+ * @retval SMTC_MODEM_RC_INVALID           \p file_length is equal to 0 or greater than 8180 bytes, or \p read_callback
+ *                                         is NULL
+ * @retval SMTC_MODEM_RC_BUSY              Modem is currently in test mode, or a file upload is already ongoing
+ * @retval SMTC_MODEM_RC_INVALID_STACK_ID  Invalid \p stack_id
+ */
+smtc_modem_return_code_t smtc_modem_file_upload_init_from_callback( uint8_t stack_id, uint8_t index,
+                                                                    smtc_modem_file_upload_cipher_mode_t cipher_mode,
+                                                                    smtc_modem_file_upload_read_f read_callback,
+                                                                    uint16_t file_length, uint32_t average_delay_s );
+
 /**
  * @brief Start the file upload session
  *
@@ -1961,7 +2145,7 @@ smtc_modem_return_code_t smtc_modem_store_and_forward_flash_clear_data( uint8_t
  * @brief Get the fifo capacity and the number of free slots before data loss by overwriting the slot already in use
  *
  * @param [in]  stack_id  Stack identifier
- * @param [out] capacity  Capacity of the fifo (number of slot)
+ * @param [out] capacity  Capacity of the fifo (number of slot, a slot holds several data)
  * @param [out] free_slot Number of free slots
  *
  * @return Modem return code as defined in @ref smtc_modem_return_code_t
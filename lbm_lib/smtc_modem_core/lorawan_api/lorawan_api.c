@@ -202,6 +202,12 @@ status_lorawan_t lorawan_api_set_region( smtc_real_region_types_t region_type, u
     return ret;
 }
 
+uint8_t* lorawan_api_payload_buffer_get( uint8_t stack_id )
+{
+    PANIC_IF_STACK_ID_TOO_HIGH( stack_id );
+    return lr1mac_core_payload_buffer_get( &lr1_mac_obj[stack_id] );
+}
+
 status_lorawan_t lorawan_api_payload_send( uint8_t fport, bool fport_enabled, const uint8_t* data, uint8_t data_len,
                                            uint8_t packet_type, uint32_t target_time_ms, uint8_t stack_id )
 {
@@ -401,6 +407,13 @@ uint8_t lorawan_api_next_dr_get( uint8_t stack_id )
     return lr1mac_core_next_dr_get( &lr1_mac_obj[stack_id] );
 }
 
+bool lorawan_api_link_margin_get( int16_t* margin_db, uint8_t stack_id )
+{
+    PANIC_IF_STACK_ID_TOO_HIGH( stack_id );
+    return lr1_stack_link_margin_get( &lr1_mac_obj[stack_id], lr1mac_core_next_dr_get( &lr1_mac_obj[stack_id] ),
+                                      margin_db );
+}
+
 modulation_type_t lorawan_api_get_modulation_type_from_datarate( uint8_t stack_id, uint8_t datarate )
 {
     PANIC_IF_STACK_ID_TOO_HIGH( stack_id );
@@ -496,6 +509,12 @@ void lorawan_api_class_c_stop( uint8_t stack_id )
     PANIC_IF_STACK_ID_TOO_HIGH( stack_id );
     lr1mac_class_c_stop( &class_c_obj[stack_id] );
 }
+
+void lorawan_api_class_c_get_deaf_stats( lr1mac_class_c_deaf_stats_t* deaf_stats, uint8_t stack_id )
+{
+    PANIC_IF_STACK_ID_TOO_HIGH( stack_id );
+    lr1mac_class_c_get_deaf_stats( &class_c_obj[stack_id], deaf_stats );
+}
 #endif
 
 lorawan_multicast_rc_t lorawan_api_multicast_set_group_session_keys( uint8_t       mc_group_id,
@@ -869,6 +888,12 @@ bool lorawan_api_lbt_get_state( uint8_t stack_id )
     return smtc_lbt_get_state( &lbt_obj );
 }
 
+bool lorawan_api_get_channel_access_stats( uint8_t index, smtc_ch_access_channel_stats_t* stats, uint8_t stack_id )
+{
+    PANIC_IF_STACK_ID_TOO_HIGH( stack_id );
+    return smtc_ch_access_stats_get( &lr1_mac_obj[stack_id].ch_access_stats, index, stats );
+}
+
 #if defined( ADD_CSMA )
 smtc_lora_cad_status_t lorawan_api_lora_cad_bt_set_parameters( uint8_t nb_bo_max, bool bo_enabled,
                                                                uint8_t max_ch_change, uint8_t stack_id )
@@ -887,7 +912,7 @@ void lorawan_api_lora_cad_bt_get_parameters( uint8_t* max_ch_change, bool* bo_en
 void lorawan_api_lora_cad_bt_set_state( bool enable, uint8_t stack_id )
 {
     PANIC_IF_STACK_ID_TOO_HIGH( stack_id );
-    if( real_obj[stack_id].real_const.const_lbt_supported == false )
+    if( SMTC_REAL_CONST( &real_obj[stack_id] ).const_lbt_supported == false )
     {
         smtc_lora_cad_bt_set_state( &cad_obj[stack_id], enable );
     }
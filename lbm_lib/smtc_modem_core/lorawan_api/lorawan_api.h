@@ -50,6 +50,9 @@ extern "C" {
 #include "lr1mac_defs.h"
 #include "lr1_stack_mac_layer.h"
 #include "smtc_real_defs.h"
+#if defined( ADD_CLASS_C )
+#include "lr1mac_class_c.h"
+#endif
 #if defined( ADD_CLASS_B )
 #include "smtc_beacon_sniff.h"
 #endif
@@ -126,6 +129,16 @@ smtc_real_region_types_t lorawan_api_get_region( uint8_t stack_id );
  */
 status_lorawan_t lorawan_api_set_region( smtc_real_region_types_t region_type, uint8_t stack_id );
 
+/**
+ * @brief  Get the stack buffer where the next uplink payload can be built without copy
+ *
+ * @remark The buffer is only valid until the next lorawan_api_payload_send call on this stack
+ *
+ * @param [in] stack_id       Stack identifier
+ * @return uint8_t* Buffer pointer, NULL if the stack is busy
+ */
+uint8_t* lorawan_api_payload_buffer_get( uint8_t stack_id );
+
 /**
  * @brief  Sends an uplink as soon as possible at a chosen time
  *
@@ -191,12 +204,13 @@ void lorawan_api_join_status_clear( uint8_t stack_id );
 
 /**
  * @brief Set datarate strategy
- * @remark The current implementation support 4 different dataRate Strategy :
+ * @remark The current implementation support 6 different dataRate Strategy :
  *    STATIC_ADR_MODE                   for static Devices with ADR managed by the Network
  *    MOBILE_LONGRANGE_DR_DISTRIBUTION  for Mobile Devices with strong Long range requirement
  *    MOBILE_LOWPER_DR_DISTRIBUTION     for Mobile Devices with strong Low power requirement
  *    USER_DR_DISTRIBUTION              User datarate distribution (can be defined with @ref lorawan_api_dr_custom_set)
  *    JOIN_DR_DISTRIBUTION              Dedicated for Join requests
+ *    MOBILE_LINK_ADAPTIVE_DR           for Mobile Devices, datarate and tx power follow the recent link margin
  * @param [in] dr_strategy Datarate strategy (describe above)
  * @return status_lorawan_t The status of the operation
  */
@@ -350,6 +364,14 @@ uint8_t lorawan_api_next_power_get( uint8_t stack_id );
  */
 uint8_t lorawan_api_next_dr_get( uint8_t stack_id );
 
+/**
+ * @brief Get the margin of the recent link above the demodulation floor of the next datarate
+ *
+ * @param [out] margin_db   Margin of the worst downlink SNR seen over the link history, in dB
+ * @return bool             false if there is no fresh link history to estimate the margin from
+ */
+bool lorawan_api_link_margin_get( int16_t* margin_db, uint8_t stack_id );
+
 /**
  * @brief Return the modulation type from a datarate
  *
@@ -458,6 +480,16 @@ bool lorawan_api_class_c_is_running( uint8_t stack_id );
  */
 void lorawan_api_class_c_stop( uint8_t stack_id );
 
+#if defined( ADD_CLASS_C )
+/**
+ * @brief Get the class C deaf time statistics, time spent without continuous reception while class C is started
+ *
+ * @param [out] deaf_stats Deaf time statistics
+ * @param [in]  stack_id   Stack identifier
+ */
+void lorawan_api_class_c_get_deaf_stats( lr1mac_class_c_deaf_stats_t* deaf_stats, uint8_t stack_id );
+#endif  // ADD_CLASS_C
+
 /**
  * @brief Configure a multicast group session keys
  *
@@ -894,6 +926,16 @@ void lorawan_api_lbt_set_state( bool enable, uint8_t stack_id );
  */
 bool lorawan_api_lbt_get_state( uint8_t stack_id );
 
+/**
+ * @brief Get the channel access statistics of the n-th channel listened by lbt or cad
+ *
+ * @param [in]  index    index of the listened channel
+ * @param [out] stats    statistics of this channel
+ * @param [in]  stack_id stack identifier
+ * @return false if no channel is tracked at this index
+ */
+bool lorawan_api_get_channel_access_stats( uint8_t index, smtc_ch_access_channel_stats_t* stats, uint8_t stack_id );
+
 /**
  * @brief Set the LoRa CAD before talk parameters
  *
@@ -87,12 +87,13 @@
  */
 typedef struct lorawan_send_management_s
 {
-    uint8_t rx_ack_bit_context;
-    uint8_t payload[242];
-    uint8_t payload_length;
-    uint8_t fport;
-    bool    fport_present;
-    bool    packet_type;
+    uint8_t  rx_ack_bit_context;
+    uint8_t  payload[242];
+    uint8_t  payload_length;
+    uint8_t  fport;
+    bool     fport_present;
+    bool     packet_type;
+    uint32_t fcnt_up;  // frame counter of the uplink, reported with the tx done event
 
 } lorawan_send_management_t;
 
@@ -196,6 +197,7 @@ static void lorawan_send_management_service_on_launch( void* context )
     status_lorawan_t send_status                                          = ERRORLORAWAN;
     stask_manager*   task_manager                                         = ( stask_manager* ) context;
     lorawan_send_management_obj[STACK_ID_CURRENT_TASK].rx_ack_bit_context = 0;
+    lorawan_send_management_obj[STACK_ID_CURRENT_TASK].fcnt_up = lorawan_api_fcnt_up_get( STACK_ID_CURRENT_TASK );
 
     send_status = lorawan_api_payload_send(
         lorawan_send_management_obj[STACK_ID_CURRENT_TASK].fport,
@@ -230,21 +232,24 @@ static void lorawan_send_management_service_on_update( void* context )
 
     if( task_manager->modem_task[CURRENT_TASK_ID].task_enabled == true )
     {
+        modem_event_payload_t payload = { 0 };
+        payload.txdone.fcnt_up        = lorawan_send_management_obj[STACK_ID_CURRENT_TASK].fcnt_up;
+
         if( task_manager->modem_task[CURRENT_TASK_ID].task_context == true )
         {
             if( lorawan_send_management_obj[STACK_ID_CURRENT_TASK].rx_ack_bit_context == 1 )
             {
-                increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_TXDONE, MODEM_TX_SUCCESS_WITH_ACK,
-                                                  STACK_ID_CURRENT_TASK );
+                modem_event_push( SMTC_MODEM_EVENT_TXDONE, MODEM_TX_SUCCESS_WITH_ACK, STACK_ID_CURRENT_TASK,
+                                  &payload );
             }
             else
             {
-                increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_TXDONE, MODEM_TX_SUCCESS, STACK_ID_CURRENT_TASK );
+                modem_event_push( SMTC_MODEM_EVENT_TXDONE, MODEM_TX_SUCCESS, STACK_ID_CURRENT_TASK, &payload );
             }
         }
         else
         {
-            increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_TXDONE, MODEM_TX_FAILED, STACK_ID_CURRENT_TASK );
+            modem_event_push( SMTC_MODEM_EVENT_TXDONE, MODEM_TX_FAILED, STACK_ID_CURRENT_TASK, &payload );
         }
     }
 }
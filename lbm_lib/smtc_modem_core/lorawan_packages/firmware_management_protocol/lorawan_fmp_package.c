@@ -114,7 +114,6 @@
  * LoRaWAN Application Layer Fragmented Data Block Transport Specification
  */
 
-#define FMP_PORT 203
 #define FMP_ID 4
 #define FMP_VERSION 1
 
@@ -114,7 +114,6 @@
  * LoRaWAN Application Layer Fragmented Data Block Transport Specification
  */
 
-#define FRAGMENTATION_PORT 201
 #define FRAGMENTATION_ID 3
 #define FRAGMENTATION_VERSION 1
 #define FRAGMENTATION_MAX_NB_SESSIONS 4
@@ -58,6 +58,36 @@
  *=============================================================================
  */
 
+/*!
+ * Number of 32-bit words of a bit vector holding one bit per fragment / per lost fragment
+ */
+#define FRAG_MAX_NB_WORDS ( ( FRAG_MAX_NB + 31 ) >> 5 )
+#define FRAG_MAX_REDUNDANCY_WORDS ( ( FRAG_MAX_REDUNDANCY + 31 ) >> 5 )
+
+/*!
+ * Size in words of the upper triangular matrix: the row of pivot i only stores the words from i / 32 onward
+ */
+#define FRAG_MATRIX_WORDS ( 32 * FRAG_MAX_REDUNDANCY_WORDS * ( FRAG_MAX_REDUNDANCY_WORDS + 1 ) / 2 )
+
+/*!
+ * Size in words of a matrix line buffer, one word more than a row so a row tail can be padded to a double word
+ */
+#define FRAG_MATRIX_LINE_WORDS ( FRAG_MAX_REDUNDANCY_WORDS + 1 )
+
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+/*!
+ * Number of lost fragment indexes written or read at once in the scratch area, a multiple of a double word
+ */
+#define FRAG_MISSING_ROW_GROUP 16
+
+/*!
+ * Scratch area layout: the fragment index of each lost fragment, then the parity matrix rows of pivot
+ * FRAG_MATRIX_CACHE_ROWS onward. A row of block b stores its words from b onward padded to a double word.
+ */
+#define FRAG_SCRATCH_MATRIX_OFFSET \
+    ( ( ( FRAG_MAX_REDUNDANCY + FRAG_MISSING_ROW_GROUP - 1 ) / FRAG_MISSING_ROW_GROUP ) * FRAG_MISSING_ROW_GROUP * 2 )
+#endif
+
 typedef struct
 {
     FragDecoderCallbacks_t* Callbacks;
@@ -66,10 +96,20 @@ typedef struct
     uint8_t  FragSize;
 
     uint32_t M2BLine;
-    uint8_t  MatrixM2B[( ( FRAG_MAX_REDUNDANCY >> 3 ) + 1 ) * FRAG_MAX_REDUNDANCY];
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+    uint32_t MatrixCache[FRAG_MATRIX_CACHE_ROWS][FRAG_MATRIX_LINE_WORDS];  // rows of the first pivots
+    uint32_t FragLost[FRAG_MAX_NB_WORDS];                                   // one bit per lost fragment
+    uint16_t FragLostBefore[FRAG_MAX_NB_WORDS];  // lost fragments below the first lost one of each word
+    uint16_t FragMissingRowGroup[FRAG_MISSING_ROW_GROUP];  // staged or last read group of lost fragment indexes
+    uint16_t FragMissingRowGroupIndex;
+    bool     FragMissingRowGroupDirty;
+#else
+    uint32_t MatrixM2B[FRAG_MATRIX_WORDS];
     uint16_t FragNbMissingIndex[FRAG_MAX_NB];
+    uint16_t FragMissingRow[FRAG_MAX_REDUNDANCY];  // fragment index of the x th missing fragment
+#endif
 
-    uint8_t S[( FRAG_MAX_REDUNDANCY >> 3 ) + 1];
+    uint32_t S[FRAG_MAX_REDUNDANCY_WORDS];
 
     FragDecoderStatus_t Status;
 } FragDecoder_t;
@@ -100,16 +140,15 @@ static void GetRow( uint8_t* src, uint16_t row, uint16_t size );
  *
  * \retval parity         Parity value at the given index
  */
-static uint8_t GetParity( uint16_t index, uint8_t* matrixRow );
+static uint8_t GetParity( uint16_t index, uint32_t* matrixRow );
 
 /*!
- * \brief Sets the parity value on the given row of the parity matrix
+ * \brief Sets to 1 the parity value on the given row of the parity matrix
  *
  * \param [IN]     index     The index of the row to be computed
  * \param [IN/OUT] matrixRow Pointer to the parity matrix.
- * \param [IN]     parity    The parity value to be set in the parity matrix
  */
-static void SetParity( uint16_t index, uint8_t* matrixRow, uint8_t parity );
+static void SetParity( uint16_t index, uint32_t* matrixRow );
 
 /*!
  * \brief Check if the provided value is a power of 2
@@ -136,11 +175,11 @@ static void XorDataLine( uint8_t* line1, uint8_t* line2, int32_t size );
  *
  * \param [IN]  line1  1st Parity line to be XORed
  * \param [IN]  line2  2nd Parity line to be XORed
- * \param [IN]  size   Number of elements in line1
+ * \param [IN]  size   Number of words in line1
  *
  * \param [OUT] result XOR( line1, line2 ) result stored in line1
  */
-static void XorParityLine( uint8_t* line1, uint8_t* line2, int32_t size );
+static void XorParityLine( uint32_t* line1, const uint32_t* line2, int32_t size );
 
 /*!
  * \brief Generates a pseudo random number : PRBS23
@@ -158,25 +197,16 @@ static int32_t FragPrbs23( int32_t value );
  * \param [IN]  m         Fragment number
  * \param [OUT] matrixRow Parity matrix
  */
-static void FragGetParityMatrixRow( int32_t n, int32_t m, uint8_t* matrixRow );
+static void FragGetParityMatrixRow( int32_t n, int32_t m, uint32_t* matrixRow );
 
 /*!
  * \brief Finds the index of the first one in a bit array
  *
  * \param [IN] bitArray Pointer to the bit array
- * \param [IN] size     Bit array size
- * \retval index        The index of the first 1 in the bit array
+ * \param [IN] size     Bit array size in words
+ * \retval index        The index of the first 1 in the bit array, 0xFFFF if it only contains zeros
  */
-static uint16_t BitArrayFindFirstOne( uint8_t* bitArray, uint16_t size );
-
-/*!
- * \brief Checks if the provided bit array only contains zeros
- *
- * \param [IN] bitArray Pointer to the bit array
- * \param [IN] size     Bit array size
- * \retval isAllZeros   [0: Contains ones, 1: Contains all zeros]
- */
-static uint8_t BitArrayIsAllZeros( uint8_t* bitArray, uint16_t size );
+static uint16_t BitArrayFindFirstOne( uint32_t* bitArray, uint16_t size );
 
 /*!
  * \brief Finds & marks missing fragments
@@ -186,6 +216,38 @@ static uint8_t BitArrayIsAllZeros( uint8_t* bitArray, uint16_t size );
  */
 static void FragFindMissingFrags( uint16_t counter );
 
+/*!
+ * \brief Gets the missing index of a fragment
+ *
+ * \param [IN] index  Fragment index
+ *
+ * \retval missing    0 if the fragment was received, x + 1 if it is the x th missing frag
+ */
+static uint16_t FragGetMissingIndex( uint16_t index );
+
+/*!
+ * \brief Sets the missing index of a fragment
+ *
+ * \remark Fragments are marked in increasing index order
+ *
+ * \param [IN] index         Fragment index
+ * \param [IN] missingIndex  0 if the fragment was received, x + 1 if it is the x th missing frag
+ */
+static void FragSetMissingIndex( uint16_t index, uint16_t missingIndex );
+
+/*!
+ * \brief Records the index (frag counter) of the x th missing frag
+ *
+ * \param [IN] x      x th missing frag, recorded in increasing order
+ * \param [IN] index  The counter value associated to the x th missing frag
+ */
+static void FragSetMissingRow( uint16_t x, uint16_t index );
+
+/*!
+ * \brief Prepares the decoding of the coded fragments, called once all missing frags are known
+ */
+static void FragStartCodedFrags( void );
+
 /*!
  * \brief Finds the index (frag counter) of the x th missing frag
  *
@@ -196,22 +258,49 @@ static void FragFindMissingFrags( uint16_t counter );
 static uint16_t FragFindMissingIndex( uint16_t x );
 
 /*!
- * \brief Extacts a row from the binary matrix and expands it to a bitArray
+ * \brief Gets a row of the binary matrix
+ *
+ * \remark Only the words from rowIndex / 32 onward are valid, the returned pointer must not be dereferenced below
+ *
+ * \param [IN] rowIndex  Matrix row index
+ * \param [IN] rowWords  Number of words in one row
+ * \param [IN] buffer    Buffer of rowWords words the row is read into when it is not held in RAM
+ * \retval row           Pointer to word 0 of the row
+ */
+static const uint32_t* FragGetLineOfBinaryMatrix( uint16_t rowIndex, uint16_t rowWords, uint32_t* buffer );
+
+/*!
+ * \brief Stores a row of the binary matrix, each row is stored once per session
  *
- * \param [IN] bitArray  Pointer to the bit array
  * \param [IN] rowIndex  Matrix row index
- * \param [IN] bitsInRow Number of bits in one row
+ * \param [IN] rowWords  Number of words in one row
+ * \param [IN] line      Row to be stored, FRAG_MATRIX_LINE_WORDS words long and null from rowWords onward
+ */
+static void FragSetLineOfBinaryMatrix( uint16_t rowIndex, uint16_t rowWords, uint32_t* line );
+
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+/*!
+ * \brief Flushes the missing frag indexes recorded so far
  */
-static void FragExtractLineFromBinaryMatrix( uint8_t* bitArray, uint16_t rowIndex, uint16_t bitsInRow );
+static void FragFlushMissingRows( void );
 
 /*!
- * \brief Collapses and Pushs a row of a bit array to the matrix
+ * \brief Gets the scratch area offset of a row of the binary matrix
  *
- * \param [IN] bitArray  Pointer to the bit array
  * \param [IN] rowIndex  Matrix row index
- * \param [IN] bitsInRow Number of bits in one row
+ * \param [IN] rowWords  Number of words in one row
+ * \retval offset        Offset in bytes of word rowIndex / 32 of the row
  */
-static void FragPushLineToBinaryMatrix( uint8_t* bitArray, uint16_t rowIndex, uint16_t bitsInRow );
+static uint32_t FragGetScratchRowOffset( uint16_t rowIndex, uint16_t rowWords );
+
+/*!
+ * \brief Gets the size of the scratch area used by a session
+ *
+ * \param [IN] maxLost  Maximum number of lost fragments of the session
+ * \retval size         Scratch area size in bytes
+ */
+static uint32_t FragGetScratchSize( uint16_t maxLost );
+#endif
 
 /*
  *=============================================================================
@@ -231,23 +320,30 @@ void FragDecoderInit( uint16_t fragNb, uint8_t fragSize, FragDecoderCallbacks_t*
     FragDecoder.Status.FragNbLost   = 0;
     FragDecoder.M2BLine             = 0;
 
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+    // Initialize lost fragments bit array, the matrix area is only erased once the number of lost fragments is known
+    memset( FragDecoder.FragLost, 0, sizeof( FragDecoder.FragLost ) );
+    FragDecoder.FragMissingRowGroupIndex = 0xFFFF;
+    FragDecoder.FragMissingRowGroupDirty = false;
+
+    if( ( FragDecoder.Callbacks != NULL ) && ( FragDecoder.Callbacks->FragDecoderScratchErase != NULL ) )
+    {
+        FragDecoder.Callbacks->FragDecoderScratchErase( 0, FRAG_SCRATCH_MATRIX_OFFSET );
+    }
+#else
     // Initialize missing fragments index array
     for( uint16_t i = 0; i < FRAG_MAX_NB; i++ )
     {
         FragDecoder.FragNbMissingIndex[i] = 1;
     }
+#endif
 
-    // Initialize parity matrix
-    for( uint32_t i = 0; i < ( ( FRAG_MAX_REDUNDANCY >> 3 ) + 1 ); i++ )
+    // Initialize parity matrix, rows are fully written when pushed
+    for( uint32_t i = 0; i < FRAG_MAX_REDUNDANCY_WORDS; i++ )
     {
         FragDecoder.S[i] = 0;
     }
 
-    for( uint32_t i = 0; i < ( ( ( FRAG_MAX_REDUNDANCY >> 3 ) + 1 ) * FRAG_MAX_REDUNDANCY ); i++ )
-    {
-        FragDecoder.MatrixM2B[i] = 0xFF;
-    }
-
     FragDecoder.Status.FragNbLost   = 0;
     FragDecoder.Status.FragNbLastRx = 0;
     FragDecoder.Status.MissingFrag  = fragNb;
@@ -258,21 +354,26 @@ uint32_t FragDecoderGetMaxFileSize( void )
     return FRAG_MAX_NB * FRAG_MAX_SIZE;
 }
 
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+uint32_t FragDecoderGetScratchSize( void )
+{
+    return FragGetScratchSize( ( FRAG_MAX_NB < FRAG_MAX_REDUNDANCY ) ? FRAG_MAX_NB : FRAG_MAX_REDUNDANCY );
+}
+#endif
+
 int32_t FragDecoderProcess( uint16_t fragCounter, uint8_t* rawData )
 {
     uint16_t firstOneInRow = 0;
     int32_t  first         = 0;
     int32_t  noInfo        = 0;
 
-    uint8_t matrixRow[( FRAG_MAX_NB >> 3 ) + 1];
-    uint8_t matrixDataTemp[FRAG_MAX_SIZE];
-    uint8_t dataTempVector[( FRAG_MAX_REDUNDANCY >> 3 ) + 1];
-    uint8_t dataTempVector2[( FRAG_MAX_REDUNDANCY >> 3 ) + 1];
+    uint32_t matrixRow[FRAG_MAX_NB_WORDS];
+    uint8_t  matrixDataTemp[FRAG_MAX_SIZE];
+    uint32_t dataTempVector[FRAG_MATRIX_LINE_WORDS];
 
-    memset( matrixRow, 0, ( FRAG_MAX_NB >> 3 ) + 1 );
+    memset( matrixRow, 0, sizeof( matrixRow ) );
     memset( matrixDataTemp, 0, FRAG_MAX_SIZE );
-    memset( dataTempVector, 0, ( FRAG_MAX_REDUNDANCY >> 3 ) + 1 );
-    memset( dataTempVector2, 0, ( FRAG_MAX_REDUNDANCY >> 3 ) + 1 );
+    memset( dataTempVector, 0, sizeof( dataTempVector ) );
 
     FragDecoder.Status.FragNbRx = fragCounter;
 
@@ -289,7 +390,7 @@ int32_t FragDecoderProcess( uint16_t fragCounter, uint8_t* rawData )
 
         SetRow( rawData, fragCounter - 1, FragDecoder.FragSize );
 
-        FragDecoder.FragNbMissingIndex[fragCounter - 1] = 0;
+        FragSetMissingIndex( fragCounter - 1, 0 );
 
         // Update the FragDecoder.FragNbMissingIndex with the loosing frame
         FragFindMissingFrags( fragCounter );
@@ -313,19 +414,28 @@ int32_t FragDecoderProcess( uint16_t fragCounter, uint8_t* rawData )
 
         // In case of the end of true data is missing
         FragFindMissingFrags( fragCounter );
+        if( FragDecoder.Status.FragNbLost > FRAG_MAX_REDUNDANCY )
+        {
+            FragDecoder.Status.MatrixError = 1;
+            return FRAG_SESSION_FAILED;
+        }
 
         // fragCounter - FragDecoder.FragNb
         FragGetParityMatrixRow( fragCounter - FragDecoder.FragNb, FragDecoder.FragNb, matrixRow );
 
-        for( int32_t i = 0; i < FragDecoder.FragNb; i++ )
+        for( int32_t w = 0; w < ( ( FragDecoder.FragNb + 31 ) >> 5 ); w++ )
         {
-            if( GetParity( i, matrixRow ) == 1 )
+            // Walk the ones of the row a word at a time
+            uint32_t bits = matrixRow[w];
+            while( bits != 0 )
             {
-                if( FragDecoder.FragNbMissingIndex[i] == 0 )
+                int32_t i = ( w << 5 ) + __builtin_ctz( bits );
+                bits &= bits - 1;
+
+                uint16_t missingIndex = FragGetMissingIndex( i );
+                if( missingIndex == 0 )
                 {
                     // XOR with already receive frag
-                    SetParity( i, matrixRow, 0 );
-
                     GetRow( matrixDataTemp, i, FragDecoder.FragSize );
 
                     XorDataLine( rawData, matrixDataTemp, FragDecoder.FragSize );
@@ -333,7 +443,7 @@ int32_t FragDecoderProcess( uint16_t fragCounter, uint8_t* rawData )
                 else
                 {
                     // Fill the "little" boolean matrix m2b
-                    SetParity( FragDecoder.FragNbMissingIndex[i] - 1, dataTempVector, 1 );
+                    SetParity( missingIndex - 1, dataTempVector );
                     if( first == 0 )
                     {
                         first = 1;
@@ -342,41 +452,45 @@ int32_t FragDecoderProcess( uint16_t fragCounter, uint8_t* rawData )
             }
         }
 
-        firstOneInRow = BitArrayFindFirstOne( dataTempVector, FragDecoder.Status.FragNbLost );
+        uint16_t rowWords = ( FragDecoder.Status.FragNbLost + 31 ) >> 5;
+
+        firstOneInRow = BitArrayFindFirstOne( dataTempVector, rowWords );
 
         if( first > 0 )
         {
             int32_t li;
-            int32_t lj;
 
             // Manage a new line in MatrixM2B
             while( GetParity( firstOneInRow, FragDecoder.S ) == 1 )
             {
-                // Row already diagonalized exist & ( FragDecoder.MatrixM2B[firstOneInRow][0] )
-                FragExtractLineFromBinaryMatrix( dataTempVector2, firstOneInRow, FragDecoder.Status.FragNbLost );
-                XorParityLine( dataTempVector, dataTempVector2, FragDecoder.Status.FragNbLost );
+                // Row already diagonalized exist: the words below the pivot are zero in both lines
+                // matrixRow is no longer needed and holds at least rowWords words since lost <= FragNb
+                uint16_t        firstWord = firstOneInRow >> 5;
+                const uint32_t* pivotRow  = FragGetLineOfBinaryMatrix( firstOneInRow, rowWords, matrixRow );
+                XorParityLine( &dataTempVector[firstWord], &pivotRow[firstWord], rowWords - firstWord );
                 // Have to store it in the mi th position of the missing frag
                 li = FragFindMissingIndex( firstOneInRow );
 
                 GetRow( matrixDataTemp, li, FragDecoder.FragSize );
 
                 XorDataLine( rawData, matrixDataTemp, FragDecoder.FragSize );
-                if( BitArrayIsAllZeros( dataTempVector, FragDecoder.Status.FragNbLost ) )
+                firstOneInRow = BitArrayFindFirstOne( dataTempVector, rowWords );
+                if( firstOneInRow == 0xFFFF )
                 {
                     noInfo = 1;
                     break;
                 }
-                firstOneInRow = BitArrayFindFirstOne( dataTempVector, FragDecoder.Status.FragNbLost );
             }
 
             if( noInfo == 0 )
             {
-                FragPushLineToBinaryMatrix( dataTempVector, firstOneInRow, FragDecoder.Status.FragNbLost );
+                // Push the line to the matrix
+                FragSetLineOfBinaryMatrix( firstOneInRow, rowWords, dataTempVector );
                 li = FragFindMissingIndex( firstOneInRow );
 
                 SetRow( rawData, li, FragDecoder.FragSize );
 
-                SetParity( firstOneInRow, FragDecoder.S, 1 );
+                SetParity( firstOneInRow, FragDecoder.S );
                 FragDecoder.M2BLine++;
             }
             FragDecoder.Status.MissingFrag = FragDecoder.Status.FragNbLost - FragDecoder.M2BLine;
@@ -385,7 +499,7 @@ int32_t FragDecoderProcess( uint16_t fragCounter, uint8_t* rawData )
                 // Then last step diagonalized
                 if( FragDecoder.Status.FragNbLost > 1 )
                 {
-                    int32_t i, j;
+                    int32_t i;
 
                     for( i = ( FragDecoder.Status.FragNbLost - 2 ); i >= 0; i-- )
                     {
@@ -393,17 +507,21 @@ int32_t FragDecoderProcess( uint16_t fragCounter, uint8_t* rawData )
 
                         GetRow( matrixDataTemp, li, FragDecoder.FragSize );
 
-                        for( j = ( FragDecoder.Status.FragNbLost - 1 ); j > i; j-- )
+                        // Substitute the already solved fragments flagged after the pivot
+                        const uint32_t* row = FragGetLineOfBinaryMatrix( i, rowWords, matrixRow );
+                        for( int32_t w = i >> 5; w < rowWords; w++ )
                         {
-                            FragExtractLineFromBinaryMatrix( dataTempVector2, i, FragDecoder.Status.FragNbLost );
-                            FragExtractLineFromBinaryMatrix( dataTempVector, j, FragDecoder.Status.FragNbLost );
-                            if( GetParity( j, dataTempVector2 ) == 1 )
+                            uint32_t bits = row[w];
+                            if( w == ( i >> 5 ) )
                             {
-                                XorParityLine( dataTempVector2, dataTempVector, FragDecoder.Status.FragNbLost );
-
-                                lj = FragFindMissingIndex( j );
+                                bits &= ~( ( ( uint32_t ) 2 << ( i & 31 ) ) - 1 );
+                            }
+                            while( bits != 0 )
+                            {
+                                int32_t j = ( w << 5 ) + __builtin_ctz( bits );
+                                bits &= bits - 1;
 
-                                GetRow( rawData, lj, FragDecoder.FragSize );
+                                GetRow( rawData, FragFindMissingIndex( j ), FragDecoder.FragSize );
                                 XorDataLine( matrixDataTemp, rawData, FragDecoder.FragSize );
                             }
                         }
@@ -450,19 +568,14 @@ static void GetRow( uint8_t* dst, uint16_t row, uint16_t size )
     }
 }
 
-static uint8_t GetParity( uint16_t index, uint8_t* matrixRow )
+static uint8_t GetParity( uint16_t index, uint32_t* matrixRow )
 {
-    uint8_t parity;
-    parity = matrixRow[index >> 3];
-    parity = ( parity >> ( 7 - ( index % 8 ) ) ) & 0x01;
-    return parity;
+    return ( matrixRow[index >> 5] >> ( index & 31 ) ) & 0x01;
 }
 
-static void SetParity( uint16_t index, uint8_t* matrixRow, uint8_t parity )
+static void SetParity( uint16_t index, uint32_t* matrixRow )
 {
-    uint8_t mask          = 0xFF - ( 1 << ( 7 - ( index % 8 ) ) );
-    parity                = parity << ( 7 - ( index % 8 ) );
-    matrixRow[index >> 3] = ( matrixRow[index >> 3] & mask ) + parity;
+    matrixRow[index >> 5] |= ( uint32_t ) 1 << ( index & 31 );
 }
 
 static bool IsPowerOfTwo( uint32_t x )
@@ -488,11 +601,11 @@ static void XorDataLine( uint8_t* line1, uint8_t* line2, int32_t size )
     }
 }
 
-static void XorParityLine( uint8_t* line1, uint8_t* line2, int32_t size )
+static void XorParityLine( uint32_t* line1, const uint32_t* line2, int32_t size )
 {
     for( int32_t i = 0; i < size; i++ )
     {
-        SetParity( i, line1, ( GetParity( i, line1 ) ^ GetParity( i, line2 ) ) );
+        line1[i] ^= line2[i];
     }
 }
 
@@ -503,7 +616,7 @@ static int32_t FragPrbs23( int32_t value )
     return ( value >> 1 ) + ( ( b0 ^ b1 ) << 22 );
 }
 
-static void FragGetParityMatrixRow( int32_t n, int32_t m, uint8_t* matrixRow )
+static void FragGetParityMatrixRow( int32_t n, int32_t m, uint32_t* matrixRow )
 {
     int32_t mTemp;
     int32_t x;
@@ -520,7 +633,7 @@ static void FragGetParityMatrixRow( int32_t n, int32_t m, uint8_t* matrixRow )
     }
 
     x = 1 + ( 1001 * n );
-    for( int32_t i = 0; i < ( ( m >> 3 ) + 1 ); i++ )
+    for( int32_t i = 0; i < ( ( m + 31 ) >> 5 ); i++ )
     {
         matrixRow[i] = 0;
     }
@@ -534,34 +647,22 @@ static void FragGetParityMatrixRow( int32_t n, int32_t m, uint8_t* matrixRow )
         }
         if( GetParity( r, matrixRow ) == 0 )
         {
-            SetParity( r, matrixRow, 1 );
+            SetParity( r, matrixRow );
             nbCoeff += 1;
         }
     }
 }
 
-static uint16_t BitArrayFindFirstOne( uint8_t* bitArray, uint16_t size )
-{
-    for( uint16_t i = 0; i < size; i++ )
-    {
-        if( GetParity( i, bitArray ) == 1 )
-        {
-            return i;
-        }
-    }
-    return 0;
-}
-
-static uint8_t BitArrayIsAllZeros( uint8_t* bitArray, uint16_t size )
+static uint16_t BitArrayFindFirstOne( uint32_t* bitArray, uint16_t size )
 {
     for( uint16_t i = 0; i < size; i++ )
     {
-        if( GetParity( i, bitArray ) == 1 )
+        if( bitArray[i] != 0 )
         {
-            return 0;
+            return ( i << 5 ) + __builtin_ctz( bitArray[i] );
         }
     }
-    return 1;
+    return 0xFFFF;
 }
 
 /*!
@@ -578,7 +679,11 @@ static void FragFindMissingFrags( uint16_t counter )
         if( i < FragDecoder.FragNb )
         {
             FragDecoder.Status.FragNbLost++;
-            FragDecoder.FragNbMissingIndex[i] = FragDecoder.Status.FragNbLost;
+            FragSetMissingIndex( i, FragDecoder.Status.FragNbLost );
+            if( FragDecoder.Status.FragNbLost <= FRAG_MAX_REDUNDANCY )
+            {
+                FragSetMissingRow( FragDecoder.Status.FragNbLost - 1, i );
+            }
         }
     }
     if( i < FragDecoder.FragNb )
@@ -587,6 +692,10 @@ static void FragFindMissingFrags( uint16_t counter )
     }
     else
     {
+        if( FragDecoder.Status.FragNbLastRx <= FragDecoder.FragNb )
+        {
+            FragStartCodedFrags( );
+        }
         FragDecoder.Status.FragNbLastRx = FragDecoder.FragNb + 1;
     }
     DBG( "RECEIVED    : %5d / %5d Fragments\n", FragDecoder.Status.FragNbRx, FragDecoder.FragNb );
@@ -595,6 +704,123 @@ static void FragFindMissingFrags( uint16_t counter )
     DBG( "LOST        :       %7d Fragments\n\n", FragDecoder.Status.FragNbLost );
 }
 
+/*!
+ * \brief Gets the missing index of a fragment
+ *
+ * \param [IN] index  Fragment index
+ *
+ * \retval missing    0 if the fragment was received, x + 1 if it is the x th missing frag
+ */
+static uint16_t FragGetMissingIndex( uint16_t index )
+{
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+    uint32_t lost = FragDecoder.FragLost[index >> 5];
+    uint32_t bit  = ( uint32_t ) 1 << ( index & 31 );
+
+    if( ( lost & bit ) == 0 )
+    {
+        return 0;
+    }
+    // Rank of the fragment among the lost ones
+    return FragDecoder.FragLostBefore[index >> 5] + __builtin_popcount( lost & ( bit - 1 ) ) + 1;
+#else
+    return FragDecoder.FragNbMissingIndex[index];
+#endif
+}
+
+/*!
+ * \brief Sets the missing index of a fragment
+ *
+ * \param [IN] index         Fragment index
+ * \param [IN] missingIndex  0 if the fragment was received, x + 1 if it is the x th missing frag
+ */
+static void FragSetMissingIndex( uint16_t index, uint16_t missingIndex )
+{
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+    uint32_t bit = ( uint32_t ) 1 << ( index & 31 );
+
+    if( missingIndex == 0 )
+    {
+        FragDecoder.FragLost[index >> 5] &= ~bit;
+        return;
+    }
+    if( FragDecoder.FragLost[index >> 5] == 0 )
+    {
+        // First lost fragment of the word, the following ones are counted from it
+        FragDecoder.FragLostBefore[index >> 5] = missingIndex - 1;
+    }
+    FragDecoder.FragLost[index >> 5] |= bit;
+#else
+    FragDecoder.FragNbMissingIndex[index] = missingIndex;
+#endif
+}
+
+/*!
+ * \brief Records the index (frag counter) of the x th missing frag
+ *
+ * \param [IN] x      x th missing frag, recorded in increasing order
+ * \param [IN] index  The counter value associated to the x th missing frag
+ */
+static void FragSetMissingRow( uint16_t x, uint16_t index )
+{
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+    uint16_t group = x / FRAG_MISSING_ROW_GROUP;
+
+    if( group != FragDecoder.FragMissingRowGroupIndex )
+    {
+        FragFlushMissingRows( );
+        FragDecoder.FragMissingRowGroupIndex = group;
+    }
+    FragDecoder.FragMissingRowGroup[x % FRAG_MISSING_ROW_GROUP] = index;
+    FragDecoder.FragMissingRowGroupDirty                        = true;
+#else
+    FragDecoder.FragMissingRow[x] = index;
+#endif
+}
+
+/*!
+ * \brief Prepares the decoding of the coded fragments
+ */
+static void FragStartCodedFrags( void )
+{
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+    uint16_t maxLost = FragDecoder.Status.FragNbLost;
+
+    FragFlushMissingRows( );
+
+    // The matrix rows are laid out for the actual number of lost fragments, only erase the pages they use
+    if( maxLost > FRAG_MAX_REDUNDANCY )
+    {
+        maxLost = FRAG_MAX_REDUNDANCY;
+    }
+    if( ( FragDecoder.Callbacks != NULL ) && ( FragDecoder.Callbacks->FragDecoderScratchErase != NULL ) )
+    {
+        FragDecoder.Callbacks->FragDecoderScratchErase( FRAG_SCRATCH_MATRIX_OFFSET,
+                                                        FragGetScratchSize( maxLost ) - FRAG_SCRATCH_MATRIX_OFFSET );
+    }
+#endif
+}
+
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+/*!
+ * \brief Flushes the missing frag indexes recorded so far
+ */
+static void FragFlushMissingRows( void )
+{
+    if( FragDecoder.FragMissingRowGroupDirty == false )
+    {
+        return;
+    }
+    if( ( FragDecoder.Callbacks != NULL ) && ( FragDecoder.Callbacks->FragDecoderScratchWrite != NULL ) )
+    {
+        FragDecoder.Callbacks->FragDecoderScratchWrite(
+            FragDecoder.FragMissingRowGroupIndex * sizeof( FragDecoder.FragMissingRowGroup ),
+            ( uint8_t* ) FragDecoder.FragMissingRowGroup, sizeof( FragDecoder.FragMissingRowGroup ) );
+    }
+    FragDecoder.FragMissingRowGroupDirty = false;
+}
+#endif
+
 /*!
  * \brief Finds the index (frag counter) of the x th missing frag
  *
@@ -604,82 +830,140 @@ static void FragFindMissingFrags( uint16_t counter )
  */
 static uint16_t FragFindMissingIndex( uint16_t x )
 {
-    for( uint16_t i = 0; i < FragDecoder.FragNb; i++ )
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+    uint16_t group = x / FRAG_MISSING_ROW_GROUP;
+
+    // The group is only reloaded once all missing frags are flushed
+    if( group != FragDecoder.FragMissingRowGroupIndex )
     {
-        if( FragDecoder.FragNbMissingIndex[i] == ( x + 1 ) )
+        if( ( FragDecoder.Callbacks != NULL ) && ( FragDecoder.Callbacks->FragDecoderScratchRead != NULL ) )
         {
-            return i;
+            FragDecoder.Callbacks->FragDecoderScratchRead( group * sizeof( FragDecoder.FragMissingRowGroup ),
+                                                           ( uint8_t* ) FragDecoder.FragMissingRowGroup,
+                                                           sizeof( FragDecoder.FragMissingRowGroup ) );
         }
+        FragDecoder.FragMissingRowGroupIndex = group;
     }
-    return 0;
+    return FragDecoder.FragMissingRowGroup[x % FRAG_MISSING_ROW_GROUP];
+#else
+    return FragDecoder.FragMissingRow[x];
+#endif
 }
 
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
 /*!
- * \brief Extacts a row from the binary matrix and expands it to a bitArray
+ * \brief Gets a row of the binary matrix
  *
- * \param [IN] bitArray  Pointer to the bit array
  * \param [IN] rowIndex  Matrix row index
- * \param [IN] bitsInRow Number of bits in one row
+ * \param [IN] rowWords  Number of words in one row
+ * \param [IN] buffer    Buffer the row is read into when it is not held in RAM
+ * \retval row           Pointer to word 0 of the row
  */
-static void FragExtractLineFromBinaryMatrix( uint8_t* bitArray, uint16_t rowIndex, uint16_t bitsInRow )
+static const uint32_t* FragGetLineOfBinaryMatrix( uint16_t rowIndex, uint16_t rowWords, uint32_t* buffer )
 {
-    uint32_t findByte      = 0;
-    uint32_t findBitInByte = 0;
+    uint16_t block = rowIndex >> 5;
 
-    if( rowIndex > 0 )
+    if( rowIndex < FRAG_MATRIX_CACHE_ROWS )
     {
-        findByte      = ( rowIndex * bitsInRow - ( ( rowIndex * ( rowIndex - 1 ) ) >> 1 ) ) >> 3;
-        findBitInByte = ( rowIndex * bitsInRow - ( ( rowIndex * ( rowIndex - 1 ) ) >> 1 ) ) % 8;
+        return FragDecoder.MatrixCache[rowIndex];
     }
-    if( rowIndex > 0 )
+    if( ( FragDecoder.Callbacks != NULL ) && ( FragDecoder.Callbacks->FragDecoderScratchRead != NULL ) )
     {
-        for( uint16_t i = 0; i < rowIndex; i++ )
-        {
-            SetParity( i, bitArray, 0 );
-        }
-    }
-    for( uint16_t i = rowIndex; i < bitsInRow; i++ )
-    {
-        SetParity( i, bitArray, ( FragDecoder.MatrixM2B[findByte] >> ( 7 - findBitInByte ) ) & 0x01 );
-
-        findBitInByte++;
-        if( findBitInByte == 8 )
-        {
-            findBitInByte = 0;
-            findByte++;
-        }
+        FragDecoder.Callbacks->FragDecoderScratchRead( FragGetScratchRowOffset( rowIndex, rowWords ),
+                                                       ( uint8_t* ) &buffer[block],
+                                                       ( rowWords - block ) * sizeof( uint32_t ) );
     }
+    return buffer;
 }
 
 /*!
- * \brief Collapses and Pushs a row of a bit array to the matrix
+ * \brief Stores a row of the binary matrix
  *
- * \param [IN] bitArray  Pointer to the bit array
  * \param [IN] rowIndex  Matrix row index
- * \param [IN] bitsInRow Number of bits in one row
+ * \param [IN] rowWords  Number of words in one row
+ * \param [IN] line      Row to be stored
  */
-static void FragPushLineToBinaryMatrix( uint8_t* bitArray, uint16_t rowIndex, uint16_t bitsInRow )
+static void FragSetLineOfBinaryMatrix( uint16_t rowIndex, uint16_t rowWords, uint32_t* line )
 {
-    uint32_t findByte      = 0;
-    uint32_t findBitInByte = 0;
+    uint16_t block = rowIndex >> 5;
 
-    if( rowIndex > 0 )
+    if( rowIndex < FRAG_MATRIX_CACHE_ROWS )
     {
-        findByte      = ( rowIndex * bitsInRow - ( ( rowIndex * ( rowIndex - 1 ) ) >> 1 ) ) >> 3;
-        findBitInByte = ( rowIndex * bitsInRow - ( ( rowIndex * ( rowIndex - 1 ) ) >> 1 ) ) % 8;
+        memcpy( &FragDecoder.MatrixCache[rowIndex][block], &line[block], ( rowWords - block ) * sizeof( uint32_t ) );
     }
-    for( uint16_t i = rowIndex; i < bitsInRow; i++ )
+    else if( ( FragDecoder.Callbacks != NULL ) && ( FragDecoder.Callbacks->FragDecoderScratchWrite != NULL ) )
     {
-        if( GetParity( i, bitArray ) == 0 )
-        {
-            FragDecoder.MatrixM2B[findByte] =
-                FragDecoder.MatrixM2B[findByte] & ( 0xFF - ( 1 << ( 7 - findBitInByte ) ) );
-        }
-        findBitInByte++;
-        if( findBitInByte == 8 )
-        {
-            findBitInByte = 0;
-            findByte++;
-        }
+        // The padding word past rowWords is null
+        FragDecoder.Callbacks->FragDecoderScratchWrite( FragGetScratchRowOffset( rowIndex, rowWords ),
+                                                        ( uint8_t* ) &line[block],
+                                                        ( ( rowWords - block + 1 ) & ~1 ) * sizeof( uint32_t ) );
     }
 }
+
+/*!
+ * \brief Gets the scratch area offset of a row of the binary matrix
+ *
+ * \param [IN] rowIndex  Matrix row index
+ * \param [IN] rowWords  Number of words in one row
+ * \retval offset        Offset in bytes of word rowIndex / 32 of the row
+ */
+static uint32_t FragGetScratchRowOffset( uint16_t rowIndex, uint16_t rowWords )
+{
+    // Each block of 32 rows stores one word less than the previous one, rounded up to an even number of words
+    uint32_t block = rowIndex >> 5;
+    uint32_t words = block * rowWords - ( ( block * ( block - 1 ) ) >> 1 ) + ( ( block + ( rowWords & 1 ) ) >> 1 );
+
+    words = 32 * words + ( rowIndex & 31 ) * ( ( rowWords - block + 1 ) & ~1 );
+
+    return FRAG_SCRATCH_MATRIX_OFFSET + words * sizeof( uint32_t );
+}
+
+/*!
+ * \brief Gets the size of the scratch area used by a session
+ *
+ * \param [IN] maxLost  Maximum number of lost fragments of the session
+ * \retval size         Scratch area size in bytes
+ */
+static uint32_t FragGetScratchSize( uint16_t maxLost )
+{
+    uint16_t rowWords = ( maxLost + 31 ) >> 5;
+
+    // The matrix ends where the row following the last block would start
+    return FragGetScratchRowOffset( rowWords << 5, rowWords );
+}
+#else
+/*!
+ * \brief Gets a row of the binary matrix
+ *
+ * \param [IN] rowIndex  Matrix row index
+ * \param [IN] rowWords  Number of words in one row
+ * \param [IN] buffer    Unused, the whole matrix is held in RAM
+ * \retval row           Pointer to word 0 of the row
+ */
+static const uint32_t* FragGetLineOfBinaryMatrix( uint16_t rowIndex, uint16_t rowWords, uint32_t* buffer )
+{
+    // Each block of 32 rows stores one word less than the previous one
+    uint32_t block  = rowIndex >> 5;
+    uint32_t offset = 32 * ( block * rowWords - ( ( block * ( block - 1 ) ) >> 1 ) );
+
+    ( void ) buffer;
+    offset += ( rowIndex & 31 ) * ( rowWords - block );
+
+    return &FragDecoder.MatrixM2B[offset - block];
+}
+
+/*!
+ * \brief Stores a row of the binary matrix
+ *
+ * \param [IN] rowIndex  Matrix row index
+ * \param [IN] rowWords  Number of words in one row
+ * \param [IN] line      Row to be stored
+ */
+static void FragSetLineOfBinaryMatrix( uint16_t rowIndex, uint16_t rowWords, uint32_t* line )
+{
+    uint16_t  block = rowIndex >> 5;
+    uint32_t* row   = ( uint32_t* ) FragGetLineOfBinaryMatrix( rowIndex, rowWords, NULL );
+
+    memcpy( &row[block], &line[block], ( rowWords - block ) * sizeof( uint32_t ) );
+}
+#endif
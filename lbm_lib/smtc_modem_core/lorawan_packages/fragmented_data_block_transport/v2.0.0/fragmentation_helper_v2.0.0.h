@@ -72,6 +72,17 @@ extern "C" {
 #define FRAG_MAX_REDUNDANCY FRAG_MAX_NB
 #endif
 
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+/*!
+ * Number of rows of the parity matrix kept in RAM when the matrix lives in the flash scratch area.
+ *
+ * \remark The rows of the first pivots are the ones read back by every coded fragment, they are the ones kept.
+ */
+#ifndef FRAG_MATRIX_CACHE_ROWS
+#define FRAG_MATRIX_CACHE_ROWS 16
+#endif
+#endif
+
 #define FRAG_SESSION_FAILED ( int32_t ) 1
 #define FRAG_SESSION_FINISHED_SUCCESSFULLY ( int32_t ) 0
 #define FRAG_SESSION_NOT_STARTED ( int32_t ) - 2
@@ -109,6 +120,41 @@ typedef struct sFragDecoderCallbacks
      * \retval status Read operation status [0: Success, -1 Fail]
      */
     int8_t ( *FragDecoderRead )( uint32_t addr, uint8_t* data, uint32_t size );
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+    /*!
+     * Erases the pages of the scratch area holding the parity matrix from `addr` to `addr + size`
+     *
+     * \remark Areas are erased in increasing order, a page already holding bytes below `addr` is not erased again
+     *
+     * \param [IN] addr Address start index to erase from.
+     * \param [IN] size Number of bytes to be erased.
+     *
+     * \retval status Erase operation status [0: Success, -1 Fail]
+     */
+    int8_t ( *FragDecoderScratchErase )( uint32_t addr, uint32_t size );
+    /*!
+     * Writes `data` buffer of `size` starting at address `addr` of the scratch area
+     *
+     * \remark `addr` and `size` are multiple of 8, a location is written once between two erases
+     *
+     * \param [IN] addr Address start index to write to.
+     * \param [IN] data Data buffer to be written.
+     * \param [IN] size Size of data buffer to be written.
+     *
+     * \retval status Write operation status [0: Success, -1 Fail]
+     */
+    int8_t ( *FragDecoderScratchWrite )( uint32_t addr, uint8_t* data, uint32_t size );
+    /*!
+     * Reads `data` buffer of `size` starting at address `addr` of the scratch area
+     *
+     * \param [IN] addr Address start index to read from.
+     * \param [IN] data Data buffer to be read.
+     * \param [IN] size Size of data buffer to be read.
+     *
+     * \retval status Read operation status [0: Success, -1 Fail]
+     */
+    int8_t ( *FragDecoderScratchRead )( uint32_t addr, uint8_t* data, uint32_t size );
+#endif
 } FragDecoderCallbacks_t;
 #endif
 
@@ -142,6 +188,15 @@ void FragDecoderInit( uint16_t fragNb, uint8_t fragSize, uint8_t* file, uint32_t
 uint32_t FragDecoderGetMaxFileSize( void );
 #endif
 
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+/*!
+ * \brief Gets the size of the scratch area needed by the largest session
+ *
+ * \retval size Scratch area size in bytes
+ */
+uint32_t FragDecoderGetScratchSize( void );
+#endif
+
 /*!
  * \brief Function to decode and reconstruct the binary file
  *        Called for each receive frame
@@ -115,7 +115,6 @@
  * LoRaWAN Application Layer Fragmented Data Block Transport Specification
  */
 
-#define FRAGMENTATION_PORT 201
 #define FRAGMENTATION_ID 3
 #define FRAGMENTATION_VERSION 2
 #define FRAGMENTATION_MAX_NB_SESSIONS 4
@@ -210,6 +209,11 @@ static FragDecoderCallbacks_t frag_decoder_callback;
 static int8_t                 frag_decoder_write( uint32_t addr, uint8_t* data, uint32_t size );
 static int8_t                 frag_decoder_read( uint32_t addr, uint8_t* data, uint32_t size );
 static uint8_t                compute_data_block_integrity_ckeck( uint8_t frag_index, uint8_t stack_id );
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+static int8_t frag_decoder_scratch_erase( uint32_t addr, uint32_t size );
+static int8_t frag_decoder_scratch_write( uint32_t addr, uint8_t* data, uint32_t size );
+static int8_t frag_decoder_scratch_read( uint32_t addr, uint8_t* data, uint32_t size );
+#endif
 
 /* -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
@@ -287,6 +291,11 @@ void lorawan_fragmentation_package_services_init( uint8_t* service_id, uint8_t t
 
     frag_decoder_callback.FragDecoderWrite = frag_decoder_write;
     frag_decoder_callback.FragDecoderRead  = frag_decoder_read;
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+    frag_decoder_callback.FragDecoderScratchErase = frag_decoder_scratch_erase;
+    frag_decoder_callback.FragDecoderScratchWrite = frag_decoder_scratch_write;
+    frag_decoder_callback.FragDecoderScratchRead  = frag_decoder_scratch_read;
+#endif
     for( int i = 0; i < FRAGMENTATION_MAX_NB_SESSIONS; i++ )
     {
         frag_session_data[i].frag_group_data.session_cnt_prev = -1;
@@ -917,6 +926,37 @@ static int8_t frag_decoder_read( uint32_t addr, uint8_t* data, uint32_t size )
     return 0;
 }
 
+#if defined( FRAG_DECODER_MATRIX_IN_FLASH )
+static int8_t frag_decoder_scratch_erase( uint32_t addr, uint32_t size )
+{
+    uint32_t page_size  = smtc_modem_hal_flash_get_page_size( );
+    uint32_t first_page = ( addr + page_size - 1 ) / page_size;
+    uint32_t end_page   = ( addr + size + page_size - 1 ) / page_size;
+
+    // The page holding addr, if it does not start there, was erased with the previous area
+    while( first_page < end_page )
+    {
+        uint8_t nb_page = MIN( end_page - first_page, 0xFF );
+
+        smtc_modem_hal_context_flash_pages_erase( CONTEXT_FUOTA_MATRIX, first_page * page_size, nb_page );
+        first_page += nb_page;
+    }
+    return 0;
+}
+
+static int8_t frag_decoder_scratch_write( uint32_t addr, uint8_t* data, uint32_t size )
+{
+    smtc_modem_hal_context_store( CONTEXT_FUOTA_MATRIX, addr, data, size );
+    return 0;
+}
+
+static int8_t frag_decoder_scratch_read( uint32_t addr, uint8_t* data, uint32_t size )
+{
+    smtc_modem_hal_context_restore( CONTEXT_FUOTA_MATRIX, addr, data, size );
+    return 0;
+}
+#endif
+
 typedef struct soft_se_key_s
 {
     smtc_se_key_identifier_t key_id;                       //!< Key identifier
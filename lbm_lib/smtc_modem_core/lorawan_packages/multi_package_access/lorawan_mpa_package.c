@@ -117,7 +117,6 @@
  * LoRaWAN Application Layer Fragmented Data Block Transport Specification
  */
 
-#define MPA_PORT 225
 #define MPA_ID 0
 #define MPA_VERSION 1
 #define MPA_NB_PACKAGES 5
@@ -53,6 +53,7 @@
 #include "lorawan_alcsync.h"
 #include "lorawan_class_b_management.h"
 #include "lorawan_remote_multicast_setup_package.h"
+#include "smtc_multicast.h"
 
 /*
  * -----------------------------------------------------------------------------
@@ -118,7 +119,6 @@
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
-#define REMOTE_MULTICAST_SETUP_PORT ( 200 )
 #define REMOTE_MULTICAST_SETUP_ID ( 2 )
 #define REMOTE_MULTICAST_SETUP_VERSION ( 2 )
 #define REMOTE_MULTICAST_SETUP_SIZE_ANS_MAX ( 15 )
@@ -160,7 +160,12 @@ static const uint8_t multicast_setup_req_cmd_size[6] = { REMOTE_MULTICAST_SETUP_
                                                          REMOTE_MULTICAST_SETUP_MC_GROUP_CLASS_C_SESSION_REQ_SIZE,
                                                          REMOTE_MULTICAST_SETUP_MC_GROUP_CLASS_B_SESSION_REQ_SIZE };
 
+// McGroupIDHeader is 2 bits wide: the package sets up the first 4 multicast groups of the stack at most
+#if( LR1MAC_MC_NUMBER_OF_SESSION < 4 )
+#define NB_MULTICAST_GROUPS LR1MAC_MC_NUMBER_OF_SESSION
+#else
 #define NB_MULTICAST_GROUPS ( 4 )
+#endif
 
 typedef enum
 {
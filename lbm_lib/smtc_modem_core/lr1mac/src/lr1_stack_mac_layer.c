@@ -68,7 +68,7 @@
  *-----------------------------------------------------------------------------------
  * --- PRIVATE MACROS ---------------------------------------------------------------
  */
-#define real_const lr1_mac->real->real_const
+#define real_const SMTC_REAL_CONST( lr1_mac->real )
 
 /*
  * -----------------------------------------------------------------------------
@@ -111,6 +111,11 @@ static status_lorawan_t device_time_ans_parser( lr1_stack_mac_t* lr1_mac );
 static void             beacon_freq_req_parser( lr1_stack_mac_t* lr1_mac );
 static void             ping_slot_channel_req_parser( lr1_stack_mac_t* lr1_mac );
 static status_lorawan_t ping_slot_info_ans_parser( lr1_stack_mac_t* lr1_mac );
+static bool             link_snr_offsets_get( lr1_stack_mac_t* lr1_mac, uint8_t datarate, int8_t* demod_floor_db,
+                                              int8_t* bw_gain_db );
+static void             link_history_add( lr1_stack_mac_t* lr1_mac, int16_t snr_db );
+static uint8_t          link_history_worst_snr_get( lr1_stack_mac_t* lr1_mac, int8_t* link_snr_db );
+static void             link_adaptive_dr_select( lr1_stack_mac_t* lr1_mac );
 
 /*
  *-----------------------------------------------------------------------------------
@@ -166,6 +171,8 @@ void lr1_stack_mac_session_init( lr1_stack_mac_t* lr1_mac )
     lr1_mac->ping_slot_info_user_req             = USER_MAC_REQ_NOT_REQUESTED;
     lr1_mac->link_check_margin                   = 0;
     lr1_mac->link_check_gw_cnt                   = 0;
+    lr1_mac->link_history_index                  = 0;
+    lr1_mac->link_history_count                  = 0;
     lr1_mac->rx_down_data.rx_metadata.tx_ack_bit = 0;
     lr1_mac->tx_class_b_bit                      = 0;
 }
@@ -181,6 +188,10 @@ void lr1_stack_mac_region_init( lr1_stack_mac_t* lr1_mac, smtc_real_region_types
                    ( void ( * )( void* ) ) lr1_stack_mac_radio_busy_lbt, lr1_mac,
                    ( void ( * )( void* ) ) lr1_stack_mac_radio_abort_lbt, lr1_mac );
 
+    // Channels of the previous region are not relevant anymore
+    smtc_ch_access_stats_reset( &lr1_mac->ch_access_stats );
+    smtc_lbt_set_stats( lr1_mac->lbt_obj, &lr1_mac->ch_access_stats );
+
     if( real_const.const_lbt_supported == true )
     {
         smtc_lbt_set_parameters( lr1_mac->lbt_obj, smtc_real_get_lbt_duration_ms( lr1_mac->real ),
@@ -194,6 +205,7 @@ void lr1_stack_mac_region_init( lr1_stack_mac_t* lr1_mac, smtc_real_region_types
                            ( void ( * )( void* ) ) lr1_stack_mac_radio_busy_lbt, lr1_mac,
                            ( void ( * )( void* ) ) lr1_stack_mac_radio_busy_cad_keep_channel, lr1_mac,
                            ( void ( * )( void* ) ) lr1_stack_mac_radio_abort_lbt, lr1_mac );
+    smtc_lora_cad_bt_set_stats( lr1_mac->cad_obj, &lr1_mac->ch_access_stats );
 
 #if defined( ENABLE_CSMA_BY_DEFAULT )
     // Do not enable CSMA for region with LBT while both could be not
@@ -301,10 +313,25 @@ void lr1_stack_mac_tx_radio_free_lbt( lr1_stack_mac_t* lr1_mac )
 }
 void lr1_stack_mac_radio_busy_lbt( lr1_stack_mac_t* lr1_mac )
 {
+    // Wait longer before the next listen when the busy channel is often found busy
+    uint8_t busy_ratio = smtc_ch_access_stats_get_busy_ratio( &lr1_mac->ch_access_stats, lr1_mac->tx_frequency );
+    uint32_t back_off_ms =
+        smtc_modem_hal_get_random_nb_in_range( 0, ( LR1MAC_CH_ACCESS_BACK_OFF_MAX_MS * busy_ratio ) / 100 );
+
     lr1_mac->radio_process_state = RADIOSTATE_IDLE;
-    lr1_mac->rtc_target_timer_ms = smtc_modem_hal_get_time_in_ms( ) + lr1_mac->rp->margin_delay;
-    smtc_real_get_next_channel( lr1_mac->real, lr1_mac->tx_data_rate, &lr1_mac->tx_frequency, &lr1_mac->rx1_frequency,
-                                &lr1_mac->nb_available_tx_channel );
+    lr1_mac->rtc_target_timer_ms = smtc_modem_hal_get_time_in_ms( ) + lr1_mac->rp->margin_delay + back_off_ms;
+
+    // Redraw the channel while it is known as chronically busy, as long as another one is available
+    for( uint8_t i = 0; i < LR1MAC_CH_ACCESS_CHANNEL_DRAW_MAX; i++ )
+    {
+        smtc_real_get_next_channel( lr1_mac->real, lr1_mac->tx_data_rate, &lr1_mac->tx_frequency,
+                                    &lr1_mac->rx1_frequency, &lr1_mac->nb_available_tx_channel );
+        if( ( lr1_mac->nb_available_tx_channel <= 1 ) ||
+            ( smtc_ch_access_stats_skip( &lr1_mac->ch_access_stats, lr1_mac->tx_frequency ) == false ) )
+        {
+            break;
+        }
+    }
 }
 void lr1_stack_mac_radio_busy_cad_keep_channel( lr1_stack_mac_t* lr1_mac )
 {
@@ -1162,6 +1189,13 @@ rx_packet_type_t lr1_stack_mac_rx_frame_decode( lr1_stack_mac_t* lr1_mac )
         lr1_mac->tx_fopts_current_length             = 0;  // reset the fopts of the sticky set in payload
         lr1_mac->tx_fopts_lengthsticky = 0;  // reset the fopts of the sticky cmd received on a valid frame
                                              // if received on RX1 or RX2
+
+        int8_t demod_floor_db;
+        int8_t bw_gain_db;
+        if( link_snr_offsets_get( lr1_mac, lr1_mac->rx_data_rate, &demod_floor_db, &bw_gain_db ) == true )
+        {
+            link_history_add( lr1_mac, lr1_mac->rx_down_data.rx_metadata.rx_snr + bw_gain_db );
+        }
     }
 
     SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( " rx_packet_type = %d\n", rx_packet_type );
@@ -1315,6 +1349,11 @@ void lr1_stack_mac_update( lr1_stack_mac_t* lr1_mac )
             {
                 SMTC_MODEM_HAL_PANIC( " Data Rate incompatible with channel mask\n" );
             }
+
+            if( lr1_mac->adr_mode_select == MOBILE_LINK_ADAPTIVE_DR )
+            {
+                link_adaptive_dr_select( lr1_mac );
+            }
         }
     }
     switch( lr1_mac->type_of_ans_to_send )
@@ -1742,6 +1781,21 @@ bool lr1_stack_mac_tx_ack_bit_get( lr1_stack_mac_t* lr1_mac )
 {
     return lr1_mac->rx_down_data.rx_metadata.tx_ack_bit;
 }
+
+bool lr1_stack_link_margin_get( lr1_stack_mac_t* lr1_mac, uint8_t datarate, int16_t* margin_db )
+{
+    int8_t link_snr_db;
+    int8_t demod_floor_db;
+    int8_t bw_gain_db;
+
+    if( ( link_history_worst_snr_get( lr1_mac, &link_snr_db ) < LR1MAC_LINK_HISTORY_MIN_SAMPLES ) ||
+        ( link_snr_offsets_get( lr1_mac, datarate, &demod_floor_db, &bw_gain_db ) == false ) )
+    {
+        return false;
+    }
+    *margin_db = link_snr_db - demod_floor_db - bw_gain_db;
+    return true;
+}
 /*
  *-----------------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DEFINITIONS ------------------------------------------------
@@ -1828,6 +1882,16 @@ static void link_check_parser( lr1_stack_mac_t* lr1_mac )
             lr1_mac->link_check_margin = lr1_mac->nwk_payload[lr1_mac->nwk_payload_index + 1];
             lr1_mac->link_check_gw_cnt = lr1_mac->nwk_payload[lr1_mac->nwk_payload_index + 2];
         }
+
+        // The margin is the uplink SNR above the demodulation floor of the uplink datarate, 255 is reserved
+        int8_t  demod_floor_db;
+        int8_t  bw_gain_db;
+        uint8_t margin = lr1_mac->nwk_payload[lr1_mac->nwk_payload_index + 1];
+        if( ( margin != 255 ) &&
+            ( link_snr_offsets_get( lr1_mac, lr1_mac->tx_data_rate, &demod_floor_db, &bw_gain_db ) == true ) )
+        {
+            link_history_add( lr1_mac, ( int16_t ) margin + demod_floor_db + bw_gain_db );
+        }
     }
     lr1_mac->nwk_payload_index += LINK_CHECK_ANS_SIZE;
 }
@@ -2625,4 +2689,125 @@ static status_lorawan_t ping_slot_info_ans_parser( lr1_stack_mac_t* lr1_mac )
     return ret;
 }
 
+static bool link_snr_offsets_get( lr1_stack_mac_t* lr1_mac, uint8_t datarate, int8_t* demod_floor_db,
+                                  int8_t* bw_gain_db )
+{
+    if( smtc_real_get_modulation_type_from_datarate( lr1_mac->real, datarate ) != LORA )
+    {
+        return false;
+    }
+
+    uint8_t            sf;
+    lr1mac_bandwidth_t bw;
+    smtc_real_lora_dr_to_sf_bw( lr1_mac->real, datarate, &sf, &bw );
+
+    // LoRa demodulation floor: -7.5dB at SF7 and 2.5dB lower for each SF step
+    *demod_floor_db = ( -5 * ( sf - 6 ) - 10 ) / 2;
+
+    // Link SNR are normalized to a 125 kHz noise bandwidth: a wider bandwidth collects more noise
+    switch( bw )
+    {
+    case BW250:
+        *bw_gain_db = 3;
+        break;
+    case BW500:
+        *bw_gain_db = 6;
+        break;
+    case BW800:
+        *bw_gain_db = 8;
+        break;
+    case BW1600:
+        *bw_gain_db = 11;
+        break;
+    default:
+        *bw_gain_db = 0;
+        break;
+    }
+    return true;
+}
+
+static void link_history_add( lr1_stack_mac_t* lr1_mac, int16_t snr_db )
+{
+    lr1mac_link_sample_t* sample = &lr1_mac->link_history[lr1_mac->link_history_index];
+
+    sample->timestamp_s = smtc_modem_hal_get_time_in_s( );
+    sample->snr_db      = ( int8_t ) ( ( snr_db > 127 ) ? 127 : ( ( snr_db < -128 ) ? -128 : snr_db ) );
+
+    lr1_mac->link_history_index = ( lr1_mac->link_history_index + 1 ) % LR1MAC_LINK_HISTORY_SIZE;
+    if( lr1_mac->link_history_count < LR1MAC_LINK_HISTORY_SIZE )
+    {
+        lr1_mac->link_history_count++;
+    }
+}
+
+static uint8_t link_history_worst_snr_get( lr1_stack_mac_t* lr1_mac, int8_t* link_snr_db )
+{
+    uint32_t now_s         = smtc_modem_hal_get_time_in_s( );
+    uint8_t  fresh_samples = 0;
+
+    // Worst fresh sample: the link has to survive the fading seen over the history
+    *link_snr_db = 127;
+    for( uint8_t i = 0; i < lr1_mac->link_history_count; i++ )
+    {
+        if( ( now_s - lr1_mac->link_history[i].timestamp_s ) <= LR1MAC_LINK_HISTORY_MAX_AGE_S )
+        {
+            fresh_samples++;
+            if( lr1_mac->link_history[i].snr_db < *link_snr_db )
+            {
+                *link_snr_db = lr1_mac->link_history[i].snr_db;
+            }
+        }
+    }
+    return fresh_samples;
+}
+
+static void link_adaptive_dr_select( lr1_stack_mac_t* lr1_mac )
+{
+    int8_t  link_snr_db;
+    uint8_t fresh_samples = link_history_worst_snr_get( lr1_mac, &link_snr_db );
+
+    lr1_mac->tx_power = lr1_mac->max_erp_dbm;
+    if( fresh_samples < LR1MAC_LINK_HISTORY_MIN_SAMPLES )
+    {
+        // Stale history: keep the datarate drawn from the long range distribution at max power
+        return;
+    }
+
+    // Fastest datarate that keeps the target margin, else the most robust one
+    uint16_t dr_mask   = smtc_real_mask_tx_dr_channel_up_dwell_time_check( lr1_mac->real );
+    int16_t  margin_db = 0;
+    bool     found     = false;
+    for( int16_t dr = smtc_real_get_max_tx_channel_dr( lr1_mac->real );
+         dr >= smtc_real_get_min_tx_channel_dr( lr1_mac->real ); dr-- )
+    {
+        int8_t demod_floor_db;
+        int8_t bw_gain_db;
+        if( ( SMTC_GET_BIT16( &dr_mask, dr ) == 0 ) ||
+            ( link_snr_offsets_get( lr1_mac, ( uint8_t ) dr, &demod_floor_db, &bw_gain_db ) == false ) )
+        {
+            continue;
+        }
+        lr1_mac->tx_data_rate = ( uint8_t ) dr;
+        margin_db             = link_snr_db - demod_floor_db - bw_gain_db;
+        if( margin_db >= LR1MAC_LINK_ADAPTIVE_TARGET_MARGIN_DB )
+        {
+            found = true;
+            break;
+        }
+    }
+
+    if( found == true )
+    {
+        // Spend the margin left above the target in TX power, by steps of 2dB
+        uint8_t power_idx = ( uint8_t ) ( ( margin_db - LR1MAC_LINK_ADAPTIVE_TARGET_MARGIN_DB ) / 2 );
+        while( ( power_idx > 0 ) && ( smtc_real_is_tx_power_valid( lr1_mac->real, power_idx ) == ERRORLORAWAN ) )
+        {
+            power_idx--;
+        }
+        lr1_mac->tx_power = smtc_real_convert_power_cmd( lr1_mac->real, power_idx, lr1_mac->max_erp_dbm );
+    }
+    SMTC_MODEM_HAL_TRACE_PRINTF( "Link adaptive dr: snr %d dB, dr %d, power %d dBm\n", link_snr_db,
+                                 lr1_mac->tx_data_rate, lr1_mac->tx_power );
+}
+
 /* --- EOF ------------------------------------------------------------------ */
@@ -77,6 +77,8 @@ typedef struct lr1_stack_mac_s
     smtc_lbt_t*         lbt_obj;
     smtc_lora_cad_bt_t* cad_obj;
 
+    smtc_ch_access_stats_t ch_access_stats;  // Busy ratio and noise floor learnt by lbt and cad listens
+
     void ( *push_callback )( lr1_stack_mac_down_data_t* );
     void* push_context;
 
@@ -91,6 +93,9 @@ typedef struct lr1_stack_mac_s
     uint8_t nb_trans;
     uint8_t nb_trans_cpt;
     uint8_t nb_available_tx_channel;
+    // Frequencies already used by the repetitions of the current frame
+    uint32_t nb_trans_freq_hz[LR1MAC_NB_TRANS_FREQ_HISTORY_SIZE];
+    uint8_t  nb_trans_freq_cnt;
     /********************************************/
     /*     Update by RxParamaSetupRequest       */
     /********************************************/
@@ -155,6 +160,10 @@ typedef struct lr1_stack_mac_s
     uint16_t dev_nonce;
     uint8_t  join_nonce[6];  // Join_nonce + NetId
     uint8_t  cf_list[16];
+#if defined( LR1MAC_NVM_JOURNAL )
+    uint32_t nvm_journal_base_crc;  // crc of the full context stored in nvm
+    uint16_t nvm_journal_index;     // next free record in the nvm journal
+#endif
 
     // LoRaWan Mac Data for nwk Ans
     uint8_t nwk_payload[NWK_MAC_PAYLOAD_MAX_SIZE];  //@note resize this buffer
@@ -214,6 +223,11 @@ typedef struct lr1_stack_mac_s
     uint8_t link_check_margin;
     uint8_t link_check_gw_cnt;
 
+    // Link history (downlink SNR and LinkCheckAns margin) for the link adaptive datarate strategy
+    lr1mac_link_sample_t link_history[LR1MAC_LINK_HISTORY_SIZE];
+    uint8_t              link_history_index;
+    uint8_t              link_history_count;
+
     // Network Device Time
     uint32_t seconds_since_epoch;
     uint32_t fractional_second;
@@ -447,6 +461,16 @@ uint32_t lr1_stack_get_crystal_error( lr1_stack_mac_t* lr1_mac );
  */
 void lr1_stack_set_crystal_error( lr1_stack_mac_t* lr1_mac, uint32_t crystal_error );
 
+/**
+ * @brief Get the margin of the recent link above the demodulation floor of a datarate
+ *
+ * @param lr1_mac
+ * @param [in]  datarate    Datarate the margin is computed for
+ * @param [out] margin_db   Margin of the worst fresh link sample, in dB
+ * @return bool             false if the link history is too old or the datarate is not a LoRa one
+ */
+bool lr1_stack_link_margin_get( lr1_stack_mac_t* lr1_mac, uint8_t datarate, int16_t* margin_db );
+
 /**
  * @brief
  *
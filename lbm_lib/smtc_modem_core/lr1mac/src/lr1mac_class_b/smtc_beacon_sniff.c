@@ -120,6 +120,13 @@ static void compute_beacon_metadata( smtc_lr1_beacon_t* lr1_beacon_obj, uint32_t
  */
 static void update_beacon_pll( smtc_lr1_beacon_t* lr1_beacon_obj, uint32_t timestamp );
 
+/**
+ * @brief update the residual phase error of the beacon pll with the last measured error
+ *
+ * @param [in,out] lr1_beacon_obj Beacon object
+ */
+static void update_beacon_dpll_residual( smtc_lr1_beacon_t* lr1_beacon_obj );
+
 /**
  * @brief update beacon state
  *
@@ -656,11 +663,14 @@ static void update_beacon_pll( smtc_lr1_beacon_t* lr1_beacon_obj, uint32_t times
             lr1_beacon_obj->dpll_error_wo_filtering = 0;
             lr1_beacon_obj->dpll_error_sum          = 0;
             lr1_beacon_obj->dpll_phase_100us        = timestamp - 10 * lr1_beacon_obj->beacon_toa;
+            lr1_beacon_obj->dpll_residual_100us     = 0;
+            lr1_beacon_obj->dpll_residual_nb_sample = 0;
         }
         if( lr1_beacon_obj->beacon_statistics.beacon_state == BEACON_LOCK )
         {
             lr1_beacon_obj->dpll_error_wo_filtering =
                 timestamp - lr1_beacon_obj->dpll_phase_100us - ( 10 * lr1_beacon_obj->beacon_toa );
+            update_beacon_dpll_residual( lr1_beacon_obj );
             lr1_beacon_obj->dpll_error =
                 ( BEACON_PLL_PHASE_GAIN_MUL * lr1_beacon_obj->dpll_error + lr1_beacon_obj->dpll_error_wo_filtering ) /
                 BEACON_PLL_PHASE_GAIN_DIV;
@@ -682,6 +692,26 @@ static void update_beacon_pll( smtc_lr1_beacon_t* lr1_beacon_obj, uint32_t times
                                                          ? ( 100 * SIGN( lr1_beacon_obj->dpll_error ) )
                                                          : lr1_beacon_obj->dpll_error );
 }
+static void update_beacon_dpll_residual( smtc_lr1_beacon_t* lr1_beacon_obj )
+{
+    // The phase error of each missed beacon period accumulates until a beacon is received again
+    uint32_t residual_100us = ( uint32_t ) ABS( lr1_beacon_obj->dpll_error_wo_filtering ) /
+                              ( lr1_beacon_obj->beacon_statistics.last_beacon_lost_consecutively + 1 );
+
+    // Follow a larger error at once but forget it slowly, the rx window must not be sized on a lucky beacon
+    if( ( lr1_beacon_obj->dpll_residual_nb_sample == 0 ) || ( residual_100us > lr1_beacon_obj->dpll_residual_100us ) )
+    {
+        lr1_beacon_obj->dpll_residual_100us = residual_100us;
+    }
+    else
+    {
+        lr1_beacon_obj->dpll_residual_100us = ( 7 * lr1_beacon_obj->dpll_residual_100us + residual_100us ) / 8;
+    }
+    if( lr1_beacon_obj->dpll_residual_nb_sample < UINT8_MAX )
+    {
+        lr1_beacon_obj->dpll_residual_nb_sample++;
+    }
+}
 static void update_beacon_state( smtc_lr1_beacon_t* lr1_beacon_obj )
 {
     if( ( lr1_beacon_obj->is_valid_beacon == false ) &&
@@ -738,13 +768,24 @@ static void update_beacon_rx_nb_symb( smtc_lr1_beacon_t* lr1_beacon_obj, uint32_
     {
         uint32_t rx_timeout_symb_in_ms_tmp;  // unused for beacon
         uint32_t rx_timeout_symb_locked_in_ms_tmp;
+        uint32_t drift_ppm = lr1_beacon_obj->lr1_mac->crystal_error;
+
+        // Once the dpll tracks the crystal frequency, only its residual phase error is left: a locked device opens a
+        // few symbols window, widening with the number of beacon periods since the last received beacon
+        if( lr1_beacon_obj->dpll_residual_nb_sample >= BEACON_DPLL_RESIDUAL_NB_SAMPLE )
+        {
+            uint32_t residual_us    = BEACON_DPLL_RESIDUAL_MARGIN * ( lr1_beacon_obj->dpll_residual_100us + 1 ) * 100;
+            uint32_t dpll_drift_ppm = ( residual_us + BEACON_PERIOD_S - 1 ) / BEACON_PERIOD_S;
+            drift_ppm = MIN( drift_ppm, dpll_drift_ppm );
+        }
         SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG(
-            "rx delay = %d ms\n", target_time - lr1_beacon_obj->beacon_statistics.last_beacon_received_timestamp );
+            "rx delay = %d ms, drift = %u ppm\n",
+            target_time - lr1_beacon_obj->beacon_statistics.last_beacon_received_timestamp, drift_ppm );
         smtc_real_get_rx_window_parameters(
             lr1_beacon_obj->lr1_mac->real, BEACON_DATA_RATE( ),
             ( target_time - lr1_beacon_obj->beacon_statistics.last_beacon_received_timestamp ),
             &lr1_beacon_obj->beacon_open_rx_nb_symb, &rx_timeout_symb_in_ms_tmp, &rx_timeout_symb_locked_in_ms_tmp, 0,
-            lr1_beacon_obj->lr1_mac->crystal_error );
+            drift_ppm );
         // in case of beacon has not been YET received 4 times consecutively it enlarge the rx windows.
         if( lr1_beacon_obj->beacon_statistics.last_beacon_lost_consecutively == 0 )
         {
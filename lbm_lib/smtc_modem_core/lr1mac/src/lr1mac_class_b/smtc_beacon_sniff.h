@@ -110,6 +110,13 @@ extern "C" {
  */
 #define BEACON_PLL_PHASE_GAIN_MUL ( 7 )
 #define BEACON_PLL_PHASE_GAIN_DIV ( 8 )
+/**
+ * @brief once locked, the digital pll compensates the crystal frequency error and the beacon rx window is sized from
+ * the residual phase error measured on the received beacons instead of the crystal error. The residual is trusted
+ * after BEACON_DPLL_RESIDUAL_NB_SAMPLE measurements and is multiplied by BEACON_DPLL_RESIDUAL_MARGIN
+ */
+#define BEACON_DPLL_RESIDUAL_NB_SAMPLE ( 4 )
+#define BEACON_DPLL_RESIDUAL_MARGIN ( 4 )
 
 /*
  * -----------------------------------------------------------------------------
@@ -188,6 +195,8 @@ typedef struct smtc_lr1_beacon_s
     int32_t  dpll_error_sum;           //!< the cumulative digital pll phase error after low pass filter
     uint32_t dpll_frequency_100us;     //!< the digital pll frequency with a 0.1ms resolution
     uint32_t dpll_phase_100us;         //!< the digital pll phase with a 0.1ms resolution
+    uint32_t dpll_residual_100us;      //!< the digital pll phase error per beacon period, peak tracking average
+    uint8_t  dpll_residual_nb_sample;  //!< the number of phase error measured since the digital pll is locked
     uint8_t  listen_beacon_rate;  //!< default value : DEFAULT_LISTEN_BEACON_RATE, referred to the explanation of this
                                   //!< default value to understood this parameter
 
@@ -781,17 +781,23 @@ static void smtc_ping_slot_compute_next_ping_offset_time( smtc_ping_slot_t* ping
     {
         if( ping_slot_obj->rx_session_param[i]->enabled == true )
         {
-            // While ( (ping slot in past) AND (ping_number > 0)
-            while( ( ( int32_t ) ( ping_slot_obj->rx_session_param[i]->ping_slot_parameters.ping_offset_time -
-                                   timestamp ) <= 0 ) &&
-                   ( ping_slot_obj->rx_session_param[i]->ping_slot_parameters.ping_number > 0 ) )
+            smtc_ping_slot_parameters_t* ping_param = &ping_slot_obj->rx_session_param[i]->ping_slot_parameters;
+
+            int32_t late_ms = ( int32_t ) ( timestamp - ping_param->ping_offset_time );
+            if( ( late_ms < 0 ) || ( ping_param->ping_number == 0 ) )
             {
-                ping_slot_obj->rx_session_param[i]->ping_slot_parameters.ping_number--;
-                ping_slot_obj->rx_session_param[i]->ping_slot_parameters.ping_offset_time +=
-                    ( ping_slot_obj->rx_session_param[i]->ping_slot_parameters.ping_period * 30 );
-                ping_slot_obj->rx_session_param[i]->ping_slot_parameters.ping_offset_time_100us +=
-                    ( ping_slot_obj->rx_session_param[i]->ping_slot_parameters.ping_period * 300 );
+                continue;
             }
+
+            // Skip at once all the ping slots in past (ie: missed during a long radio planner abort), within the
+            // ping_number remaining in this beacon period
+            uint32_t ping_period_ms = ( uint32_t ) ping_param->ping_period * 30;
+            uint32_t nb_ping_slot   = MIN( ( ( uint32_t ) late_ms / ping_period_ms ) + 1,
+                                           ( uint32_t ) ping_param->ping_number );
+
+            ping_param->ping_number -= ( uint8_t ) nb_ping_slot;
+            ping_param->ping_offset_time += nb_ping_slot * ping_period_ms;
+            ping_param->ping_offset_time_100us += nb_ping_slot * ping_period_ms * 10;
         }
     }
 }
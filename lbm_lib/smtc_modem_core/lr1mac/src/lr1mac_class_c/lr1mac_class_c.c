@@ -91,6 +91,11 @@ static rx_packet_type_t lr1mac_class_c_mac_rx_frame_decode( lr1mac_class_c_t* cl
 static void             lr1mac_class_c_rp_callback( lr1mac_class_c_t* class_c_obj );
 static int              lr1mac_class_c_mac_downlink_check_under_it( lr1mac_class_c_t* class_c_obj );
 static void             lr1mac_class_c_launch( lr1mac_class_c_t* class_c_obj );
+static void             lr1mac_class_c_rx_radio_params_build( lr1mac_class_c_t* class_c_obj );
+static void             lr1mac_class_c_rx_launch_callback_for_rp( void* rp_void );
+
+static void              lr1mac_class_c_dev_addr_index_update( lr1mac_class_c_t* class_c_obj );
+static rx_session_type_t lr1mac_class_c_dev_addr_index_search( const lr1mac_class_c_t* class_c_obj, uint32_t dev_addr );
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -159,12 +164,16 @@ void lr1mac_class_c_stop( lr1mac_class_c_t* class_c_obj )
     lr1mac_class_c_multicast_stop_all_sessions( class_c_obj );
 #endif
     rp_task_abort( class_c_obj->rp, class_c_obj->class_c_id4rp );
+    class_c_obj->rx_stopped = false;
 }
 
 void lr1mac_class_c_start( lr1mac_class_c_t* class_c_obj )
 {
     if( class_c_obj->started == false )
     {
+        class_c_obj->rx_radio_params_valid = false;
+        class_c_obj->rx_radio_configured   = false;
+        class_c_obj->rx_stopped            = false;
         lr1mac_class_c_launch( class_c_obj );
     }
 }
@@ -187,11 +196,19 @@ void lr1mac_class_c_launch( lr1mac_class_c_t* class_c_obj )
         SMTC_MODEM_HAL_PANIC( "class_c_obj bad initialization \n" );
     }
 
+    bool dev_addr_changed =
+        ( class_c_obj->rx_session_param[RX_SESSION_UNICAST]->dev_addr != class_c_obj->lr1_mac->dev_addr );
+
     // copy context from LR1MAC class A for the unicast session
     class_c_obj->rx_session_param[RX_SESSION_UNICAST]->dev_addr     = class_c_obj->lr1_mac->dev_addr;
     class_c_obj->rx_session_param[RX_SESSION_UNICAST]->rx_data_rate = class_c_obj->lr1_mac->rx2_data_rate;
     class_c_obj->rx_session_param[RX_SESSION_UNICAST]->rx_frequency = class_c_obj->lr1_mac->rx2_frequency;
 
+    if( ( dev_addr_changed == true ) || ( class_c_obj->started == false ) )
+    {
+        lr1mac_class_c_dev_addr_index_update( class_c_obj );
+    }
+
     class_c_obj->rx_session_index = RX_SESSION_COUNT;
     for( rx_session_type_t i = 0; i < LR1MAC_NUMBER_OF_RXC_SESSION; i++ )
     {
@@ -207,76 +224,17 @@ void lr1mac_class_c_launch( lr1mac_class_c_t* class_c_obj )
         SMTC_MODEM_HAL_PANIC( "no RxC session enabled\n" );
     }
 
-    rp_radio_params_t rp_radio_params = { 0 };
-    rp_radio_params.rx.timeout_in_ms  = 120000;
-
-    modulation_type_t modulation_type = smtc_real_get_modulation_type_from_datarate(
-        class_c_obj->lr1_mac->real, RX_SESSION_PARAM_CURRENT->rx_data_rate );
-
-    if( modulation_type == LORA )
-    {
-        uint8_t            sf;
-        lr1mac_bandwidth_t bw;
-        smtc_real_lora_dr_to_sf_bw( class_c_obj->lr1_mac->real, RX_SESSION_PARAM_CURRENT->rx_data_rate, &sf, &bw );
-
-        ralf_params_lora_t lora_param;
-        memset( &lora_param, 0, sizeof( ralf_params_lora_t ) );
-
-        lora_param.sync_word       = smtc_real_get_sync_word( class_c_obj->lr1_mac->real );
-        lora_param.symb_nb_timeout = 0;
-        lora_param.rf_freq_in_hz   = RX_SESSION_PARAM_CURRENT->rx_frequency;
-
-        lora_param.pkt_params.header_type = RAL_LORA_PKT_EXPLICIT;
-
-        // +5 for MIC + FPort
-        lora_param.pkt_params.pld_len_in_bytes =
-            5 + smtc_real_get_max_payload_size( class_c_obj->lr1_mac->real, RX_SESSION_PARAM_CURRENT->rx_data_rate,
-                                                DOWN_LINK );
-        lora_param.pkt_params.crc_is_on       = false;
-        lora_param.pkt_params.invert_iq_is_on = true;
-        lora_param.pkt_params.preamble_len_in_symb =
-            smtc_real_get_preamble_len( class_c_obj->lr1_mac->real, lora_param.mod_params.sf );
-
-        lora_param.mod_params.cr   = smtc_real_get_coding_rate( class_c_obj->lr1_mac->real );
-        lora_param.mod_params.sf   = ( ral_lora_sf_t ) sf;
-        lora_param.mod_params.bw   = ( ral_lora_bw_t ) bw;
-        lora_param.mod_params.ldro = ral_compute_lora_ldro( lora_param.mod_params.sf, lora_param.mod_params.bw );
-
-        rp_radio_params.pkt_type = RAL_PKT_TYPE_LORA;
-        rp_radio_params.rx.lora  = lora_param;
-    }
-    else if( modulation_type == FSK )
-    {
-        uint8_t kbitrate;
-        smtc_real_fsk_dr_to_bitrate( class_c_obj->lr1_mac->real, RX_SESSION_PARAM_CURRENT->rx_data_rate, &kbitrate );
-        ralf_params_gfsk_t gfsk_param;
-        memset( &gfsk_param, 0, sizeof( ralf_params_gfsk_t ) );
-
-        gfsk_param.rf_freq_in_hz  = RX_SESSION_PARAM_CURRENT->rx_frequency;
-        gfsk_param.sync_word      = smtc_real_get_gfsk_sync_word( class_c_obj->lr1_mac->real );
-        gfsk_param.whitening_seed = GFSK_WHITENING_SEED;
-        gfsk_param.crc_seed       = GFSK_CRC_SEED;
-        gfsk_param.crc_polynomial = GFSK_CRC_POLYNOMIAL;
-
-        gfsk_param.pkt_params.header_type           = RAL_GFSK_PKT_VAR_LEN;
-        gfsk_param.pkt_params.pld_len_in_bytes      = 255;
-        gfsk_param.pkt_params.preamble_len_in_bits  = 40;
-        gfsk_param.pkt_params.preamble_detector     = RAL_GFSK_PREAMBLE_DETECTOR_MIN_16BITS;
-        gfsk_param.pkt_params.sync_word_len_in_bits = 24;
-        gfsk_param.pkt_params.crc_type              = RAL_GFSK_CRC_2_BYTES_INV;
-        gfsk_param.pkt_params.dc_free               = RAL_GFSK_DC_FREE_WHITENING;
-
-        gfsk_param.mod_params.br_in_bps    = kbitrate * 1000;
-        gfsk_param.mod_params.fdev_in_hz   = 25000;
-        gfsk_param.mod_params.bw_dsb_in_hz = 100000;
-        gfsk_param.mod_params.pulse_shape  = RAL_GFSK_PULSE_SHAPE_BT_1;
-
-        rp_radio_params.pkt_type = RAL_PKT_TYPE_GFSK;
-        rp_radio_params.rx.gfsk  = gfsk_param;
-    }
-    else
+    uint8_t sync_word   = smtc_real_get_sync_word( class_c_obj->lr1_mac->real );
+    uint8_t max_payload = smtc_real_get_max_payload_size( class_c_obj->lr1_mac->real,
+                                                          RX_SESSION_PARAM_CURRENT->rx_data_rate, DOWN_LINK );
+    if( ( class_c_obj->rx_radio_params_valid == false ) ||
+        ( class_c_obj->rx_radio_params_session != class_c_obj->rx_session_index ) ||
+        ( class_c_obj->rx_radio_params_freq != RX_SESSION_PARAM_CURRENT->rx_frequency ) ||
+        ( class_c_obj->rx_radio_params_dr != RX_SESSION_PARAM_CURRENT->rx_data_rate ) ||
+        ( class_c_obj->rx_radio_params_sync_word != sync_word ) ||
+        ( class_c_obj->rx_radio_params_max_payload != max_payload ) )
     {
-        SMTC_MODEM_HAL_PANIC( "MODULATION NOT SUPPORTED\n" );
+        lr1mac_class_c_rx_radio_params_build( class_c_obj );
     }
 
     rp_task_t rp_task        = { 0 };
@@ -285,19 +243,18 @@ void lr1mac_class_c_launch( lr1mac_class_c_t* class_c_obj )
     rp_task.start_time_ms    = smtc_modem_hal_get_time_in_ms( ) + 4;
     rp_task.duration_time_ms = LR1MAC_RCX_MIN_DURATION_MS;
 
-    if( rp_radio_params.pkt_type == RAL_PKT_TYPE_LORA )
+    rp_task.launch_task_callbacks = lr1mac_class_c_rx_launch_callback_for_rp;
+    if( class_c_obj->rx_radio_params.pkt_type == RAL_PKT_TYPE_LORA )
     {
-        rp_task.type                  = RP_TASK_TYPE_RX_LORA;
-        rp_task.launch_task_callbacks = lr1_stack_mac_rx_lora_launch_callback_for_rp;
+        rp_task.type = RP_TASK_TYPE_RX_LORA;
     }
     else
     {
-        rp_task.type                  = RP_TASK_TYPE_RX_FSK;
-        rp_task.launch_task_callbacks = lr1_stack_mac_rx_gfsk_launch_callback_for_rp;
+        rp_task.type = RP_TASK_TYPE_RX_FSK;
     }
 
     if( rp_task_enqueue( class_c_obj->rp, &rp_task, class_c_obj->lr1_mac->rx_down_data.rx_payload, 255,
-                         &rp_radio_params ) != RP_HOOK_STATUS_OK )
+                         &class_c_obj->rx_radio_params ) != RP_HOOK_STATUS_OK )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "class_c_obj START ERROR \n" );
     }
@@ -324,6 +281,12 @@ static void lr1mac_class_c_rp_callback( lr1mac_class_c_t* class_c_obj )
 
     if( class_c_obj->started == true )
     {
+        // The device is deaf until the continuous reception is re-armed by the radio planner
+        if( class_c_obj->rx_stopped == false )
+        {
+            class_c_obj->rx_stopped      = true;
+            class_c_obj->rx_stop_time_ms = smtc_modem_hal_get_time_in_ms( );
+        }
         lr1mac_class_c_launch( class_c_obj );
     }
 }
@@ -402,6 +365,11 @@ void lr1mac_class_c_mac_rp_callback( lr1mac_class_c_t* class_c_obj )
     }
 }
 
+void lr1mac_class_c_get_deaf_stats( lr1mac_class_c_t* class_c_obj, lr1mac_class_c_deaf_stats_t* deaf_stats )
+{
+    *deaf_stats = class_c_obj->deaf_stats;
+}
+
 #if defined( SMTC_MULTICAST )
 smtc_multicast_config_rc_t lr1mac_class_c_multicast_start_session( lr1mac_class_c_t* class_c_obj, uint8_t mc_group_id,
                                                                    uint32_t freq, uint8_t dr )
@@ -474,6 +442,7 @@ smtc_multicast_config_rc_t lr1mac_class_c_multicast_start_session( lr1mac_class_
         // Abort current continuous reception (will be automatically restarted in rp abort callback)
         rp_task_abort( class_c_obj->rp, class_c_obj->class_c_id4rp );
     }
+    lr1mac_class_c_dev_addr_index_update( class_c_obj );
 
     return SMTC_MC_RC_OK;
 }
@@ -521,6 +490,7 @@ smtc_multicast_config_rc_t lr1mac_class_c_multicast_stop_session( lr1mac_class_c
     {
         // At least 1 multicast session is still active, do nothing
     }
+    lr1mac_class_c_dev_addr_index_update( class_c_obj );
     return SMTC_MC_RC_OK;
 }
 
@@ -562,6 +532,187 @@ smtc_multicast_config_rc_t lr1mac_class_c_multicast_get_session_status( lr1mac_c
  * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
  */
 
+static void lr1mac_class_c_rx_radio_params_build( lr1mac_class_c_t* class_c_obj )
+{
+    memset( &class_c_obj->rx_radio_params, 0, sizeof( rp_radio_params_t ) );
+    class_c_obj->rx_radio_params.rx.timeout_in_ms = 120000;
+
+    modulation_type_t modulation_type = smtc_real_get_modulation_type_from_datarate(
+        class_c_obj->lr1_mac->real, RX_SESSION_PARAM_CURRENT->rx_data_rate );
+
+    if( modulation_type == LORA )
+    {
+        uint8_t            sf;
+        lr1mac_bandwidth_t bw;
+        smtc_real_lora_dr_to_sf_bw( class_c_obj->lr1_mac->real, RX_SESSION_PARAM_CURRENT->rx_data_rate, &sf, &bw );
+
+        ralf_params_lora_t lora_param;
+        memset( &lora_param, 0, sizeof( ralf_params_lora_t ) );
+
+        lora_param.sync_word       = smtc_real_get_sync_word( class_c_obj->lr1_mac->real );
+        lora_param.symb_nb_timeout = 0;
+        lora_param.rf_freq_in_hz   = RX_SESSION_PARAM_CURRENT->rx_frequency;
+
+        lora_param.pkt_params.header_type = RAL_LORA_PKT_EXPLICIT;
+
+        // +5 for MIC + FPort
+        lora_param.pkt_params.pld_len_in_bytes =
+            5 + smtc_real_get_max_payload_size( class_c_obj->lr1_mac->real, RX_SESSION_PARAM_CURRENT->rx_data_rate,
+                                                DOWN_LINK );
+        lora_param.pkt_params.crc_is_on       = false;
+        lora_param.pkt_params.invert_iq_is_on = true;
+        lora_param.pkt_params.preamble_len_in_symb =
+            smtc_real_get_preamble_len( class_c_obj->lr1_mac->real, lora_param.mod_params.sf );
+
+        lora_param.mod_params.cr   = smtc_real_get_coding_rate( class_c_obj->lr1_mac->real );
+        lora_param.mod_params.sf   = ( ral_lora_sf_t ) sf;
+        lora_param.mod_params.bw   = ( ral_lora_bw_t ) bw;
+        lora_param.mod_params.ldro = ral_compute_lora_ldro( lora_param.mod_params.sf, lora_param.mod_params.bw );
+
+        class_c_obj->rx_radio_params.pkt_type = RAL_PKT_TYPE_LORA;
+        class_c_obj->rx_radio_params.rx.lora  = lora_param;
+    }
+    else if( modulation_type == FSK )
+    {
+        uint8_t kbitrate;
+        smtc_real_fsk_dr_to_bitrate( class_c_obj->lr1_mac->real, RX_SESSION_PARAM_CURRENT->rx_data_rate, &kbitrate );
+        ralf_params_gfsk_t gfsk_param;
+        memset( &gfsk_param, 0, sizeof( ralf_params_gfsk_t ) );
+
+        gfsk_param.rf_freq_in_hz  = RX_SESSION_PARAM_CURRENT->rx_frequency;
+        gfsk_param.sync_word      = smtc_real_get_gfsk_sync_word( class_c_obj->lr1_mac->real );
+        gfsk_param.whitening_seed = GFSK_WHITENING_SEED;
+        gfsk_param.crc_seed       = GFSK_CRC_SEED;
+        gfsk_param.crc_polynomial = GFSK_CRC_POLYNOMIAL;
+
+        gfsk_param.pkt_params.header_type           = RAL_GFSK_PKT_VAR_LEN;
+        gfsk_param.pkt_params.pld_len_in_bytes      = 255;
+        gfsk_param.pkt_params.preamble_len_in_bits  = 40;
+        gfsk_param.pkt_params.preamble_detector     = RAL_GFSK_PREAMBLE_DETECTOR_MIN_16BITS;
+        gfsk_param.pkt_params.sync_word_len_in_bits = 24;
+        gfsk_param.pkt_params.crc_type              = RAL_GFSK_CRC_2_BYTES_INV;
+        gfsk_param.pkt_params.dc_free               = RAL_GFSK_DC_FREE_WHITENING;
+
+        gfsk_param.mod_params.br_in_bps    = kbitrate * 1000;
+        gfsk_param.mod_params.fdev_in_hz   = 25000;
+        gfsk_param.mod_params.bw_dsb_in_hz = 100000;
+        gfsk_param.mod_params.pulse_shape  = RAL_GFSK_PULSE_SHAPE_BT_1;
+
+        class_c_obj->rx_radio_params.pkt_type = RAL_PKT_TYPE_GFSK;
+        class_c_obj->rx_radio_params.rx.gfsk  = gfsk_param;
+    }
+    else
+    {
+        SMTC_MODEM_HAL_PANIC( "MODULATION NOT SUPPORTED\n" );
+    }
+
+    class_c_obj->rx_radio_params_valid     = true;
+    class_c_obj->rx_radio_params_changed   = true;
+    class_c_obj->rx_radio_params_session   = class_c_obj->rx_session_index;
+    class_c_obj->rx_radio_params_freq      = RX_SESSION_PARAM_CURRENT->rx_frequency;
+    class_c_obj->rx_radio_params_dr        = RX_SESSION_PARAM_CURRENT->rx_data_rate;
+    class_c_obj->rx_radio_params_sync_word = smtc_real_get_sync_word( class_c_obj->lr1_mac->real );
+    class_c_obj->rx_radio_params_max_payload =
+        smtc_real_get_max_payload_size( class_c_obj->lr1_mac->real, RX_SESSION_PARAM_CURRENT->rx_data_rate, DOWN_LINK );
+}
+
+static void lr1mac_class_c_rx_launch_callback_for_rp( void* rp_void )
+{
+    radio_planner_t*  rp          = ( radio_planner_t* ) rp_void;
+    uint8_t           id          = rp->radio_task_id;
+    lr1mac_class_c_t* class_c_obj = ( lr1mac_class_c_t* ) rp->hooks[id];
+
+    // No other task used the radio since the last continuous reception with the same parameters: the radio woke up
+    // from a sleep with retention still configured, only the reception has to be started again
+    if( ( class_c_obj->rx_radio_configured == true ) && ( class_c_obj->rx_radio_params_changed == false ) &&
+        ( rp->launched_task_cnt == ( class_c_obj->rx_radio_configured_rp_cnt + 1 ) ) )
+    {
+        while( ( int32_t ) ( rp->tasks[id].start_time_ms - smtc_modem_hal_get_time_in_ms( ) ) > 0 )
+        {
+        }
+        smtc_modem_hal_start_radio_tcxo( );
+        smtc_modem_hal_set_ant_switch( false );
+        SMTC_MODEM_HAL_PANIC_ON_FAILURE( ral_set_rx( &( rp->radio->ral ), rp->radio_params[id].rx.timeout_in_ms ) ==
+                                         RAL_STATUS_OK );
+        rp_stats_set_rx_timestamp( &rp->stats, smtc_modem_hal_get_time_in_ms( ) );
+        class_c_obj->deaf_stats.nb_fast_rearm++;
+    }
+    else if( rp->radio_params[id].pkt_type == RAL_PKT_TYPE_LORA )
+    {
+        lr1_stack_mac_rx_lora_launch_callback_for_rp( rp_void );
+    }
+    else
+    {
+        lr1_stack_mac_rx_gfsk_launch_callback_for_rp( rp_void );
+    }
+    class_c_obj->rx_radio_configured        = true;
+    class_c_obj->rx_radio_params_changed    = false;
+    class_c_obj->rx_radio_configured_rp_cnt = rp->launched_task_cnt;
+
+    if( class_c_obj->rx_stopped == true )
+    {
+        uint32_t deaf_ms = smtc_modem_hal_get_time_in_ms( ) - class_c_obj->rx_stop_time_ms;
+
+        class_c_obj->rx_stopped = false;
+        class_c_obj->deaf_stats.nb_interruption++;
+        class_c_obj->deaf_stats.last_deaf_ms = deaf_ms;
+        class_c_obj->deaf_stats.max_deaf_ms  = MAX( class_c_obj->deaf_stats.max_deaf_ms, deaf_ms );
+        class_c_obj->deaf_stats.total_deaf_ms += deaf_ms;
+    }
+}
+
+static void lr1mac_class_c_dev_addr_index_update( lr1mac_class_c_t* class_c_obj )
+{
+    uint8_t nb = 0;
+
+    for( uint8_t i = 0; i < LR1MAC_NUMBER_OF_RXC_SESSION; i++ )
+    {
+        if( class_c_obj->rx_session_param[i]->enabled == true )
+        {
+            uint32_t dev_addr = class_c_obj->rx_session_param[i]->dev_addr;
+            uint8_t  pos      = nb;
+
+            // Insert after the sessions with the same DevAddr so that the lowest session is found first, pos is
+            // always below the session count but the bound lets the compiler drop the shift for a single session
+            while( ( pos > 0 ) && ( pos < LR1MAC_NUMBER_OF_RXC_SESSION ) &&
+                   ( class_c_obj->dev_addr_index_addr[pos - 1] > dev_addr ) )
+            {
+                class_c_obj->dev_addr_index_addr[pos]    = class_c_obj->dev_addr_index_addr[pos - 1];
+                class_c_obj->dev_addr_index_session[pos] = class_c_obj->dev_addr_index_session[pos - 1];
+                pos--;
+            }
+            class_c_obj->dev_addr_index_addr[pos]    = dev_addr;
+            class_c_obj->dev_addr_index_session[pos] = i;
+            nb++;
+        }
+    }
+    class_c_obj->dev_addr_index_nb = nb;
+}
+
+static rx_session_type_t lr1mac_class_c_dev_addr_index_search( const lr1mac_class_c_t* class_c_obj, uint32_t dev_addr )
+{
+    uint8_t low  = 0;
+    uint8_t high = class_c_obj->dev_addr_index_nb;
+
+    while( low < high )
+    {
+        uint8_t mid = ( low + high ) >> 1;
+        if( class_c_obj->dev_addr_index_addr[mid] < dev_addr )
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    if( ( low < class_c_obj->dev_addr_index_nb ) && ( class_c_obj->dev_addr_index_addr[low] == dev_addr ) )
+    {
+        return ( rx_session_type_t ) class_c_obj->dev_addr_index_session[low];
+    }
+    return RX_SESSION_COUNT;
+}
+
 static int lr1mac_class_c_mac_downlink_check_under_it( lr1mac_class_c_t* class_c_obj )
 {
     SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( "%s\n", __func__ );
@@ -585,15 +736,7 @@ static int lr1mac_class_c_mac_downlink_check_under_it( lr1mac_class_c_t* class_c
                                 ( class_c_obj->lr1_mac->rx_down_data.rx_payload[3] << 16 ) +
                                 ( class_c_obj->lr1_mac->rx_down_data.rx_payload[4] << 24 );
 
-        for( rx_session_type_t i = 0; i < LR1MAC_NUMBER_OF_RXC_SESSION; i++ )
-        {
-            if( ( dev_addr_tmp == class_c_obj->rx_session_param[i]->dev_addr ) &&
-                ( class_c_obj->rx_session_param[i]->enabled == true ) )
-            {
-                class_c_obj->rx_session_index = i;
-                break;
-            }
-        }
+        class_c_obj->rx_session_index = lr1mac_class_c_dev_addr_index_search( class_c_obj, dev_addr_tmp );
 
         if( class_c_obj->rx_session_index >= LR1MAC_NUMBER_OF_RXC_SESSION )
         {
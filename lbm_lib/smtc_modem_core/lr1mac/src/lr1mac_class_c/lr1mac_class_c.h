@@ -73,6 +73,15 @@ extern "C" {
  * --- PUBLIC TYPES ------------------------------------------------------------
  */
 
+typedef struct lr1mac_class_c_deaf_stats_s
+{
+    uint32_t nb_interruption;  // Number of times the continuous reception stopped then was re-armed
+    uint32_t nb_fast_rearm;    // Number of re-arms done without reconfiguring the radio
+    uint32_t last_deaf_ms;     // Time without reception during the last interruption
+    uint32_t max_deaf_ms;      // Longest time without reception
+    uint32_t total_deaf_ms;    // Cumulated time without reception
+} lr1mac_class_c_deaf_stats_t;
+
 typedef struct lr1mac_class_c_s
 {
     bool             enabled;        // Service is enabled/disabled
@@ -93,8 +102,30 @@ typedef struct lr1mac_class_c_s
     lr1mac_rx_session_param_t  rx_session_param_unicast;
     lr1mac_rx_session_param_t* rx_session_param[LR1MAC_NUMBER_OF_RXC_SESSION];
 
+    // Enabled sessions sorted by DevAddr, the session of a received frame is found by a binary search
+    uint32_t dev_addr_index_addr[LR1MAC_NUMBER_OF_RXC_SESSION];
+    uint8_t  dev_addr_index_session[LR1MAC_NUMBER_OF_RXC_SESSION];
+    uint8_t  dev_addr_index_nb;
+
     rx_packet_type_t valid_rx_packet;
 
+    // Radio configuration of the continuous reception, rebuilt only when the listened session or a runtime regional
+    // setting it depends on changes
+    rp_radio_params_t rx_radio_params;
+    bool              rx_radio_params_valid;
+    bool              rx_radio_params_changed;  // Radio must be fully configured on next launch
+    rx_session_type_t rx_radio_params_session;
+    uint32_t          rx_radio_params_freq;
+    uint8_t           rx_radio_params_dr;
+    uint8_t           rx_radio_params_sync_word;    // Changed by the network type
+    uint8_t           rx_radio_params_max_payload;  // Changed by the downlink dwell time
+    bool              rx_radio_configured;         // Radio holds rx_radio_params since the launch below
+    uint32_t          rx_radio_configured_rp_cnt;  // Radio planner launched task count at the last launch
+
+    bool                        rx_stopped;       // Continuous reception stopped, waiting to be re-armed
+    uint32_t                    rx_stop_time_ms;  // Time at which the continuous reception stopped
+    lr1mac_class_c_deaf_stats_t deaf_stats;
+
     uint8_t tx_mtype;
     uint8_t rx_ftype;
     uint8_t rx_major;
@@ -168,6 +199,14 @@ bool lr1mac_class_c_is_running( lr1mac_class_c_t* class_c_obj );
  */
 void lr1mac_class_c_mac_rp_callback( lr1mac_class_c_t* class_c_obj );
 
+/**
+ * @brief Get the statistics of the time without reception between two continuous receptions
+ *
+ * @param class_c_obj
+ * @param deaf_stats
+ */
+void lr1mac_class_c_get_deaf_stats( lr1mac_class_c_t* class_c_obj, lr1mac_class_c_deaf_stats_t* deaf_stats );
+
 #if defined( SMTC_MULTICAST )
 /**
  * @brief Start the class C multicast session
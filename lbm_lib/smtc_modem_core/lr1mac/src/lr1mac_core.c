@@ -47,6 +47,7 @@
 #include "smtc_real_defs_str.h"
 #include "smtc_lbt.h"
 #include "smtc_lora_cad_bt.h"
+#include "smtc_duty_cycle.h"
 #include "lr1mac_config.h"
 
 #if defined( RELAY_TX )
@@ -91,8 +92,17 @@ static const char* smtc_name_lr_fhss_cr[] = { "CR 5/6", "CR 2/3", "CR 1/2", "CR
  *-----------------------------------------------------------------------------------
  *--- PRIVATE FUNCTIONS DECLARATION -------------------------------------------------
  */
-static void copy_user_payload( lr1_stack_mac_t* lr1_mac_obj, const uint8_t* data_in, const uint8_t size_in );
-static void lr1mac_mac_update( lr1_stack_mac_t* lr1_mac_obj );
+static void             copy_user_payload( lr1_stack_mac_t* lr1_mac_obj, const uint8_t* data_in,
+                                           const uint8_t size_in );
+static void             lr1mac_mac_update( lr1_stack_mac_t* lr1_mac_obj );
+static status_lorawan_t lr1mac_core_nb_trans_channel_select( lr1_stack_mac_t* lr1_mac_obj );
+static uint8_t          lr1mac_core_nb_trans_diversity_get( lr1_stack_mac_t* lr1_mac_obj, uint32_t freq_hz );
+#if defined( LR1MAC_NVM_JOURNAL )
+static uint16_t lr1mac_core_context_journal_capacity( void );
+static uint32_t lr1mac_core_context_journal_offset( lr1_stack_mac_t* lr1_mac_obj, uint16_t index );
+static void     lr1mac_core_context_journal_replay( lr1_stack_mac_t* lr1_mac_obj );
+static void     lr1mac_core_context_journal_erase( lr1_stack_mac_t* lr1_mac_obj );
+#endif
 /*
  *-----------------------------------------------------------------------------------
  *--- PUBLIC FUNCTIONS DEFINITIONS --------------------------------------------------
@@ -306,7 +316,7 @@ lr1mac_states_t lr1mac_core_process( lr1_stack_mac_t* lr1_mac_obj )
             if( lr1_mac_obj->join_status == JOINING )
             {
                 // save devnonce after the end of TX
-                lr1mac_core_context_save( lr1_mac_obj );
+                lr1mac_core_context_counters_save( lr1_mac_obj );
             }
 
             lr1_stack_mac_update_tx_done( lr1_mac_obj );
@@ -642,6 +652,16 @@ status_lorawan_t lr1mac_core_payload_send_at_time( lr1_stack_mac_t* lr1_mac_obj,
     return status;
 }
 
+uint8_t* lr1mac_core_payload_buffer_get( lr1_stack_mac_t* lr1_mac_obj )
+{
+    if( lr1_mac_obj->lr1mac_state != LWPSTATE_IDLE )
+    {
+        return NULL;
+    }
+    // Same location as copy_user_payload for a frame with an application FPort
+    return &( lr1_mac_obj->tx_payload[FHDROFFSET + 1 + lr1_mac_obj->tx_fopts_current_length] );
+}
+
 status_lorawan_t lr1mac_core_payload_send( lr1_stack_mac_t* lr1_mac_obj, uint8_t fport, bool fport_enabled,
                                            const uint8_t* data_in, uint8_t size_in, uint8_t packet_type,
                                            uint32_t target_time_ms )
@@ -715,6 +735,7 @@ status_lorawan_t lr1mac_core_payload_send( lr1_stack_mac_t* lr1_mac_obj, uint8_t
     lr1_mac_obj->rx_down_data.rx_metadata.rx_fport         = 0;
     lr1_mac_obj->rx_down_data.rx_metadata.rx_fport_present = false;
     lr1_mac_obj->nb_trans_cpt                              = lr1_mac_obj->nb_trans;
+    lr1_mac_obj->nb_trans_freq_cnt                         = 0;
     lr1_mac_obj->lr1mac_state                              = LWPSTATE_SEND;
 
     return OKLORAWAN;
@@ -824,7 +845,47 @@ void lr1mac_core_context_save( lr1_stack_mac_t* lr1_mac_obj )
         lr1_mac_nvm_context_t dummy_context = { 0 };
         smtc_modem_hal_context_restore( CONTEXT_LORAWAN_STACK, lr1_mac_obj->stack_id * sizeof( ctx ),
                                         ( uint8_t* ) &dummy_context, sizeof( dummy_context ) );
+
+#if defined( LR1MAC_NVM_JOURNAL )
+        // journal records are now part of the full context: records left in case of reset before the erase are
+        // ignored at load as they refer to the previous context crc
+        lr1_mac_obj->nvm_journal_base_crc = ctx.crc;
+        if( lr1_mac_obj->nvm_journal_index != 0 )
+        {
+            lr1mac_core_context_journal_erase( lr1_mac_obj );
+        }
+#endif
+    }
+}
+
+void lr1mac_core_context_counters_save( lr1_stack_mac_t* lr1_mac_obj )
+{
+#if defined( LR1MAC_NVM_JOURNAL )
+    if( lr1_mac_obj->nvm_journal_index >= lr1mac_core_context_journal_capacity( ) )
+    {
+        // Journal is full, compact it in the full context
+        lr1mac_core_context_save( lr1_mac_obj );
+        return;
     }
+
+    lr1_mac_nvm_journal_entry_t entry = { 0 };
+    entry.devnonce                    = lr1_mac_obj->dev_nonce;
+    memcpy( entry.join_nonce, lr1_mac_obj->join_nonce, sizeof( entry.join_nonce ) );
+    entry.base_crc = lr1_mac_obj->nvm_journal_base_crc;
+    entry.crc      = lr1mac_utilities_crc( ( uint8_t* ) &entry, sizeof( entry ) - sizeof( entry.crc ) );
+
+    uint32_t offset = lr1mac_core_context_journal_offset( lr1_mac_obj, lr1_mac_obj->nvm_journal_index );
+    smtc_modem_hal_context_store( CONTEXT_LORAWAN_STACK_JOURNAL, offset, ( uint8_t* ) &entry, sizeof( entry ) );
+
+    // dummy record reading to ensure record store is done before exiting the function
+    lr1_mac_nvm_journal_entry_t dummy_entry = { 0 };
+    smtc_modem_hal_context_restore( CONTEXT_LORAWAN_STACK_JOURNAL, offset, ( uint8_t* ) &dummy_entry,
+                                    sizeof( dummy_entry ) );
+
+    lr1_mac_obj->nvm_journal_index++;
+#else
+    lr1mac_core_context_save( lr1_mac_obj );
+#endif
 }
 
 status_lorawan_t lr1mac_core_context_load( lr1_stack_mac_t* lr1_mac_obj )
@@ -840,6 +901,10 @@ status_lorawan_t lr1mac_core_context_load( lr1_stack_mac_t* lr1_mac_obj )
         lr1_mac_obj->is_lorawan_modem_certification_enabled = ctx.certification_enabled;
         lr1_mac_obj->real->region_type                      = ctx.region;
 
+#if defined( LR1MAC_NVM_JOURNAL )
+        lr1_mac_obj->nvm_journal_base_crc = ctx.crc;
+        lr1mac_core_context_journal_replay( lr1_mac_obj );
+#endif
         return OKLORAWAN;
     }
     else
@@ -863,6 +928,11 @@ void lr1mac_core_context_factory_reset( lr1_stack_mac_t* lr1_mac_obj )
     lr1_mac_nvm_context_t dummy_context = { 0 };
     smtc_modem_hal_context_restore( CONTEXT_LORAWAN_STACK, lr1_mac_obj->stack_id * sizeof( ctx ),
                                     ( uint8_t* ) &dummy_context, sizeof( dummy_context ) );
+
+#if defined( LR1MAC_NVM_JOURNAL )
+    lr1_mac_obj->nvm_journal_base_crc = ctx.crc;
+    lr1mac_core_context_journal_erase( lr1_mac_obj );
+#endif
 }
 
 /**************************************************/
@@ -1205,8 +1275,14 @@ static void copy_user_payload( lr1_stack_mac_t* lr1_mac_obj, const uint8_t* data
         tx_fopts_length = lr1_mac_obj->tx_fopts_current_length;
     }
 
-    memcpy( &( lr1_mac_obj->tx_payload[FHDROFFSET + lr1_mac_obj->tx_fport_present + tx_fopts_length] ), data_in,
-            size_in );
+    uint8_t* payload = &( lr1_mac_obj->tx_payload[FHDROFFSET + lr1_mac_obj->tx_fport_present + tx_fopts_length] );
+
+    // Payload already built in place with lr1mac_core_payload_buffer_get: nothing to copy
+    if( payload != data_in )
+    {
+        // data_in may overlap tx_payload if the buffer was got for another FPort configuration
+        memmove( payload, data_in, size_in );
+    }
 }
 
 void lr1mac_core_abort( lr1_stack_mac_t* lr1_mac_obj )
@@ -1239,7 +1315,7 @@ static void lr1mac_mac_update( lr1_stack_mac_t* lr1_mac_obj )
             lr1_mac_obj->adr_mode_select = lr1_mac_obj->adr_mode_select_tmp;
             smtc_real_set_dr_distribution( lr1_mac_obj->real, lr1_mac_obj->adr_mode_select_tmp,
                                            &lr1_mac_obj->nb_trans );
-            lr1mac_core_context_save( lr1_mac_obj );
+            lr1mac_core_context_counters_save( lr1_mac_obj );
         }
         else
         {
@@ -1284,9 +1360,19 @@ static void lr1mac_mac_update( lr1_stack_mac_t* lr1_mac_obj )
     if( ( lr1_mac_obj->type_of_ans_to_send == NWKFRAME_TOSEND ) ||
         ( lr1_mac_obj->type_of_ans_to_send == USRFRAME_TORETRANSMIT ) )
     {  // @note ack send during the next tx|| ( packet.IsFrameToSend == USERACK_TOSEND ) ) {
-        if( smtc_real_get_next_channel( lr1_mac_obj->real, lr1_mac_obj->tx_data_rate, &lr1_mac_obj->tx_frequency,
-                                        &lr1_mac_obj->rx1_frequency,
-                                        &lr1_mac_obj->nb_available_tx_channel ) != OKLORAWAN )
+        status_lorawan_t channel_status;
+        if( lr1_mac_obj->type_of_ans_to_send == USRFRAME_TORETRANSMIT )
+        {
+            channel_status = lr1mac_core_nb_trans_channel_select( lr1_mac_obj );
+        }
+        else
+        {
+            lr1_mac_obj->nb_trans_freq_cnt = 0;
+            channel_status = smtc_real_get_next_channel( lr1_mac_obj->real, lr1_mac_obj->tx_data_rate,
+                                                         &lr1_mac_obj->tx_frequency, &lr1_mac_obj->rx1_frequency,
+                                                         &lr1_mac_obj->nb_available_tx_channel );
+        }
+        if( channel_status != OKLORAWAN )
         {
             lr1_mac_obj->lr1mac_state = LWPSTATE_IDLE;
             if( lr1_mac_obj->type_of_ans_to_send == USRFRAME_TORETRANSMIT )
@@ -1297,9 +1383,12 @@ static void lr1mac_mac_update( lr1_stack_mac_t* lr1_mac_obj )
         }
         else
         {
+            // The gap is never shorter than the frame itself, so that a same interferer burst cannot hit two copies
+            uint32_t gap_min_ms = MAX( LR1MAC_NB_TRANS_GAP_MIN_MS, lr1_stack_toa_get( lr1_mac_obj ) );
             lr1_mac_obj->type_of_ans_to_send = NOFRAME_TOSEND;
             lr1_mac_obj->rtc_target_timer_ms =
-                smtc_modem_hal_get_time_in_ms( ) + smtc_modem_hal_get_random_nb_in_range( 300, 3000 );
+                smtc_modem_hal_get_time_in_ms( ) +
+                smtc_modem_hal_get_random_nb_in_range( gap_min_ms, gap_min_ms + LR1MAC_NB_TRANS_GAP_JITTER_MS );
             lr1_mac_obj->lr1mac_state = LWPSTATE_TX_WAIT;
         }
     }
@@ -1310,4 +1399,139 @@ static void lr1mac_mac_update( lr1_stack_mac_t* lr1_mac_obj )
     lr1_mac_obj->valid_rx_packet = NO_MORE_VALID_RX_PACKET;
 }
 
+static status_lorawan_t lr1mac_core_nb_trans_channel_select( lr1_stack_mac_t* lr1_mac_obj )
+{
+    // Keep track of the frequency used by the copy just sent
+    if( lr1_mac_obj->nb_trans_freq_cnt < LR1MAC_NB_TRANS_FREQ_HISTORY_SIZE )
+    {
+        lr1_mac_obj->nb_trans_freq_hz[lr1_mac_obj->nb_trans_freq_cnt++] = lr1_mac_obj->tx_frequency;
+    }
+    else
+    {
+        memmove( &lr1_mac_obj->nb_trans_freq_hz[0], &lr1_mac_obj->nb_trans_freq_hz[1],
+                 ( LR1MAC_NB_TRANS_FREQ_HISTORY_SIZE - 1 ) * sizeof( lr1_mac_obj->nb_trans_freq_hz[0] ) );
+        lr1_mac_obj->nb_trans_freq_hz[LR1MAC_NB_TRANS_FREQ_HISTORY_SIZE - 1] = lr1_mac_obj->tx_frequency;
+    }
+
+    // A region that masks each drawn channel already spreads the copies, and extra draws would corrupt its state
+    if( smtc_real_is_channel_selection_stateful( lr1_mac_obj->real ) == true )
+    {
+        return smtc_real_get_next_channel( lr1_mac_obj->real, lr1_mac_obj->tx_data_rate, &lr1_mac_obj->tx_frequency,
+                                           &lr1_mac_obj->rx1_frequency, &lr1_mac_obj->nb_available_tx_channel );
+    }
+
+    // The region draws a random free channel: keep the most diverse of a few draws
+    uint32_t best_tx_frequency  = 0;
+    uint32_t best_rx1_frequency = 0;
+    uint8_t  best_diversity     = 0;
+    for( uint8_t draw = 0; draw < LR1MAC_NB_TRANS_CHANNEL_DRAW_MAX; draw++ )
+    {
+        if( smtc_real_get_next_channel( lr1_mac_obj->real, lr1_mac_obj->tx_data_rate, &lr1_mac_obj->tx_frequency,
+                                        &lr1_mac_obj->rx1_frequency,
+                                        &lr1_mac_obj->nb_available_tx_channel ) != OKLORAWAN )
+        {
+            return ERRORLORAWAN;
+        }
+
+        uint8_t diversity = lr1mac_core_nb_trans_diversity_get( lr1_mac_obj, lr1_mac_obj->tx_frequency );
+        if( ( draw == 0 ) || ( diversity > best_diversity ) )
+        {
+            best_tx_frequency  = lr1_mac_obj->tx_frequency;
+            best_rx1_frequency = lr1_mac_obj->rx1_frequency;
+            best_diversity     = diversity;
+        }
+        if( ( best_diversity == 2 ) || ( lr1_mac_obj->nb_available_tx_channel <= 1 ) )
+        {
+            break;
+        }
+    }
+    lr1_mac_obj->tx_frequency  = best_tx_frequency;
+    lr1_mac_obj->rx1_frequency = best_rx1_frequency;
+    return OKLORAWAN;
+}
+
+static uint8_t lr1mac_core_nb_trans_diversity_get( lr1_stack_mac_t* lr1_mac_obj, uint32_t freq_hz )
+{
+    // 2: other sub-band and duty cycle band than all previous copies, 1: other channel only, 0: channel reused
+    uint8_t diversity = 2;
+    for( uint8_t i = 0; i < lr1_mac_obj->nb_trans_freq_cnt; i++ )
+    {
+        uint32_t prev_freq_hz = lr1_mac_obj->nb_trans_freq_hz[i];
+        uint32_t spacing_hz   = ( freq_hz > prev_freq_hz ) ? ( freq_hz - prev_freq_hz ) : ( prev_freq_hz - freq_hz );
+        if( spacing_hz == 0 )
+        {
+            return 0;
+        }
+        if( ( spacing_hz < LR1MAC_NB_TRANS_SUBBAND_SPACING_HZ ) ||
+            ( smtc_duty_cycle_is_same_band( freq_hz, prev_freq_hz ) == true ) )
+        {
+            diversity = 1;
+        }
+    }
+    return diversity;
+}
+
+#if defined( LR1MAC_NVM_JOURNAL )
+static uint16_t lr1mac_core_context_journal_capacity( void )
+{
+    return smtc_modem_hal_flash_get_page_size( ) / sizeof( lr1_mac_nvm_journal_entry_t );
+}
+
+static uint32_t lr1mac_core_context_journal_offset( lr1_stack_mac_t* lr1_mac_obj, uint16_t index )
+{
+    // One flash page of journal per stack
+    return ( ( uint32_t ) lr1_mac_obj->stack_id * smtc_modem_hal_flash_get_page_size( ) ) +
+           ( ( uint32_t ) index * sizeof( lr1_mac_nvm_journal_entry_t ) );
+}
+
+static void lr1mac_core_context_journal_replay( lr1_stack_mac_t* lr1_mac_obj )
+{
+    lr1_mac_nvm_journal_entry_t entry    = { 0 };
+    uint16_t                    capacity = lr1mac_core_context_journal_capacity( );
+
+    lr1_mac_obj->nvm_journal_index = capacity;
+
+    for( uint16_t i = 0; i < capacity; i++ )
+    {
+        smtc_modem_hal_context_restore( CONTEXT_LORAWAN_STACK_JOURNAL,
+                                        lr1mac_core_context_journal_offset( lr1_mac_obj, i ), ( uint8_t* ) &entry,
+                                        sizeof( entry ) );
+
+        // Records are appended in order, the first erased one is the end of the journal
+        bool     is_erased = true;
+        uint8_t* raw       = ( uint8_t* ) &entry;
+        for( uint8_t j = 0; j < sizeof( entry ); j++ )
+        {
+            if( raw[j] != 0xFF )
+            {
+                is_erased = false;
+                break;
+            }
+        }
+        if( is_erased == true )
+        {
+            lr1_mac_obj->nvm_journal_index = i;
+            break;
+        }
+
+        // A record with a wrong crc has been torn by a reset during its programming and is skipped
+        if( ( lr1mac_utilities_crc( ( uint8_t* ) &entry, sizeof( entry ) - sizeof( entry.crc ) ) == entry.crc ) &&
+            ( entry.base_crc == lr1_mac_obj->nvm_journal_base_crc ) )
+        {
+            lr1_mac_obj->dev_nonce = entry.devnonce;
+            memcpy( lr1_mac_obj->join_nonce, entry.join_nonce, sizeof( lr1_mac_obj->join_nonce ) );
+        }
+    }
+    SMTC_MODEM_HAL_TRACE_PRINTF( "NVM journal: %d record(s), DevNonce = %d\n", lr1_mac_obj->nvm_journal_index,
+                                 lr1_mac_obj->dev_nonce );
+}
+
+static void lr1mac_core_context_journal_erase( lr1_stack_mac_t* lr1_mac_obj )
+{
+    smtc_modem_hal_context_flash_pages_erase( CONTEXT_LORAWAN_STACK_JOURNAL,
+                                              lr1mac_core_context_journal_offset( lr1_mac_obj, 0 ), 1 );
+    lr1_mac_obj->nvm_journal_index = 0;
+}
+#endif
+
 /* --- EOF ------------------------------------------------------------------ */
@@ -142,6 +142,16 @@ status_lorawan_t lr1mac_core_context_load( lr1_stack_mac_t* lr1_mac_obj );
  */
 void lr1mac_core_context_save( lr1_stack_mac_t* lr1_mac_obj );
 
+/**
+ * @brief Save the DevNonce and JoinNonce of the LoraWAN context in the flash
+ *
+ * @remark When LR1MAC_NVM_JOURNAL is defined, the counters are appended to a journal and the full context is only
+ *         rewritten when the journal is full, otherwise it is equivalent to lr1mac_core_context_save
+ *
+ * @param lr1_mac_obj
+ */
+void lr1mac_core_context_counters_save( lr1_stack_mac_t* lr1_mac_obj );
+
 /**
  * @brief Reload the factory Config in the LoraWAN Stack
  *
@@ -251,6 +261,18 @@ join_status_t lr1_mac_joined_status_get( lr1_stack_mac_t* lr1_mac_obj );
  * \param [OUT] return
  */
 
+/**
+ * @brief Get the stack-owned buffer where the FRMPayload of the next uplink will be located
+ *
+ * @remark A payload written in this buffer and then given to lr1mac_core_payload_send (with an FPort other than 0)
+ *         is encrypted in place without being copied. The buffer is only valid while the stack is idle and until the
+ *         next call to lr1mac_core_payload_send.
+ *
+ * @param lr1_mac_obj
+ * @return uint8_t* Buffer pointer, NULL if the stack is not idle
+ */
+uint8_t* lr1mac_core_payload_buffer_get( lr1_stack_mac_t* lr1_mac_obj );
+
 /**
  * @brief Send an uplink payload as soon as possible after the target time
  *
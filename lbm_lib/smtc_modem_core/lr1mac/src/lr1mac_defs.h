@@ -304,9 +304,33 @@ typedef enum dr_strategy_e
     MOBILE_LOWPER_DR_DISTRIBUTION,     // for Mobile Devices with strong Low power requirement
     USER_DR_DISTRIBUTION,              // User distribution
     JOIN_DR_DISTRIBUTION,              // Dedicated for Join requests
+    MOBILE_LINK_ADAPTIVE_DR,           // for Mobile Devices, datarate and power chosen from the recent link margin
     UNKNOWN_DR,
 } dr_strategy_t;
 
+// NbTrans repetitions of a same frame are spread in frequency and time
+#define LR1MAC_NB_TRANS_FREQ_HISTORY_SIZE 4
+#define LR1MAC_NB_TRANS_CHANNEL_DRAW_MAX 8            // channel draws to find the most diverse frequency
+#define LR1MAC_NB_TRANS_SUBBAND_SPACING_HZ 1600000UL  // 8 x 200kHz channels
+#define LR1MAC_NB_TRANS_GAP_MIN_MS 300
+#define LR1MAC_NB_TRANS_GAP_JITTER_MS 2700
+
+// Channel access (LBT / CAD) statistics use when a listen finds the channel busy
+#define LR1MAC_CH_ACCESS_CHANNEL_DRAW_MAX 4    // channel draws to avoid a chronically busy channel
+#define LR1MAC_CH_ACCESS_BACK_OFF_MAX_MS 1000  // random delay before the next listen, scaled by the busy ratio
+
+// Link history used by the MOBILE_LINK_ADAPTIVE_DR strategy
+#define LR1MAC_LINK_HISTORY_SIZE 8
+#define LR1MAC_LINK_HISTORY_MAX_AGE_S 900     // older samples are not representative of a mobile device link
+#define LR1MAC_LINK_HISTORY_MIN_SAMPLES 2     // fewer fresh samples fall back to the long range distribution
+#define LR1MAC_LINK_ADAPTIVE_TARGET_MARGIN_DB 10  // margin kept above the demodulation floor against fading
+
+typedef struct lr1mac_link_sample_s
+{
+    uint32_t timestamp_s;
+    int8_t   snr_db;  // link SNR normalized to a 125 kHz noise bandwidth
+} lr1mac_link_sample_t;
+
 typedef enum status_lorawan_e
 {
     ERRORLORAWAN = -1,
@@ -385,12 +409,11 @@ typedef enum rx_session_type_e
 {
     RX_SESSION_UNICAST,
 #if defined( SMTC_MULTICAST )
-    RX_SESSION_MULTICAST_G0,
-    RX_SESSION_MULTICAST_G1,
-    RX_SESSION_MULTICAST_G2,
-    RX_SESSION_MULTICAST_G3,
-#endif
+    RX_SESSION_MULTICAST_G0,  // Multicast group N session is RX_SESSION_MULTICAST_G0 + N
+    RX_SESSION_COUNT = RX_SESSION_MULTICAST_G0 + SMTC_MULTICAST_NB_GROUPS,
+#else
     RX_SESSION_COUNT,
+#endif
 } rx_session_type_t;
 
 typedef enum user_mac_req_status_e
@@ -497,6 +520,21 @@ typedef struct lr1_mac_nvm_context_s
     uint32_t crc;      // !! crc MUST be the last field of the structure !!
 } lr1_mac_nvm_context_t;
 
+/**
+ * @brief Journal record appended after each DevNonce / JoinNonce update
+ *
+ * @remark Only records whose base_crc matches the crc of the stored lr1_mac_nvm_context_t are replayed, a record
+ *         written before the last full context save is thus ignored. Size is a multiple of 8 bytes to match
+ *         flash double-word programming.
+ */
+typedef struct lr1_mac_nvm_journal_entry_s
+{
+    uint16_t devnonce;
+    uint8_t  join_nonce[6];
+    uint32_t base_crc;  // crc of the full context this record applies on
+    uint32_t crc;       // !! crc MUST be the last field of the structure !!
+} lr1_mac_nvm_journal_entry_t;
+
 typedef enum cf_list_type
 {
     CF_LIST_FREQ = 0,
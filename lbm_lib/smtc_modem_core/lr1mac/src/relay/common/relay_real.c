@@ -323,7 +323,7 @@ static status_lorawan_t region_eu_868_relay_get_default( uint8_t idx, uint8_t* d
 status_lorawan_t smtc_relay_get_default_channel_config( smtc_real_t* real, const uint8_t idx, uint8_t* datarate,
                                                         uint32_t* freq_wor, uint32_t* freq_ack )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_EU_868 )
     case SMTC_REAL_REGION_EU_868: {
@@ -339,8 +339,8 @@ status_lorawan_t smtc_relay_get_default_channel_config( smtc_real_t* real, const
 #endif
     {
         const status_lorawan_t status = region_as_923_relay_get_default( idx, datarate, freq_wor, freq_ack );
-        *freq_wor += real->real_const.const_frequency_offset_hz;
-        *freq_ack += real->real_const.const_frequency_offset_hz;
+        *freq_wor += SMTC_REAL_CONST( real ).const_frequency_offset_hz;
+        *freq_ack += SMTC_REAL_CONST( real ).const_frequency_offset_hz;
         return status;
     }
 #endif
@@ -0,0 +1,201 @@
+/*!
+ * \file      smtc_ch_access_stats.c
+ *
+ * \brief     Channel access (LBT / CAD) statistics
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+#include <string.h>   // memset
+
+#include "smtc_ch_access_stats.h"
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE CONSTANTS -------------------------------------------------------
+ */
+
+#define BUSY_RATIO_SHIFT ( 3 )  // Busy ratio moving average weight: 1/8 per listen
+#define NOISE_SHIFT ( 2 )       // Noise floor moving average weight: 1/4 per measurement
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
+ */
+
+/**
+ * @brief Find a tracked channel
+ *
+ * @param [in] stats   pointer to the statistics
+ * @param [in] freq_hz frequency
+ * @param [in] create  track the channel if not already done
+ * @return smtc_ch_access_channel_stats_t* NULL if the channel is not tracked and not created
+ */
+static smtc_ch_access_channel_stats_t* smtc_ch_access_stats_find( smtc_ch_access_stats_t* stats, uint32_t freq_hz,
+                                                                  bool create );
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
+ */
+
+void smtc_ch_access_stats_reset( smtc_ch_access_stats_t* stats )
+{
+    memset( stats, 0, sizeof( smtc_ch_access_stats_t ) );
+}
+
+void smtc_ch_access_stats_add_listen( smtc_ch_access_stats_t* stats, uint32_t freq_hz, bool is_busy )
+{
+    smtc_ch_access_channel_stats_t* channel = smtc_ch_access_stats_find( stats, freq_hz, true );
+
+    int32_t target_q8 = ( is_busy == true ) ? ( 100 << 8 ) : 0;
+    if( channel->nb_listen == 0 )
+    {
+        channel->busy_ratio_q8 = ( uint16_t ) target_q8;
+    }
+    else
+    {
+        channel->busy_ratio_q8 =
+            ( uint16_t ) ( channel->busy_ratio_q8 + ( ( target_q8 - channel->busy_ratio_q8 ) >> BUSY_RATIO_SHIFT ) );
+    }
+
+    if( channel->nb_listen < UINT16_MAX )
+    {
+        channel->nb_listen++;
+        if( is_busy == true )
+        {
+            channel->nb_busy++;
+        }
+    }
+}
+
+void smtc_ch_access_stats_add_noise( smtc_ch_access_stats_t* stats, uint32_t freq_hz, int16_t rssi_dbm )
+{
+    smtc_ch_access_channel_stats_t* channel = smtc_ch_access_stats_find( stats, freq_hz, true );
+
+    if( channel->noise_floor_dbm == SMTC_CH_ACCESS_STATS_NOISE_UNKNOWN )
+    {
+        channel->noise_floor_dbm = rssi_dbm;
+    }
+    else
+    {
+        channel->noise_floor_dbm += ( rssi_dbm - channel->noise_floor_dbm ) / ( 1 << NOISE_SHIFT );
+    }
+}
+
+uint8_t smtc_ch_access_stats_get_busy_ratio( smtc_ch_access_stats_t* stats, uint32_t freq_hz )
+{
+    smtc_ch_access_channel_stats_t* channel = smtc_ch_access_stats_find( stats, freq_hz, false );
+
+    if( channel == NULL )
+    {
+        return 0;
+    }
+    return ( uint8_t ) ( channel->busy_ratio_q8 >> 8 );
+}
+
+bool smtc_ch_access_stats_skip( smtc_ch_access_stats_t* stats, uint32_t freq_hz )
+{
+    smtc_ch_access_channel_stats_t* channel = smtc_ch_access_stats_find( stats, freq_hz, false );
+
+    if( ( channel == NULL ) || ( channel->nb_listen < SMTC_CH_ACCESS_STATS_MIN_LISTEN ) ||
+        ( ( channel->busy_ratio_q8 >> 8 ) < SMTC_CH_ACCESS_STATS_CONGESTED_PCT ) )
+    {
+        return false;
+    }
+    channel->busy_ratio_q8 -= channel->busy_ratio_q8 >> BUSY_RATIO_SHIFT;
+    return true;
+}
+
+uint8_t smtc_ch_access_stats_get_back_off_max( smtc_ch_access_stats_t* stats, uint32_t freq_hz, uint8_t nb_bo_max )
+{
+    smtc_ch_access_channel_stats_t* channel = smtc_ch_access_stats_find( stats, freq_hz, false );
+
+    if( ( channel == NULL ) || ( channel->nb_listen < SMTC_CH_ACCESS_STATS_MIN_LISTEN ) )
+    {
+        return nb_bo_max;
+    }
+    uint32_t scaled = ( ( uint32_t ) nb_bo_max * channel->busy_ratio_q8 + ( ( 100 << 8 ) - 1 ) ) / ( 100 << 8 );
+    return ( scaled > 0 ) ? ( uint8_t ) scaled : 1;
+}
+
+bool smtc_ch_access_stats_get( smtc_ch_access_stats_t* stats, uint8_t index,
+                               smtc_ch_access_channel_stats_t* channel_stats )
+{
+    if( index >= stats->nb_channel )
+    {
+        return false;
+    }
+    *channel_stats = stats->channels[index];
+    return true;
+}
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
+
+static smtc_ch_access_channel_stats_t* smtc_ch_access_stats_find( smtc_ch_access_stats_t* stats, uint32_t freq_hz,
+                                                                  bool create )
+{
+    for( uint8_t i = 0; i < stats->nb_channel; i++ )
+    {
+        if( stats->channels[i].freq_hz == freq_hz )
+        {
+            return &stats->channels[i];
+        }
+    }
+    if( create == false )
+    {
+        return NULL;
+    }
+
+    smtc_ch_access_channel_stats_t* channel;
+    if( stats->nb_channel < SMTC_CH_ACCESS_STATS_NB_CHANNEL )
+    {
+        channel = &stats->channels[stats->nb_channel++];
+    }
+    else
+    {
+        channel              = &stats->channels[stats->next_replaced];
+        stats->next_replaced = ( stats->next_replaced + 1 ) % SMTC_CH_ACCESS_STATS_NB_CHANNEL;
+    }
+    memset( channel, 0, sizeof( smtc_ch_access_channel_stats_t ) );
+    channel->freq_hz         = freq_hz;
+    channel->noise_floor_dbm = SMTC_CH_ACCESS_STATS_NOISE_UNKNOWN;
+    return channel;
+}
+
+/* --- EOF ------------------------------------------------------------------ */
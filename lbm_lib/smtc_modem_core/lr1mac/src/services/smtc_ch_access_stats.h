@@ -0,0 +1,158 @@
+/*!
+ * \file      smtc_ch_access_stats.h
+ *
+ * \brief     Channel access (LBT / CAD) statistics
+ *
+ * The Clear BSD License
+ * Copyright Semtech Corporation 2021. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted (subject to the limitations in the disclaimer
+ * below) provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the Semtech corporation nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * NO EXPRESS OR IMPLIED LICENSES TO ANY PARTY'S PATENT RIGHTS ARE GRANTED BY
+ * THIS LICENSE. THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+ * NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SEMTECH CORPORATION BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __SMTC_CH_ACCESS_STATS_H__
+#define __SMTC_CH_ACCESS_STATS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- DEPENDENCIES ------------------------------------------------------------
+ */
+
+#include <stdint.h>   // C99 types
+#include <stdbool.h>  // bool type
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC CONSTANTS --------------------------------------------------------
+ */
+// clang-format off
+#define SMTC_CH_ACCESS_STATS_NB_CHANNEL         ( 16 )         // Number of channels tracked
+#define SMTC_CH_ACCESS_STATS_CONGESTED_PCT      ( 75 )         // Busy ratio above which a channel is skipped
+#define SMTC_CH_ACCESS_STATS_MIN_LISTEN         ( 4 )          // Listens required before trusting the busy ratio
+#define SMTC_CH_ACCESS_STATS_NOISE_UNKNOWN      ( INT16_MIN )  // No noise floor measured yet
+// clang-format on
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC TYPES ------------------------------------------------------------
+ */
+typedef struct smtc_ch_access_channel_stats_s
+{
+    uint32_t freq_hz;
+    uint16_t nb_listen;         // Number of listen (LBT or CAD) done on this channel
+    uint16_t nb_busy;           // Number of listen that found the channel busy
+    uint16_t busy_ratio_q8;     // Moving average of the busy outcome, in percent << 8
+    int16_t  noise_floor_dbm;   // Moving average of the rssi measured on free listen
+} smtc_ch_access_channel_stats_t;
+
+typedef struct smtc_ch_access_stats_s
+{
+    smtc_ch_access_channel_stats_t channels[SMTC_CH_ACCESS_STATS_NB_CHANNEL];
+    uint8_t                        nb_channel;
+    uint8_t                        next_replaced;  // Round robin replacement when a new channel is not tracked yet
+} smtc_ch_access_stats_t;
+
+/*
+ * -----------------------------------------------------------------------------
+ * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
+ */
+
+/**
+ * @brief Reset all the channel access statistics
+ *
+ * @param [in] stats pointer to the statistics
+ */
+void smtc_ch_access_stats_reset( smtc_ch_access_stats_t* stats );
+
+/**
+ * @brief Add the outcome of a listen on a channel
+ *
+ * @param [in] stats   pointer to the statistics
+ * @param [in] freq_hz listened frequency
+ * @param [in] is_busy true if the channel was found busy
+ */
+void smtc_ch_access_stats_add_listen( smtc_ch_access_stats_t* stats, uint32_t freq_hz, bool is_busy );
+
+/**
+ * @brief Add a noise measurement done on a free channel
+ *
+ * @param [in] stats    pointer to the statistics
+ * @param [in] freq_hz  listened frequency
+ * @param [in] rssi_dbm mean rssi measured during the listen
+ */
+void smtc_ch_access_stats_add_noise( smtc_ch_access_stats_t* stats, uint32_t freq_hz, int16_t rssi_dbm );
+
+/**
+ * @brief Get the busy ratio of a channel
+ *
+ * @param [in] stats   pointer to the statistics
+ * @param [in] freq_hz frequency
+ * @return uint8_t     busy ratio in percent, 0 if the channel has never been listened
+ */
+uint8_t smtc_ch_access_stats_get_busy_ratio( smtc_ch_access_stats_t* stats, uint32_t freq_hz );
+
+/**
+ * @brief Check if a channel is chronically busy and should be skipped
+ *
+ * @remark A skipped channel is not listened anymore, so each call returning true also ages its busy ratio toward free
+ *         to listen it again after a few skips
+ *
+ * @param [in] stats   pointer to the statistics
+ * @param [in] freq_hz frequency
+ * @return true if enough listens found the channel busy to avoid it
+ */
+bool smtc_ch_access_stats_skip( smtc_ch_access_stats_t* stats, uint32_t freq_hz );
+
+/**
+ * @brief Scale a maximum number of back-off with the busy ratio of a channel
+ *
+ * @param [in] stats     pointer to the statistics
+ * @param [in] freq_hz   frequency
+ * @param [in] nb_bo_max configured maximum number of back-off
+ * @return uint8_t       maximum number of back-off to draw in, nb_bo_max as long as the channel is not known enough
+ */
+uint8_t smtc_ch_access_stats_get_back_off_max( smtc_ch_access_stats_t* stats, uint32_t freq_hz, uint8_t nb_bo_max );
+
+/**
+ * @brief Get the statistics of the n-th tracked channel
+ *
+ * @param [in]  stats         pointer to the statistics
+ * @param [in]  index         index of the tracked channel
+ * @param [out] channel_stats statistics of this channel
+ * @return false if index is greater or equal to the number of tracked channels
+ */
+bool smtc_ch_access_stats_get( smtc_ch_access_stats_t* stats, uint8_t index,
+                               smtc_ch_access_channel_stats_t* channel_stats );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __SMTC_CH_ACCESS_STATS_H__
+
+/* --- EOF ------------------------------------------------------------------ */
@@ -91,33 +91,23 @@ static struct
 static bool smtc_duty_cycle_get_band( smtc_dtc_t* dtc_obj, uint32_t freq_hz, uint8_t* band_out );
 
 /**
- * @brief Get the consumed Time On Air on a band
+ * @brief Remove from the band ring and sum the events older than one period
  *
- * @param dtc_obj                   Contains the duty cycle context
- * @param band                      Band requested
- * @return uint32_t                 Return the consumed Time On Air
- */
-static uint32_t smtc_duty_cycle_get_band_consumed_time_ms( smtc_dtc_t* dtc_obj, uint8_t band );
-
-/**
- * @brief Compute Index in array of TOA with the a given timestamp in millisecond
- *
- * @param timestamp_ms              Timestamp ms
- * @param idx_previous              the previous index to manage wrapping
- * @return uint8_t                  Return the corresponding index
+ * @param band_obj                  Band context
+ * @param rtc_ms                    RTC ms
  */
-static inline uint8_t smtc_duty_cycle_compute_index( uint32_t timestamp_ms, uint8_t idx_previous );
+static void smtc_duty_cycle_band_expire( smtc_dtc_band_t* band_obj, uint32_t rtc_ms );
 
 /**
- * @brief Compute Diff between the two timestamp and manage wrapping
- *
- * @remark the Second parameter is rounded to the begin of an index
+ * @brief Compute the delay before a Time On Air fits in a band
  *
+ * @param band_obj                  Band context, expired events already removed
  * @param rtc_ms                    RTC ms
- * @param timestamp_ms              Timestamp ms
- * @return uint32_t                 Return the time diff
+ * @param toa_ms                    Time On Air requested
+ * @return int32_t                  milliseconds to wait, 0 if it fits now, -1 if it never fits
  */
-static inline uint32_t smtc_duty_cycle_time_diff( uint32_t rtc_ms, uint32_t timestamp_ms );
+static int32_t smtc_duty_cycle_band_get_delay_for_toa_ms( smtc_dtc_band_t* band_obj, uint32_t rtc_ms,
+                                                          uint32_t toa_ms );
 
 /**
  * @brief Put band number in array if not already present
@@ -214,50 +204,43 @@ void smtc_duty_cycle_sum( uint32_t freq_hz, uint32_t toa_ms )
     {
         return;
     }
-    uint8_t idx_previous = dtc_obj_ptr->bands[band].index_previous;
-
-    // compute index by delta to manage rtc_ms wrapping
-    uint32_t timestamp_diff = smtc_duty_cycle_time_diff( rtc_time_now, dtc_obj_ptr->bands[band].toa_timestamp_ms );
-    uint8_t  idx_new        = smtc_duty_cycle_compute_index( timestamp_diff, idx_previous );
+    smtc_dtc_band_t* band_obj = &dtc_obj_ptr->bands[band];
 
-    // Convert TOA to the resolution
-    toa_ms = ( toa_ms < smtc_dtc_resolution_ms ) ? 1
-             : ( smtc_dtc_resolution_ms == 1 )   ? toa_ms
-                                                 : ( toa_ms / smtc_dtc_resolution_ms ) + 1;
+    smtc_duty_cycle_band_expire( band_obj, rtc_time_now );
 
-    // More than SMTC_DTC_PERIOD_MS since the last timestamp
-    if( smtc_duty_cycle_time_diff( rtc_time_now, dtc_obj_ptr->bands[band].toa_timestamp_ms ) >= SMTC_DTC_PERIOD_MS )
-    {
-        // Erase band cumulated TOA
-        memset( dtc_obj_ptr->bands[band].toa_sum_ms, 0, sizeof( dtc_obj_ptr->bands[band].toa_sum_ms ) );
-    }
-    else
+    if( band_obj->event_cnt == SMTC_DTC_EVENTS_MAX )
     {
-        // If we are on the same index since less than the time of one unit
-        if( ( idx_new == idx_previous ) && ( timestamp_diff < ( SMTC_DTC_SECONDS_BY_UNIT * 1000 ) ) )
-        {
-            // Sum TOA in same buffer
-            toa_ms += dtc_obj_ptr->bands[band].toa_sum_ms[idx_new];
-        }
-        else
+        // Ring full: merge the two closest adjacent events in the later one, the TOA of the earlier one is then
+        // released at most the gap between them late
+        uint8_t  merge_idx  = 0;
+        uint32_t gap_min_ms = UINT32_MAX;
+        for( uint8_t i = 0; i < ( SMTC_DTC_EVENTS_MAX - 1 ); i++ )
         {
-            // Erase obsolete data between last saved and the current
-            uint8_t i = idx_previous;
-            while( i != idx_new )
+            uint32_t gap_ms = band_obj->events[( band_obj->event_first + i + 1 ) % SMTC_DTC_EVENTS_MAX].timestamp_ms -
+                              band_obj->events[( band_obj->event_first + i ) % SMTC_DTC_EVENTS_MAX].timestamp_ms;
+            if( gap_ms < gap_min_ms )
             {
-                i++;
-                if( i >= SMTC_DTC_TOA_BUFF_SIZE )
-                {
-                    i = 0;
-                }
-                dtc_obj_ptr->bands[band].toa_sum_ms[i] = 0;
+                gap_min_ms = gap_ms;
+                merge_idx  = i;
             }
         }
+        band_obj->events[( band_obj->event_first + merge_idx + 1 ) % SMTC_DTC_EVENTS_MAX].toa_ms +=
+            band_obj->events[( band_obj->event_first + merge_idx ) % SMTC_DTC_EVENTS_MAX].toa_ms;
+        // Shift the older events in the freed entry, the ring starts one entry later
+        for( uint8_t i = merge_idx; i > 0; i-- )
+        {
+            band_obj->events[( band_obj->event_first + i ) % SMTC_DTC_EVENTS_MAX] =
+                band_obj->events[( band_obj->event_first + i - 1 ) % SMTC_DTC_EVENTS_MAX];
+        }
+        band_obj->event_first = ( band_obj->event_first + 1 ) % SMTC_DTC_EVENTS_MAX;
+        band_obj->event_cnt--;
     }
-    // Save the new TOA
-    dtc_obj_ptr->bands[band].toa_sum_ms[idx_new] = toa_ms;
-    dtc_obj_ptr->bands[band].toa_timestamp_ms    = rtc_time_now;
-    dtc_obj_ptr->bands[band].index_previous      = idx_new;
+
+    smtc_dtc_event_t* event = &band_obj->events[( band_obj->event_first + band_obj->event_cnt ) % SMTC_DTC_EVENTS_MAX];
+    event->timestamp_ms     = rtc_time_now;
+    event->toa_ms           = toa_ms;
+    band_obj->event_cnt++;
+    band_obj->toa_sum_ms += toa_ms;
 }
 
 void smtc_duty_cycle_update( void )
@@ -274,38 +257,7 @@ void smtc_duty_cycle_update( void )
 
     for( uint8_t band = 0; band < dtc_obj_ptr->number_of_bands; band++ )
     {
-        uint8_t idx_previous = dtc_obj_ptr->bands[band].index_previous;
-        // compute index by delta to manage rtc_ms wrapping
-        uint32_t timestamp_diff = smtc_duty_cycle_time_diff( rtc_time_now, dtc_obj_ptr->bands[band].toa_timestamp_ms );
-        uint8_t  idx_new        = smtc_duty_cycle_compute_index( timestamp_diff, idx_previous );
-
-        // More than SMTC_DTC_PERIOD_MS since the last timestamp
-        if( smtc_duty_cycle_time_diff( rtc_time_now, dtc_obj_ptr->bands[band].toa_timestamp_ms ) >= SMTC_DTC_PERIOD_MS )
-        {
-            // Erase band cumulated TOA, it's been over 1h
-            memset( dtc_obj_ptr->bands[band].toa_sum_ms, 0, sizeof( dtc_obj_ptr->bands[band].toa_sum_ms ) );
-            dtc_obj_ptr->bands[band].toa_timestamp_ms = rtc_time_now;
-            dtc_obj_ptr->bands[band].index_previous   = idx_new;
-        }
-        else
-        {
-            // Erase obsolete data between last saved and the current
-            uint8_t i = idx_previous;
-            while( i != idx_new )
-            {
-                i++;
-                if( i >= SMTC_DTC_TOA_BUFF_SIZE )
-                {
-                    i = 0;
-                }
-                // If equal do not erase the TOA
-                if( ( i != idx_new ) ||
-                    ( ( i == idx_new ) && ( timestamp_diff >= ( SMTC_DTC_SECONDS_BY_UNIT * 1000 ) ) ) )
-                {
-                    dtc_obj_ptr->bands[band].toa_sum_ms[i] = 0;
-                }
-            }
-        }
+        smtc_duty_cycle_band_expire( &dtc_obj_ptr->bands[band], rtc_time_now );
     }
 }
 
@@ -325,9 +277,7 @@ bool smtc_duty_cycle_is_toa_accepted( smtc_dtc_t* dtc_obj, uint32_t freq_hz, uin
     {
         return true;
     }
-    uint32_t toa_consummed  = smtc_duty_cycle_get_band_consumed_time_ms( dtc_obj, band );
-    uint16_t duty_cycle     = dtc_obj->bands[band].duty_cycle_regulation;
-    int32_t  remaining_time = ( int32_t ) ( ( SMTC_DTC_PERIOD_MS / duty_cycle ) - toa_consummed );
+    int32_t remaining_time = smtc_duty_cycle_band_get_available_toa_ms( dtc_obj, band );
 
     if( remaining_time < 0 )
     {
@@ -354,9 +304,8 @@ int32_t smtc_duty_cycle_band_get_available_toa_ms( smtc_dtc_t* dtc_obj, uint8_t
         return true;
     }
 
-    uint32_t toa_consummed = smtc_duty_cycle_get_band_consumed_time_ms( dtc_obj, band );
-    uint16_t duty_cycle    = dtc_obj->bands[band].duty_cycle_regulation;
-    int32_t  toa           = ( int32_t ) ( ( SMTC_DTC_PERIOD_MS / duty_cycle ) - toa_consummed );
+    uint16_t duty_cycle = dtc_obj->bands[band].duty_cycle_regulation;
+    int32_t  toa        = ( int32_t ) ( SMTC_DTC_PERIOD_MS / duty_cycle ) - ( int32_t ) dtc_obj->bands[band].toa_sum_ms;
 
     return toa;
 }
@@ -385,6 +334,23 @@ bool smtc_duty_cycle_is_channel_free( uint32_t freq_hz )
     return false;
 }
 
+bool smtc_duty_cycle_is_same_band( uint32_t freq1_hz, uint32_t freq2_hz )
+{
+    if( ( dtc_obj_ptr == NULL ) || ( dtc_obj_ptr->number_of_bands == 0 ) )
+    {
+        return false;
+    }
+
+    uint8_t band1;
+    uint8_t band2;
+    if( ( smtc_duty_cycle_get_band( dtc_obj_ptr, freq1_hz, &band1 ) == false ) ||
+        ( smtc_duty_cycle_get_band( dtc_obj_ptr, freq2_hz, &band2 ) == false ) )
+    {
+        return false;
+    }
+    return ( band1 == band2 );
+}
+
 bool smtc_duty_cycle_is_band_free( smtc_dtc_t* dtc_obj, uint8_t band )
 {
     if( dtc_obj_ptr == NULL )
@@ -403,6 +369,66 @@ bool smtc_duty_cycle_is_band_free( smtc_dtc_t* dtc_obj, uint8_t band )
     return false;
 }
 
+uint8_t smtc_duty_cycle_draw_channel( const uint32_t* freq_list, uint8_t number_of_freq )
+{
+    if( ( dtc_obj_ptr == NULL ) || ( dtc_obj_ptr->number_of_bands == 0 ) ||
+        ( dtc_obj_ptr->enabled == SMTC_DTC_FULL_DISABLED ) )
+    {
+        return smtc_modem_hal_get_random_nb_in_range( 0, number_of_freq - 1 ) % number_of_freq;
+    }
+
+    uint8_t  band_channel_cnt[SMTC_DTC_BANDS_MAX] = { 0 };
+    uint32_t band_weight[SMTC_DTC_BANDS_MAX]      = { 0 };
+    uint32_t total_weight                         = 0;
+
+    for( uint8_t i = 0; i < number_of_freq; i++ )
+    {
+        uint8_t band;
+        if( smtc_duty_cycle_get_band( dtc_obj_ptr, freq_list[i], &band ) == false )
+        {
+            // Not covered by the regulation: nothing to balance
+            return smtc_modem_hal_get_random_nb_in_range( 0, number_of_freq - 1 ) % number_of_freq;
+        }
+        band_channel_cnt[band]++;
+    }
+    for( uint8_t band = 0; band < dtc_obj_ptr->number_of_bands; band++ )
+    {
+        if( band_channel_cnt[band] > 0 )
+        {
+            uint32_t toa_max_ms = SMTC_DTC_PERIOD_MS / dtc_obj_ptr->bands[band].duty_cycle_regulation;
+            uint32_t toa_sum_ms = dtc_obj_ptr->bands[band].toa_sum_ms;
+            // 1ms minimum so that an exhausted band is still eligible when the regulation is not enforced
+            band_weight[band] = ( toa_sum_ms < toa_max_ms ) ? ( toa_max_ms - toa_sum_ms ) : 1;
+            total_weight += band_weight[band];
+        }
+    }
+
+    uint32_t draw = smtc_modem_hal_get_random_nb_in_range( 0, total_weight - 1 ) % total_weight;
+    uint8_t  band = 0;
+    while( ( band_channel_cnt[band] == 0 ) || ( draw >= band_weight[band] ) )
+    {
+        draw -= band_weight[band];
+        band++;
+    }
+
+    uint8_t channel_rank =
+        smtc_modem_hal_get_random_nb_in_range( 0, band_channel_cnt[band] - 1 ) % band_channel_cnt[band];
+    for( uint8_t i = 0; i < number_of_freq; i++ )
+    {
+        uint8_t channel_band;
+        smtc_duty_cycle_get_band( dtc_obj_ptr, freq_list[i], &channel_band );
+        if( channel_band == band )
+        {
+            if( channel_rank == 0 )
+            {
+                return i;
+            }
+            channel_rank--;
+        }
+    }
+    return 0;  // never reached, the drawn band has channel_rank + 1 channels
+}
+
 int32_t smtc_duty_cycle_get_next_free_time_ms( uint8_t number_of_tx_freq, uint32_t* tx_freq_list )
 {
     if( dtc_obj_ptr == NULL )
@@ -469,51 +495,16 @@ int32_t smtc_duty_cycle_get_next_free_time_ms( uint8_t number_of_tx_freq, uint32
     }
     else
     {
-        // All bands reached the max available TOA, search for the next nearest TOA available slot
-        uint32_t next_available_slot_ms_tmp = ~0;
+        // All bands reached the max available TOA, search for the first band that frees some time: a band is free
+        // as soon as 1ms of TOA is available
+        int32_t  next_available_slot_ms_tmp = ( int32_t ) SMTC_DTC_PERIOD_MS;
         uint32_t rtc_time_now               = smtc_modem_hal_get_time_in_ms( );
 
         for( uint8_t j = 0; j < tmp_band_dtc_full_index; j++ )
         {
-            uint8_t band = tmp_band_dtc_full[j];
-
-            uint8_t idx_previous = dtc_obj_ptr->bands[band].index_previous;
-            // compute index by delta to manage rtc_ms wrapping
-            uint32_t timestamp_diff =
-                smtc_duty_cycle_time_diff( rtc_time_now, dtc_obj_ptr->bands[band].toa_timestamp_ms );
-            uint8_t idx_new = smtc_duty_cycle_compute_index( timestamp_diff, idx_previous );
-
-            // compute time between now and the end of this index
-            uint32_t next_available_slot_ms =
-                ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) - ( rtc_time_now % ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) );
-
-            uint8_t idx_empty_counter = 0;
-
-            uint8_t i = idx_new;
-            do
-            {
-                i++;
-                if( i >= SMTC_DTC_TOA_BUFF_SIZE )
-                {
-                    i = 0;
-                }
-                if( dtc_obj_ptr->bands[band].toa_sum_ms[i] != 0 )
-                {
-                    break;
-                }
-                if( i != idx_previous )
-                {
-                    idx_empty_counter++;
-                }
-
-                if( idx_empty_counter > SMTC_DTC_TOA_BUFF_SIZE )
-                {
-                    SMTC_MODEM_HAL_PANIC( );
-                }
-            } while( i != idx_previous );
-
-            next_available_slot_ms += idx_empty_counter * SMTC_DTC_SECONDS_BY_UNIT * 1000UL;
-            if( next_available_slot_ms_tmp > next_available_slot_ms )
+            int32_t next_available_slot_ms =
+                smtc_duty_cycle_band_get_delay_for_toa_ms( &dtc_obj_ptr->bands[tmp_band_dtc_full[j]], rtc_time_now, 1 );
+            if( ( next_available_slot_ms >= 0 ) && ( next_available_slot_ms_tmp > next_available_slot_ms ) )
             {
                 next_available_slot_ms_tmp = next_available_slot_ms;
             }
@@ -542,33 +533,49 @@ static bool smtc_duty_cycle_get_band( smtc_dtc_t* dtc_obj, uint32_t freq_hz, uin
     return false;
 }
 
-static uint32_t smtc_duty_cycle_get_band_consumed_time_ms( smtc_dtc_t* dtc_obj, uint8_t band )
+static void smtc_duty_cycle_band_expire( smtc_dtc_band_t* band_obj, uint32_t rtc_ms )
 {
-    uint32_t toa_ms = 0;
-    for( uint8_t i = 0; i < SMTC_DTC_TOA_BUFF_SIZE; i++ )
+    // Events are ordered by timestamp: stop at the first one still in the period
+    while( band_obj->event_cnt > 0 )
     {
-        toa_ms += dtc_obj->bands[band].toa_sum_ms[i];
+        smtc_dtc_event_t* event = &band_obj->events[band_obj->event_first];
+        if( ( uint32_t ) ( rtc_ms - event->timestamp_ms ) < SMTC_DTC_PERIOD_MS )
+        {
+            break;
+        }
+        band_obj->toa_sum_ms -= event->toa_ms;
+        band_obj->event_first = ( band_obj->event_first + 1 ) % SMTC_DTC_EVENTS_MAX;
+        band_obj->event_cnt--;
     }
-
-    // Convert to the resolution
-    toa_ms *= smtc_dtc_resolution_ms;
-    return toa_ms;
 }
 
-static inline uint8_t smtc_duty_cycle_compute_index( uint32_t timestamp_ms, uint8_t idx_previous )
+static int32_t smtc_duty_cycle_band_get_delay_for_toa_ms( smtc_dtc_band_t* band_obj, uint32_t rtc_ms,
+                                                          uint32_t toa_ms )
 {
-    uint8_t idx_new =
-        ( ( ( timestamp_ms / 60000UL ) % ( ( ( SMTC_DTC_PERIOD_MS / 1000UL ) + SMTC_DTC_SECONDS_BY_UNIT ) / 60 ) ) /
-          ( SMTC_DTC_SECONDS_BY_UNIT / 60 ) );
+    uint32_t toa_max_ms = SMTC_DTC_PERIOD_MS / band_obj->duty_cycle_regulation;
 
-    idx_new += idx_previous;
-    idx_new %= SMTC_DTC_TOA_BUFF_SIZE;
-    return idx_new;
-}
+    if( toa_ms > toa_max_ms )
+    {
+        return -1;
+    }
+    if( ( band_obj->toa_sum_ms + toa_ms ) <= toa_max_ms )
+    {
+        return 0;
+    }
 
-static inline uint32_t smtc_duty_cycle_time_diff( uint32_t rtc_ms, uint32_t timestamp_ms )
-{
-    return ( rtc_ms - ( timestamp_ms - ( timestamp_ms % ( SMTC_DTC_SECONDS_BY_UNIT * 1000UL ) ) ) );
+    // Release the oldest events until the packet fits
+    uint32_t toa_to_release_ms = band_obj->toa_sum_ms + toa_ms - toa_max_ms;
+    uint32_t toa_released_ms   = 0;
+    for( uint8_t i = 0; i < band_obj->event_cnt; i++ )
+    {
+        smtc_dtc_event_t* event = &band_obj->events[( band_obj->event_first + i ) % SMTC_DTC_EVENTS_MAX];
+        toa_released_ms += event->toa_ms;
+        if( toa_released_ms >= toa_to_release_ms )
+        {
+            return ( int32_t ) ( SMTC_DTC_PERIOD_MS - ( uint32_t ) ( rtc_ms - event->timestamp_ms ) );
+        }
+    }
+    return -1;  // should not happen, the sum is the sum of all events
 }
 
 static void smtc_duty_cycle_put_band_in_array( smtc_dtc_t* dtc_obj, uint8_t* tmp_band, uint8_t band,
@@ -58,21 +58,25 @@ extern "C" {
 // clang-format off
 #define SMTC_DTC_BANDS_MAX          ( 6 )                      // Number of ETSI band supported by this algo
 #define SMTC_DTC_PERIOD_MS          ( 3600000UL )              // Number of miliseconds in one period (3600000 for period 1h)
-#define SMTC_DTC_SECONDS_BY_UNIT    ( 120 )                    // Sum TOA by step of N seconds, MIN VALUE IS 60s to avoid division by 0
-#define SMTC_DTC_TOA_BUFF_SIZE      ( ( SMTC_DTC_PERIOD_MS / 1000UL ) / SMTC_DTC_SECONDS_BY_UNIT )  // Buffer size to sum all TOA over one period
+#ifndef SMTC_DTC_EVENTS_MAX
+#define SMTC_DTC_EVENTS_MAX         ( 16 )                     // Number of transmissions tracked by band over one period
+#endif
 
-#if SMTC_DTC_SECONDS_BY_UNIT < 60
-#warning "SMTC_DTC_SECONDS_BY_UNIT must be greater or equal to 60"
-#undef SMTC_DTC_SECONDS_BY_UNIT
-#define SMTC_DTC_SECONDS_BY_UNIT 60
+#if SMTC_DTC_EVENTS_MAX > 255
+#error "SMTC_DTC_EVENTS_MAX must be lower than 256"
 #endif
 
 //
 // Represention of the current configuration
 //
-// index                       0     1     2                  28    29   0
-// 16bits array to save TOA {[    ][    ][    ][    ...    ][    ][    ][    ]}
-// RTC                       0s    120s  240s  360s         3360s 3480s 3600s
+// Each band keeps the exact transmissions of the last period in a ring and their running sum:
+//
+// events ring  {[ts0,toa0][ts1,toa1] ... [tsN,toaN]}   toa_sum_ms = toa0 + toa1 + ... + toaN
+// RTC           ts0 <= ts1 <= ... <= tsN <= now < ts0 + SMTC_DTC_PERIOD_MS
+//
+// An event leaves the sum exactly SMTC_DTC_PERIOD_MS after its timestamp. When the ring is full, the two closest
+// adjacent events are merged in the later one: the earlier time on air is released later than required by at most
+// the gap between them, never earlier.
 //
 
 // clang-format on
@@ -94,14 +98,21 @@ typedef enum smtc_dtc_enablement_type_e
     SMTC_DTC_FULL_DISABLED    = 2,  // Sending constraint and uplink TOA are NOT take in care
 } smtc_dtc_enablement_type_t;
 
+typedef struct smtc_dtc_event_s
+{
+    uint32_t timestamp_ms;  // rtc when the transmission has been summed
+    uint32_t toa_ms;
+} smtc_dtc_event_t;
+
 typedef struct smtc_dtc_band_s
 {
-    uint32_t freq_min;
-    uint32_t freq_max;
-    uint16_t duty_cycle_regulation;  // 1000->0.1%, 100->1%, 10->10%
-    uint32_t toa_timestamp_ms;       // last access to the array when adding the TOA or reset all TOA
-    uint8_t  index_previous;
-    uint16_t toa_sum_ms[SMTC_DTC_TOA_BUFF_SIZE];  // Store all TOA by step of SMTC_DTC_SECONDS_BY_UNIT
+    uint32_t         freq_min;
+    uint32_t         freq_max;
+    uint16_t         duty_cycle_regulation;  // 1000->0.1%, 100->1%, 10->10%
+    uint32_t         toa_sum_ms;             // Sum of the TOA of all events of the ring
+    uint8_t          event_first;            // Index of the oldest event
+    uint8_t          event_cnt;
+    smtc_dtc_event_t events[SMTC_DTC_EVENTS_MAX];
 } smtc_dtc_band_t;
 
 typedef struct smtc_dtc_s
@@ -111,13 +122,6 @@ typedef struct smtc_dtc_s
     smtc_dtc_band_t            bands[SMTC_DTC_BANDS_MAX];
 } smtc_dtc_t;
 
-/**
- * @brief the resolution is the number of bits per SMTC_DTC_SECONDS_BY_UNIT
- * @remark 16 represents the number of bits to save the TOA
- *          ceil(120s/65536) -> ceil(0.001831055) -> 2ms per bit
- */
-static const uint32_t smtc_dtc_resolution_ms = ( ( ( SMTC_DTC_SECONDS_BY_UNIT * 1000 ) / ( 1 << ( 16 ) ) ) + 1 );
-
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS PROTOTYPES ---------------------------------------------
@@ -209,6 +213,29 @@ int32_t smtc_duty_cycle_band_get_available_toa_ms( smtc_dtc_t* dtc_obj, uint8_t
  */
 bool smtc_duty_cycle_is_channel_free( uint32_t freq_hz );
 
+/**
+ * @brief Check if two frequencies share the same Duty Cycle band
+ *
+ * @param freq1_hz                  First frequency
+ * @param freq2_hz                  Second frequency
+ * @return bool                     false if the duty cycle is not configured or if a frequency is out of all bands
+ */
+bool smtc_duty_cycle_is_same_band( uint32_t freq1_hz, uint32_t freq2_hz );
+
+/**
+ * @brief Draw a channel among a list, weighted by the Time On Air left in the band of each channel
+ *
+ * @remark A band is drawn with a probability proportional to its remaining Time On Air, then a channel uniformly
+ *         inside this band: the load is moved away from the bands close to exhaustion and the long run usage of all
+ *         bands stays even. Without duty cycle context, the draw is uniform.
+ * @remark  smtc_duty_cycle_update() must be called before this function to have a right value
+ *
+ * @param freq_list                 Frequencies of the candidate channels
+ * @param number_of_freq            Number of candidate channels, must be > 0
+ * @return uint8_t                  Index of the drawn channel in freq_list
+ */
+uint8_t smtc_duty_cycle_draw_channel( const uint32_t* freq_list, uint8_t number_of_freq );
+
 /**
  * @brief Check if a band is Duty Cycle free
  *
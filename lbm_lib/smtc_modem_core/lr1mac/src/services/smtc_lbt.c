@@ -65,6 +65,8 @@ void smtc_lbt_init( smtc_lbt_t* lbt_obj, radio_planner_t* rp, uint8_t lbt_id_rp,
     lbt_obj->listen_duration_ms = 0;
     lbt_obj->threshold          = 0;
     lbt_obj->bw_hz              = 0;
+    lbt_obj->freq_hz            = 0;
+    lbt_obj->stats              = NULL;
     rp_release_hook( rp, lbt_id_rp );
     rp_hook_init( rp, lbt_id_rp, ( void ( * )( void* ) )( smtc_lbt_rp_callback ), lbt_obj );
 }
@@ -97,6 +99,11 @@ bool smtc_lbt_get_state( smtc_lbt_t* lbt_obj )
     return lbt_obj->enabled;
 }
 
+void smtc_lbt_set_stats( smtc_lbt_t* lbt_obj, smtc_ch_access_stats_t* stats )
+{
+    lbt_obj->stats = stats;
+}
+
 void smtc_lbt_launch_callback_for_rp( void* rp_void )
 {
     radio_planner_t* rp = ( radio_planner_t* ) rp_void;
@@ -141,7 +148,10 @@ void smtc_lbt_launch_callback_for_rp( void* rp_void )
 void smtc_lbt_listen_channel( smtc_lbt_t* lbt_obj, uint32_t freq, bool is_at_time, uint32_t target_time_ms,
                               uint32_t tx_duration_ms )
 {
-    lbt_obj->is_at_time = is_at_time;
+    lbt_obj->is_at_time      = is_at_time;
+    lbt_obj->freq_hz         = freq;
+    lbt_obj->rssi_accu       = 0;
+    lbt_obj->rssi_nb_of_meas = 0;
     if( ( lbt_obj->free_callback == NULL ) || ( lbt_obj->busy_callback == NULL ) ||
         ( lbt_obj->abort_callback == NULL ) )
     {
@@ -209,6 +219,20 @@ void smtc_lbt_rp_callback( smtc_lbt_t* lbt_obj )
     uint8_t     my_hook_id;
     rp_hook_get_id( lbt_obj->rp, lbt_obj, &my_hook_id );
     rp_get_status( lbt_obj->rp, my_hook_id, &tcurrent_ms, &( rp_status ) );
+
+    if( ( lbt_obj->stats != NULL ) &&
+        ( ( rp_status == RP_STATUS_LBT_FREE_CHANNEL ) || ( rp_status == RP_STATUS_LBT_BUSY_CHANNEL ) ) )
+    {
+        smtc_ch_access_stats_add_listen( lbt_obj->stats, lbt_obj->freq_hz,
+                                         ( rp_status == RP_STATUS_LBT_BUSY_CHANNEL ) ? true : false );
+        // Only a free listen measures the noise floor, a busy one stops on the first sample above the threshold
+        if( ( rp_status == RP_STATUS_LBT_FREE_CHANNEL ) && ( lbt_obj->rssi_nb_of_meas > 0 ) )
+        {
+            smtc_ch_access_stats_add_noise( lbt_obj->stats, lbt_obj->freq_hz,
+                                            ( int16_t ) ( lbt_obj->rssi_accu / ( int32_t ) lbt_obj->rssi_nb_of_meas ) );
+        }
+    }
+
     if( rp_status == RP_STATUS_LBT_FREE_CHANNEL )
     {
         lbt_obj->free_callback( lbt_obj->free_context );
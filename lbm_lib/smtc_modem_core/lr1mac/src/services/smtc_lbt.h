@@ -38,6 +38,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "radio_planner.h"
+#include "smtc_ch_access_stats.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -66,6 +67,9 @@ typedef struct smtc_lbt_s
     int32_t  rssi_accu;
     uint32_t rssi_nb_of_meas;
     bool     enabled;
+    uint32_t freq_hz;  // frequency of the last listen
+
+    smtc_ch_access_stats_t* stats;  // channel access statistics updated after each listen, can be NULL
     /* data */
 } smtc_lbt_t;
 
@@ -125,6 +129,14 @@ void smtc_lbt_set_state( smtc_lbt_t* lbt_obj, bool enable );
  */
 bool smtc_lbt_get_state( smtc_lbt_t* lbt_obj );
 
+/**
+ * @brief Attach the channel access statistics updated by each listen
+ *
+ * @param [in] lbt_obj pointer to lbt_obj itself
+ * @param [in] stats   pointer to the statistics, NULL to stop updating them
+ */
+void smtc_lbt_set_stats( smtc_lbt_t* lbt_obj, smtc_ch_access_stats_t* stats );
+
 /**
  * @brief smtc_lbt_listen_channel this function is called each time who want to listen the channel
  *
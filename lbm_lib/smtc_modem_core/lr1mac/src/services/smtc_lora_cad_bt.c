@@ -198,6 +198,11 @@ bool smtc_lora_cad_bt_get_state( smtc_lora_cad_bt_t* cad_obj )
     return cad_obj->enabled;
 }
 
+void smtc_lora_cad_bt_set_stats( smtc_lora_cad_bt_t* cad_obj, smtc_ch_access_stats_t* stats )
+{
+    cad_obj->stats = stats;
+}
+
 void smtc_lora_cad_bt_listen_channel( smtc_lora_cad_bt_t* cad_obj, uint32_t freq_hz, uint8_t sf,
                                       ral_lora_bw_t bandwidth, bool is_at_time, uint32_t target_time_ms,
                                       uint32_t symbol_duration_us, uint32_t tx_duration_ms,
@@ -210,6 +215,7 @@ void smtc_lora_cad_bt_listen_channel( smtc_lora_cad_bt_t* cad_obj, uint32_t freq
     }
 
     cad_obj->is_at_time = is_at_time;
+    cad_obj->freq_hz    = freq_hz;
     if( ( cad_obj->ch_free_callback == NULL ) || ( cad_obj->ch_busy_callback_update_channel == NULL ) ||
         ( cad_obj->ch_free_callback_on_back_off == NULL ) || ( cad_obj->abort_callback == NULL ) )
     {
@@ -233,7 +239,13 @@ void smtc_lora_cad_bt_listen_channel( smtc_lora_cad_bt_t* cad_obj, uint32_t freq
                 // the nb_bo is not recomputed when different not 0
                 if( cad_obj->nb_bo == 0 )
                 {
-                    cad_obj->nb_bo = smtc_modem_hal_get_random_nb_in_range( 1, cad_obj->nb_bo_max_conf );
+                    // A mostly free channel does not need the full back-off window configured by the user
+                    uint8_t nb_bo_max = cad_obj->nb_bo_max_conf;
+                    if( cad_obj->stats != NULL )
+                    {
+                        nb_bo_max = smtc_ch_access_stats_get_back_off_max( cad_obj->stats, freq_hz, nb_bo_max );
+                    }
+                    cad_obj->nb_bo = smtc_modem_hal_get_random_nb_in_range( 1, nb_bo_max );
                     SMTC_MODEM_HAL_TRACE_PRINTF( "set nb_bo:%d, target_time %u\n", cad_obj->nb_bo, target_time_ms );
                 }
             }
@@ -361,6 +373,13 @@ static void smtc_lora_cad_bt_rp_callback( smtc_lora_cad_bt_t* cad_obj )
 
     cad_obj->is_cad_running = false;
 
+    if( ( cad_obj->stats != NULL ) &&
+        ( ( rp_status == RP_STATUS_CAD_NEGATIVE ) || ( rp_status == RP_STATUS_CAD_POSITIVE ) ) )
+    {
+        smtc_ch_access_stats_add_listen( cad_obj->stats, cad_obj->freq_hz,
+                                         ( rp_status == RP_STATUS_CAD_POSITIVE ) ? true : false );
+    }
+
     if( rp_status == RP_STATUS_CAD_NEGATIVE )
     {
         // SMTC_MODEM_HAL_TRACE_PRINTF( "CAD_NEGATIF\n" );
@@ -43,6 +43,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "radio_planner.h"
+#include "smtc_ch_access_stats.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -101,6 +102,9 @@ typedef struct smtc_lora_cad_bt_s
     uint8_t               max_ch_change_cnt_conf;  // number of try to cad configured by the user
     uint8_t               max_ch_change_cnt;       // number of try to cad
     int8_t                detect_peak_offset;
+    uint32_t              freq_hz;  // frequency of the current listen
+
+    smtc_ch_access_stats_t* stats;  // channel access statistics updated after each cad, can be NULL
 
 } smtc_lora_cad_bt_t;
 
@@ -172,6 +176,14 @@ void smtc_lora_cad_bt_set_state( smtc_lora_cad_bt_t* cad_obj, bool enable );
  */
 bool smtc_lora_cad_bt_get_state( smtc_lora_cad_bt_t* cad_obj );
 
+/**
+ * @brief Attach the channel access statistics updated by each cad and used to scale the back-off
+ *
+ * @param [in] cad_obj pointer to cad_obj itself
+ * @param [in] stats   pointer to the statistics, NULL to stop using them
+ */
+void smtc_lora_cad_bt_set_stats( smtc_lora_cad_bt_t* cad_obj, smtc_ch_access_stats_t* stats );
+
 /**
  * @brief smtc_lora_cad_bt_listen_channel this function is called each time who want to listen LoRa activity on a
  * channel
@@ -62,41 +62,12 @@
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
-typedef struct smtc_multicast_key_s
-{
-    smtc_se_key_identifier_t mc_key;
-    smtc_se_key_identifier_t mc_app_skey;
-    smtc_se_key_identifier_t mc_ntw_skey;
-} smtc_multicast_key_t;
 
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
  */
 
-static const smtc_multicast_key_t smtc_mc_skey_tab[LR1MAC_MC_NUMBER_OF_SESSION] = {
-    {
-        .mc_key      = SMTC_SE_MC_KEY_0,
-        .mc_app_skey = SMTC_SE_MC_APP_S_KEY_0,
-        .mc_ntw_skey = SMTC_SE_MC_NWK_S_KEY_0,
-    },
-    {
-        .mc_key      = SMTC_SE_MC_KEY_1,
-        .mc_app_skey = SMTC_SE_MC_APP_S_KEY_1,
-        .mc_ntw_skey = SMTC_SE_MC_NWK_S_KEY_1,
-    },
-    {
-        .mc_key      = SMTC_SE_MC_KEY_2,
-        .mc_app_skey = SMTC_SE_MC_APP_S_KEY_2,
-        .mc_ntw_skey = SMTC_SE_MC_NWK_S_KEY_2,
-    },
-    {
-        .mc_key      = SMTC_SE_MC_KEY_3,
-        .mc_app_skey = SMTC_SE_MC_APP_S_KEY_3,
-        .mc_ntw_skey = SMTC_SE_MC_NWK_S_KEY_3,
-    },
-};
-
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
@@ -117,8 +88,8 @@ void smtc_multicast_init( smtc_multicast_t* multicast_obj, uint8_t stack_id )
         multicast_obj->rx_session_param[i].fcnt_dwn       = ~0;
         multicast_obj->rx_session_param[i].fcnt_dwn_min   = 0;
         multicast_obj->rx_session_param[i].fcnt_dwn_max   = ~0;
-        multicast_obj->rx_session_param[i].app_skey       = smtc_mc_skey_tab[i].mc_app_skey;
-        multicast_obj->rx_session_param[i].nwk_skey       = smtc_mc_skey_tab[i].mc_ntw_skey;
+        multicast_obj->rx_session_param[i].app_skey       = SMTC_SE_MC_APP_S_KEY( i );
+        multicast_obj->rx_session_param[i].nwk_skey       = SMTC_SE_MC_NWK_S_KEY( i );
         multicast_obj->rx_session_param[i].rx_data_rate   = LR1MAC_MC_NO_DATARATE;
         multicast_obj->rx_session_param[i].rx_window_symb = 6;
         multicast_obj->rx_session_param[i].fpending_bit   = MULTICAST_WO_FPENDING;
@@ -212,14 +183,14 @@ smtc_multicast_config_rc_t smtc_multicast_set_group_keys( smtc_multicast_t* mult
     }
 
     // Save multicast keys
-    if( smtc_modem_crypto_set_key( smtc_mc_skey_tab[mc_group_id].mc_ntw_skey, mc_ntw_skey, multicast_obj->stack_id ) !=
+    if( smtc_modem_crypto_set_key( SMTC_SE_MC_NWK_S_KEY( mc_group_id ), mc_ntw_skey, multicast_obj->stack_id ) !=
         SMTC_MODEM_CRYPTO_RC_SUCCESS )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Error setting multicast ntw_skey for group:%d\n", mc_group_id );
         return SMTC_MC_RC_ERROR_CRYPTO;
     }
 
-    if( smtc_modem_crypto_set_key( smtc_mc_skey_tab[mc_group_id].mc_app_skey, mc_app_skey, multicast_obj->stack_id ) !=
+    if( smtc_modem_crypto_set_key( SMTC_SE_MC_APP_S_KEY( mc_group_id ), mc_app_skey, multicast_obj->stack_id ) !=
         SMTC_MODEM_CRYPTO_RC_SUCCESS )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Error setting multicast ntw_skey for group:%d\n", mc_group_id );
@@ -258,7 +229,7 @@ smtc_multicast_config_rc_t smtc_multicast_derive_group_keys( smtc_multicast_t* m
         return SMTC_MC_RC_ERROR_BUSY;
     }
     // crypto layer to decrypt and set group key
-    if( smtc_modem_crypto_set_key( smtc_mc_skey_tab[mc_group_id].mc_key, mc_key_encrypted, multicast_obj->stack_id ) !=
+    if( smtc_modem_crypto_set_key( SMTC_SE_MC_KEY( mc_group_id ), mc_key_encrypted, multicast_obj->stack_id ) !=
         SMTC_MODEM_CRYPTO_RC_SUCCESS )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "Error decrypting and setting  multicast key for group:%d\n", mc_group_id );
@@ -56,7 +56,7 @@ extern "C" {
  * --- PUBLIC CONSTANTS --------------------------------------------------------
  */
 // clang-format off
-#define LR1MAC_MC_NUMBER_OF_SESSION  ( RX_SESSION_COUNT - 1 ) // Remove the unicast session
+#define LR1MAC_MC_NUMBER_OF_SESSION  SMTC_MULTICAST_NB_GROUPS // Build time capacity, see smtc_secure_element.h
 #define LR1MAC_MC_NO_DATARATE 0xFF
 // clang-format on
 
@@ -49,7 +49,7 @@
  * --- PRIVATE MACROS-----------------------------------------------------------
  */
 #define real_ctx real->real_ctx
-#define real_const real->real_const
+#define real_const SMTC_REAL_CONST( real )
 
 #define tx_frequency_channel real->region.as923.tx_frequency_channel
 #define rx1_frequency_channel real->region.as923.rx1_frequency_channel
@@ -87,20 +87,9 @@
  */
 void region_as_923_init( smtc_real_t* real, uint8_t group_id )
 {
-    real_const.const_number_of_tx_channel      = NUMBER_OF_CHANNEL_AS_923;
-    real_const.const_number_of_rx_channel      = NUMBER_OF_CHANNEL_AS_923;
-    real_const.const_number_of_boot_tx_channel = NUMBER_OF_BOOT_TX_CHANNEL_AS_923;
-    real_const.const_number_of_channel_bank    = BANK_MAX_AS923;
-    real_const.const_join_accept_delay1        = JOIN_ACCEPT_DELAY1_AS_923;
-    real_const.const_received_delay1           = RECEIVE_DELAY1_AS_923;
-    real_const.const_tx_power_dbm              = TX_POWER_EIRP_AS_923 - 2;  // EIRP to ERP
-    real_const.const_max_tx_power_idx          = MAX_TX_POWER_IDX_AS_923;
-    real_const.const_adr_ack_limit             = ADR_ACK_LIMIT_AS_923;
-    real_const.const_adr_ack_delay             = ADR_ACK_DELAY_AS_923;
-    real_const.const_datarate_offsets          = &datarate_offsets_as_923[0][0][0];
-    real_const.const_datarate_backoff          = &datarate_backoff_as_923[0][0];
-    real_const.const_ack_timeout               = ACK_TIMEOUT_AS_923;
-    real_const.const_frequency_factor          = FREQUENCY_FACTOR_AS_923;
+#if !defined( SMTC_REAL_SINGLE_REGION )
+    real->constants = region_as_923_const;
+#endif
 
     switch( group_id )
     {
@@ -129,38 +118,9 @@ void region_as_923_init( smtc_real_t* real, uint8_t group_id )
         break;
     }
 
-    real_const.const_rx2_freq = RX2_FREQ_AS_923 + real_const.const_frequency_offset_hz;
-
-    real_const.const_rx2_dr_init                  = RX2DR_INIT_AS_923;
-    real_const.const_sync_word_private            = SYNC_WORD_PRIVATE_AS_923;
-    real_const.const_sync_word_public             = SYNC_WORD_PUBLIC_AS_923;
-    real_const.const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_AS_923;
-    real_const.const_min_tx_dr                    = MIN_DR_AS_923;
-    real_const.const_max_tx_dr                    = MAX_DR_AS_923;
-    real_const.const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_AS_923;
-    real_const.const_min_rx_dr                    = MIN_DR_AS_923;
-    real_const.const_max_rx_dr                    = MAX_DR_AS_923;
-    real_const.const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_AS_923;
-    real_const.const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_AS_923;
-    real_const.const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_AS_923;
-    real_const.const_number_of_tx_dr              = NUMBER_OF_TX_DR_AS_923;
-    real_const.const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_AS_923;
-    real_const.const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_AS_923;
-    real_const.const_dtc_supported                = DTC_SUPPORTED_AS_923;
-    real_const.const_lbt_supported                = LBT_SUPPORTED_AS_923;
-    real_const.const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_AS_923;
-    real_const.const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_AS_923;
-    real_const.const_lbt_bw_hz                    = LBT_BW_HZ_AS_923;
-    real_const.const_max_payload_m                = &M_as_923[0][0];
-    real_const.const_coding_rate                  = RAL_LORA_CR_4_5;
-    real_const.const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_AS_923[0];
-    real_const.const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_AS_923[0];
-    real_const.const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_AS_923[0];
-    real_const.const_cf_list_type_supported       = CF_LIST_SUPPORTED_AS_923;
-    real_const.const_beacon_dr                    = BEACON_DR_AS_923;
-    real_const.const_beacon_frequency             = BEACON_FREQ_AS_923 + real_const.const_frequency_offset_hz;
-    real_const.const_ping_slot_frequency          = PING_SLOT_FREQ_AS_923 + real_const.const_frequency_offset_hz;
-    real_const.const_uplink_dwell_time            = UPLINK_DWELL_TIME_AS_923;
+    real_const.const_rx2_freq            = RX2_FREQ_AS_923 + real_const.const_frequency_offset_hz;
+    real_const.const_beacon_frequency    = BEACON_FREQ_AS_923 + real_const.const_frequency_offset_hz;
+    real_const.const_ping_slot_frequency = PING_SLOT_FREQ_AS_923 + real_const.const_frequency_offset_hz;
 
     real_ctx.tx_frequency_channel_ctx        = &tx_frequency_channel[0];
     real_ctx.rx1_frequency_channel_ctx       = &rx1_frequency_channel[0];
@@ -48,7 +48,7 @@
  * --- PRIVATE MACROS-----------------------------------------------------------
  */
 #define real_ctx real->real_ctx
-#define real_const real->real_const
+#define real_const SMTC_REAL_CONST( real )
 
 #define tx_frequency_channel real->region.in865.tx_frequency_channel
 #define rx1_frequency_channel real->region.in865.rx1_frequency_channel
@@ -87,49 +87,9 @@
 
 void region_in_865_init( smtc_real_t* real )
 {
-    real_const.const_number_of_tx_channel         = NUMBER_OF_CHANNEL_IN_865;
-    real_const.const_number_of_rx_channel         = NUMBER_OF_CHANNEL_IN_865;
-    real_const.const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_IN_865;
-    real_const.const_number_of_channel_bank       = BANK_MAX_IN865;
-    real_const.const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_IN_865;
-    real_const.const_received_delay1              = RECEIVE_DELAY1_IN_865;
-    real_const.const_tx_power_dbm                 = TX_POWER_EIRP_IN_865 - 2;  // EIRP to ERP
-    real_const.const_max_tx_power_idx             = MAX_TX_POWER_IDX_IN_865;
-    real_const.const_adr_ack_limit                = ADR_ACK_LIMIT_IN_865;
-    real_const.const_adr_ack_delay                = ADR_ACK_DELAY_IN_865;
-    real_const.const_datarate_offsets             = &datarate_offsets_in_865[0][0];
-    real_const.const_datarate_backoff             = &datarate_backoff_in_865[0];
-    real_const.const_ack_timeout                  = ACK_TIMEOUT_IN_865;
-    real_const.const_frequency_factor             = FREQUENCY_FACTOR_IN_865;
-    real_const.const_freq_min                     = FREQMIN_IN_865;
-    real_const.const_freq_max                     = FREQMAX_IN_865;
-    real_const.const_rx2_freq                     = RX2_FREQ_IN_865;
-    real_const.const_rx2_dr_init                  = RX2DR_INIT_IN_865;
-    real_const.const_sync_word_private            = SYNC_WORD_PRIVATE_IN_865;
-    real_const.const_sync_word_public             = SYNC_WORD_PUBLIC_IN_865;
-    real_const.const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_IN_865;
-    real_const.const_min_tx_dr                    = MIN_DR_IN_865;
-    real_const.const_max_tx_dr                    = MAX_DR_IN_865;
-    real_const.const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_IN_865;
-    real_const.const_number_of_tx_dr              = NUMBER_OF_TX_DR_IN_865;
-    real_const.const_min_rx_dr                    = MIN_DR_IN_865;
-    real_const.const_max_rx_dr                    = MAX_DR_IN_865;
-    real_const.const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_IN_865;
-    real_const.const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_IN_865;
-    real_const.const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_IN_865;
-    real_const.const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_IN_865;
-    real_const.const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_IN_865;
-    real_const.const_dtc_supported                = DTC_SUPPORTED_IN_865;
-    real_const.const_lbt_supported                = LBT_SUPPORTED_IN_865;
-    real_const.const_max_payload_m                = &M_in_865[0];
-    real_const.const_coding_rate                  = RAL_LORA_CR_4_5;
-    real_const.const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_IN_865[0];
-    real_const.const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_IN_865[0];
-    real_const.const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_IN_865[0];
-    real_const.const_cf_list_type_supported       = CF_LIST_SUPPORTED_IN_865;
-    real_const.const_beacon_dr                    = BEACON_DR_IN_865;
-    real_const.const_beacon_frequency             = BEACON_FREQ_IN_865;
-    real_const.const_ping_slot_frequency          = PING_SLOT_FREQ_IN_865;
+#if !defined( SMTC_REAL_SINGLE_REGION )
+    real->constants = region_in_865_const;
+#endif
 
     real_ctx.tx_frequency_channel_ctx        = &tx_frequency_channel[0];
     real_ctx.rx1_frequency_channel_ctx       = &rx1_frequency_channel[0];
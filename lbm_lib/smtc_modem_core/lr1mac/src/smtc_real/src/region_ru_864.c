@@ -49,7 +49,7 @@
  * --- PRIVATE MACROS-----------------------------------------------------------
  */
 #define real_ctx real->real_ctx
-#define real_const real->real_const
+#define real_const SMTC_REAL_CONST( real )
 
 #define tx_frequency_channel real->region.ru864.tx_frequency_channel
 #define rx1_frequency_channel real->region.ru864.rx1_frequency_channel
@@ -88,55 +88,9 @@
 
 void region_ru_864_init( smtc_real_t* real )
 {
-    real_const.const_number_of_tx_channel         = NUMBER_OF_CHANNEL_RU_864;
-    real_const.const_number_of_rx_channel         = NUMBER_OF_CHANNEL_RU_864;
-    real_const.const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_RU_864;
-    real_const.const_number_of_channel_bank       = BANK_MAX_RU864;
-    real_const.const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_RU_864;
-    real_const.const_received_delay1              = RECEIVE_DELAY1_RU_864;
-    real_const.const_tx_power_dbm                 = TX_POWER_EIRP_RU_864 - 2;  // EIRP to ERP
-    real_const.const_max_tx_power_idx             = MAX_TX_POWER_IDX_RU_864;
-    real_const.const_adr_ack_limit                = ADR_ACK_LIMIT_RU_864;
-    real_const.const_adr_ack_delay                = ADR_ACK_DELAY_RU_864;
-    real_const.const_datarate_offsets             = &datarate_offsets_ru_864[0][0];
-    real_const.const_datarate_backoff             = &datarate_backoff_ru_864[0];
-    real_const.const_ack_timeout                  = ACK_TIMEOUT_RU_864;
-    real_const.const_freq_min                     = FREQMIN_RU_864;
-    real_const.const_freq_max                     = FREQMAX_RU_864;
-    real_const.const_rx2_freq                     = RX2_FREQ_RU_864;
-    real_const.const_frequency_factor             = FREQUENCY_FACTOR_RU_864;
-    real_const.const_rx2_dr_init                  = RX2DR_INIT_RU_864;
-    real_const.const_sync_word_private            = SYNC_WORD_PRIVATE_RU_864;
-    real_const.const_sync_word_public             = SYNC_WORD_PUBLIC_RU_864;
-    real_const.const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_RU_864;
-    real_const.const_min_tx_dr                    = MIN_DR_RU_864;
-    real_const.const_max_tx_dr                    = MAX_DR_RU_864;
-    real_const.const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_RU_864;
-    real_const.const_number_of_tx_dr              = NUMBER_OF_TX_DR_RU_864;
-    real_const.const_min_rx_dr                    = MIN_DR_RU_864;
-    real_const.const_max_rx_dr                    = MAX_DR_RU_864;
-    real_const.const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_RU_864;
-    real_const.const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_RU_864;
-    real_const.const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_RU_864;
-    real_const.const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_RU_864;
-    real_const.const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_RU_864;
-    real_const.const_dtc_supported                = DTC_SUPPORTED_RU_864;
-    real_const.const_dtc_number_of_band           = BAND_RU864_MAX;
-    real_const.const_dtc_by_band                  = &duty_cycle_by_band_ru_864[0];
-    real_const.const_dtc_frequency_range_by_band  = &frequency_range_by_band_ru_864[0][0],
-    real_const.const_lbt_supported                = LBT_SUPPORTED_RU_864;
-    real_const.const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_RU_864;
-    real_const.const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_RU_864;
-    real_const.const_lbt_bw_hz                    = LBT_BW_HZ_RU_864;
-    real_const.const_max_payload_m                = &M_ru_864[0];
-    real_const.const_coding_rate                  = RAL_LORA_CR_4_5;
-    real_const.const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_RU_864[0];
-    real_const.const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_RU_864[0];
-    real_const.const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_RU_864[0];
-    real_const.const_cf_list_type_supported       = CF_LIST_SUPPORTED_RU_864;
-    real_const.const_beacon_dr                    = BEACON_DR_RU_864;
-    real_const.const_beacon_frequency             = BEACON_FREQ_RU_864;
-    real_const.const_ping_slot_frequency          = PING_SLOT_FREQ_RU_864;
+#if !defined( SMTC_REAL_SINGLE_REGION )
+    real->constants = region_ru_864_const;
+#endif
 
     real_ctx.tx_frequency_channel_ctx        = &tx_frequency_channel[0];
     real_ctx.rx1_frequency_channel_ctx       = &rx1_frequency_channel[0];
@@ -210,7 +164,13 @@ status_lorawan_t region_ru_864_get_next_channel( smtc_real_t* real, uint8_t tx_d
         SMTC_MODEM_HAL_TRACE_WARNING( "NO CHANNELS AVAILABLE \n" );
         return ERRORLORAWAN;
     }
-    uint8_t temp = ( smtc_modem_hal_get_random_nb_in_range( 0, ( *active_channel_nb - 1 ) ) ) % *active_channel_nb;
+    // Draw among the free channels, weighted by the time on air left in their duty cycle band
+    uint32_t active_channel_freq[NUMBER_OF_CHANNEL_RU_864];
+    for( uint8_t i = 0; i < *active_channel_nb; i++ )
+    {
+        active_channel_freq[i] = tx_frequency_channel[active_channel_index[i]];
+    }
+    uint8_t temp        = smtc_duty_cycle_draw_channel( active_channel_freq, *active_channel_nb );
     uint8_t channel_idx = 0;
     channel_idx         = active_channel_index[temp];
     if( channel_idx >= real_const.const_number_of_tx_channel )
@@ -49,7 +49,7 @@
  */
 
 #define real_ctx real->real_ctx
-#define real_const real->real_const
+#define real_const SMTC_REAL_CONST( real )
 
 #define dr_bitfield_tx_channel real->region.us915.dr_bitfield_tx_channel
 #define channel_index_enabled real->region.us915.channel_index_enabled
@@ -105,45 +105,9 @@ static void region_us_915_channel_mask_set_after_join( smtc_real_t* real );
 
 void region_us_915_init( smtc_real_t* real )
 {
-    real_const.const_number_of_tx_channel         = NUMBER_OF_TX_CHANNEL_US_915;
-    real_const.const_number_of_rx_channel         = NUMBER_OF_RX_CHANNEL_US_915;
-    real_const.const_number_of_channel_bank       = BANK_MAX_US915;
-    real_const.const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_US_915;
-    real_const.const_received_delay1              = RECEIVE_DELAY1_US_915;
-    real_const.const_tx_power_dbm                 = TX_POWER_EIRP_US_915 - 2;  // EIRP to ERP
-    real_const.const_max_tx_power_idx             = MAX_TX_POWER_IDX_US_915;
-    real_const.const_adr_ack_limit                = ADR_ACK_LIMIT_US_915;
-    real_const.const_adr_ack_delay                = ADR_ACK_DELAY_US_915;
-    real_const.const_datarate_offsets             = &datarate_offsets_us_915[0][0];
-    real_const.const_datarate_backoff             = &datarate_backoff_us_915[0];
-    real_const.const_ack_timeout                  = ACK_TIMEOUT_US_915;
-    real_const.const_freq_min                     = FREQMIN_US_915;
-    real_const.const_freq_max                     = FREQMAX_US_915;
-    real_const.const_rx2_freq                     = RX2_FREQ_US_915;
-    real_const.const_frequency_factor             = FREQUENCY_FACTOR_US_915;
-    real_const.const_rx2_dr_init                  = RX2DR_INIT_US_915;
-    real_const.const_sync_word_private            = SYNC_WORD_PRIVATE_US_915;
-    real_const.const_sync_word_public             = SYNC_WORD_PUBLIC_US_915;
-    real_const.const_sync_word_lr_fhss            = ( uint8_t* ) SYNC_WORD_LR_FHSS_US_915;
-    real_const.const_min_tx_dr                    = MIN_TX_DR_US_915;
-    real_const.const_max_tx_dr                    = MAX_TX_DR_US_915;
-    real_const.const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_US_915;
-    real_const.const_number_of_tx_dr              = NUMBER_OF_TX_DR_US_915;
-    real_const.const_min_rx_dr                    = MIN_RX_DR_US_915;
-    real_const.const_max_rx_dr                    = MAX_RX_DR_US_915;
-    real_const.const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_US_915;
-    real_const.const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_US_915;
-    real_const.const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_US_915;
-    real_const.const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_US_915;
-    real_const.const_dtc_supported                = DTC_SUPPORTED_US_915;
-    real_const.const_lbt_supported                = LBT_SUPPORTED_US_915;
-    real_const.const_max_payload_m                = &M_us_915[0];
-    real_const.const_coding_rate                  = RAL_LORA_CR_4_5;
-    real_const.const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_US_915[0];
-    real_const.const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_US_915[0];
-    real_const.const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_US_915[0];
-    real_const.const_cf_list_type_supported       = CF_LIST_SUPPORTED_US_915;
-    real_const.const_beacon_dr                    = BEACON_DR_US_915;
+#if !defined( SMTC_REAL_SINGLE_REGION )
+    real->constants = region_us_915_const;
+#endif
 
     real_ctx.tx_frequency_channel_ctx        = NULL;
     real_ctx.rx1_frequency_channel_ctx       = NULL;
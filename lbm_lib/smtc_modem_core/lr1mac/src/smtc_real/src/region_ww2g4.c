@@ -48,7 +48,7 @@
  * --- PRIVATE MACROS-----------------------------------------------------------
  */
 #define real_ctx real->real_ctx
-#define real_const real->real_const
+#define real_const SMTC_REAL_CONST( real )
 
 #define tx_frequency_channel real->region.ww2g4.tx_frequency_channel
 #define rx1_frequency_channel real->region.ww2g4.rx1_frequency_channel
@@ -87,53 +87,9 @@
 
 void region_ww2g4_init( smtc_real_t* real )
 {
-    real_const.const_number_of_tx_channel         = NUMBER_OF_CHANNEL_WW2G4;
-    real_const.const_number_of_rx_channel         = NUMBER_OF_CHANNEL_WW2G4;
-    real_const.const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_WW2G4;
-    real_const.const_number_of_channel_bank       = BANK_MAX_WW2G4;
-    real_const.const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_WW2G4;
-    real_const.const_received_delay1              = RECEIVE_DELAY1_WW2G4;
-    real_const.const_tx_power_dbm                 = TX_POWER_EIRP_WW2G4 - 2;  // EIRP to ERP
-    real_const.const_max_tx_power_idx             = MAX_TX_POWER_IDX_WW2G4;
-    real_const.const_adr_ack_limit                = ADR_ACK_LIMIT_WW2G4;
-    real_const.const_adr_ack_delay                = ADR_ACK_DELAY_WW2G4;
-    real_const.const_datarate_offsets             = &datarate_offsets_ww2g4[0][0];
-    real_const.const_datarate_backoff             = &datarate_backoff_ww2g4[0];
-    real_const.const_ack_timeout                  = ACK_TIMEOUT_WW2G4;
-    real_const.const_freq_min                     = FREQMIN_WW2G4;
-    real_const.const_freq_max                     = FREQMAX_WW2G4;
-    real_const.const_rx2_freq                     = RX2_FREQ_WW2G4;
-    real_const.const_frequency_factor             = FREQUENCY_FACTOR_WW2G4;
-    real_const.const_rx2_dr_init                  = RX2DR_INIT_WW2G4;
-    real_const.const_sync_word_private            = SYNC_WORD_PRIVATE_WW2G4;
-    real_const.const_sync_word_public             = SYNC_WORD_PUBLIC_WW2G4;
-    real_const.const_min_tx_dr                    = MIN_DR_WW2G4;
-    real_const.const_max_tx_dr                    = MAX_DR_WW2G4;
-    real_const.const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_WW2G4;
-    real_const.const_min_rx_dr                    = MIN_DR_WW2G4;
-    real_const.const_max_rx_dr                    = MAX_DR_WW2G4;
-    real_const.const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_WW2G4;
-    real_const.const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_WW2G4;
-    real_const.const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_WW2G4;
-    real_const.const_number_of_tx_dr              = NUMBER_OF_TX_DR_WW2G4;
-    real_const.const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_WW2G4;
-    real_const.const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_WW2G4;
-    real_const.const_dtc_supported                = DTC_SUPPORTED_WW2G4;
-    real_const.const_lbt_supported                = LBT_SUPPORTED_WW2G4;
-    real_const.const_max_payload_m                = &M_ww2g4[0];
-    real_const.const_coding_rate                  = RAL_LORA_CR_LI_4_8;
-#if defined( WW2G4_SINGLE_DATARATE )
-    real_const.const_mobile_lowpower_dr_distri  = &DEFAULT_DR_DISTRIBUTION_WW2G4[0];
-    real_const.const_mobile_longrange_dr_distri = &DEFAULT_DR_DISTRIBUTION_WW2G4[0];
-#else
-    real_const.const_mobile_longrange_dr_distri = &MOBILE_LONGRANGE_DR_DISTRIBUTION_WW2G4[0];
-    real_const.const_mobile_lowpower_dr_distri  = &MOBILE_LOWPER_DR_DISTRIBUTION_WW2G4[0];
+#if !defined( SMTC_REAL_SINGLE_REGION )
+    real->constants = region_ww2g4_const;
 #endif
-    real_const.const_default_dr_distri      = &DEFAULT_DR_DISTRIBUTION_WW2G4[0];
-    real_const.const_cf_list_type_supported = CF_LIST_SUPPORTED_WW2G4;
-    real_const.const_beacon_dr              = BEACON_DR_WW2G4;
-    real_const.const_beacon_frequency       = BEACON_FREQ_WW2G4;
-    real_const.const_ping_slot_frequency    = PING_SLOT_FREQ_WW2G4;
 
     real_ctx.tx_frequency_channel_ctx        = &tx_frequency_channel[0];
     real_ctx.rx1_frequency_channel_ctx       = &rx1_frequency_channel[0];
@@ -85,7 +85,7 @@
  * --- PRIVATE MACROS-----------------------------------------------------------
  */
 #define real_ctx real->real_ctx
-#define real_const real->real_const
+#define real_const SMTC_REAL_CONST( real )
 
 #define tx_frequency_channel_ctx real_ctx.tx_frequency_channel_ctx
 #define rx1_frequency_channel_ctx real_ctx.rx1_frequency_channel_ctx
@@ -121,10 +121,12 @@ void smtc_real_init( smtc_real_t* real, smtc_real_region_types_t region_type )
     }
     real->region_type = region_type;
 
+#if !defined( SMTC_REAL_SINGLE_REGION )
     // Init all real_const.const_xxx to 0
     memset( &( real_const ), 0, sizeof( smtc_real_const_t ) );
+#endif
 
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4: {
@@ -210,7 +212,7 @@ void smtc_real_init( smtc_real_t* real, smtc_real_region_types_t region_type )
 
 void smtc_real_config( smtc_real_t* real )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4: {
@@ -289,7 +291,7 @@ void smtc_real_config( smtc_real_t* real )
 
 void smtc_real_config_session( smtc_real_t* real )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -363,6 +365,7 @@ void smtc_real_set_dr_distribution( smtc_real_t* real, uint8_t adr_mode, uint8_t
 {
     switch( adr_mode )
     {
+    case MOBILE_LINK_ADAPTIVE_DR:  // long range distribution is used until the link history is filled
     case MOBILE_LONGRANGE_DR_DISTRIBUTION:
 #if !defined( HYBRID_CN470_MONO_CHANNEL )
         memcpy( dr_distribution_init_ctx, real_const.const_mobile_longrange_dr_distri,
@@ -577,7 +580,7 @@ status_lorawan_t smtc_real_update_cflist( smtc_real_t* real, uint8_t* cf_list )
 
 uint8_t smtc_real_get_number_of_chmask_in_cflist( smtc_real_t* real )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -639,7 +642,7 @@ uint8_t smtc_real_get_number_of_chmask_in_cflist( smtc_real_t* real )
 status_lorawan_t smtc_real_get_next_channel( smtc_real_t* real, uint8_t tx_data_rate, uint32_t* out_tx_frequency,
                                              uint32_t* out_rx1_frequency, uint8_t* out_nb_available_tx_channel )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4: {
@@ -718,7 +721,7 @@ status_lorawan_t smtc_real_get_join_next_channel( smtc_real_t* real, uint8_t* tx
                                                   uint32_t* out_rx1_frequency, uint32_t* out_rx2_frequency,
                                                   uint8_t* out_nb_available_tx_channel )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4: {
@@ -797,7 +800,7 @@ void smtc_real_mask_channel_used_for_tx( smtc_real_t* real )
 {
     // Mask the channel used, to be remove for the next selection
 
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -852,13 +855,31 @@ void smtc_real_mask_channel_used_for_tx( smtc_real_t* real )
     }
 }
 
+bool smtc_real_is_channel_selection_stateful( smtc_real_t* real )
+{
+    // These regions walk through their channels and mask each one used, so a draw is also a reservation
+    switch( SMTC_REAL_REGION_TYPE( real ) )
+    {
+#if defined( REGION_US_915 )
+    case SMTC_REAL_REGION_US_915:
+        return true;
+#endif
+#if defined( REGION_AU_915 )
+    case SMTC_REAL_REGION_AU_915:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
 uint8_t smtc_real_get_rx1_datarate_config( smtc_real_t* real, uint8_t tx_data_rate, uint8_t rx1_dr_offset )
 {
     uint8_t max   = real_const.const_number_of_tx_dr * real_const.const_number_rx1_dr_offset;
     uint8_t index = ( tx_data_rate * real_const.const_number_rx1_dr_offset ) + rx1_dr_offset;
 
 #if defined( REGION_AS_923 )
-    if( real->region_type == SMTC_REAL_REGION_AS_923 )
+    if( SMTC_REAL_REGION_TYPE( real ) == SMTC_REAL_REGION_AS_923 )
     {
         max *= ( downlink_dwell_time_ctx + 1 );
         index += ( downlink_dwell_time_ctx * real_const.const_number_of_tx_dr * real_const.const_number_rx1_dr_offset );
@@ -888,7 +909,7 @@ int8_t smtc_real_convert_power_cmd( smtc_real_t* real, uint8_t power_cmd, uint8_
 
 void smtc_real_set_channel_mask( smtc_real_t* real )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -962,7 +983,7 @@ void smtc_real_init_channel_mask( smtc_real_t* real )
 
 void smtc_real_init_join_snapshot_channel_mask( smtc_real_t* real )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -1021,7 +1042,7 @@ void smtc_real_init_join_snapshot_channel_mask( smtc_real_t* real )
 
 void smtc_real_init_after_join_snapshot_channel_mask( smtc_real_t* real, uint8_t tx_data_rate, uint32_t tx_frequency )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -1080,7 +1101,7 @@ void smtc_real_init_after_join_snapshot_channel_mask( smtc_real_t* real, uint8_t
 
 status_channel_t smtc_real_build_channel_mask( smtc_real_t* real, uint8_t ch_mask_cntl, uint16_t ch_mask )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4: {
@@ -1208,7 +1229,7 @@ void smtc_real_decrement_dr( smtc_real_t* real, dr_strategy_t adr_mode_select, u
 
 void smtc_real_enable_all_channels_with_valid_freq( smtc_real_t* real )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -1319,7 +1340,7 @@ status_lorawan_t smtc_real_is_tx_dr_valid( smtc_real_t* real, uint8_t dr )
 
 status_lorawan_t smtc_real_is_tx_dr_acceptable( smtc_real_t* real, uint8_t dr, bool is_ch_mask_from_link_adr )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -1398,7 +1419,7 @@ status_lorawan_t smtc_real_is_tx_dr_acceptable( smtc_real_t* real, uint8_t dr, b
 
 status_lorawan_t smtc_real_is_nwk_received_tx_frequency_valid( smtc_real_t* real, uint32_t frequency )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -1461,7 +1482,7 @@ status_lorawan_t smtc_real_is_nwk_received_tx_frequency_valid( smtc_real_t* real
 
 status_lorawan_t smtc_real_is_channel_index_valid( smtc_real_t* real, uint8_t channel_index )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -1536,7 +1557,7 @@ status_lorawan_t smtc_real_is_payload_size_valid( smtc_real_t* real, uint8_t dr,
     uint8_t index = ( dwell_time_enabled * real_const.const_number_of_tx_dr ) + dr;
 
 #if defined( REGION_AU_915 )
-    if( real->region_type == SMTC_REAL_REGION_AU_915 )
+    if( SMTC_REAL_REGION_TYPE( real ) == SMTC_REAL_REGION_AU_915 )
     {
         // *2 because the array contains Tx and Rx datarate
         index = ( dwell_time_enabled * real_const.const_number_of_tx_dr * 2 ) + dr;
@@ -1556,7 +1577,7 @@ status_lorawan_t smtc_real_is_payload_size_valid( smtc_real_t* real, uint8_t dr,
 
 void smtc_real_set_tx_frequency_channel( smtc_real_t* real, uint32_t tx_freq, uint8_t channel_index )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -1619,7 +1640,7 @@ void smtc_real_set_tx_frequency_channel( smtc_real_t* real, uint32_t tx_freq, ui
 
 status_lorawan_t smtc_real_set_rx1_frequency_channel( smtc_real_t* real, uint32_t rx_freq, uint8_t channel_index )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -1685,7 +1706,7 @@ status_lorawan_t smtc_real_set_rx1_frequency_channel( smtc_real_t* real, uint32_
 
 void smtc_real_set_channel_dr( smtc_real_t* real, uint8_t channel_index, uint8_t dr_min, uint8_t dr_max )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -1753,7 +1774,7 @@ void smtc_real_set_channel_dr( smtc_real_t* real, uint8_t channel_index, uint8_t
 
 void smtc_real_set_channel_enabled( smtc_real_t* real, uint8_t enable, uint8_t channel_index )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -1816,7 +1837,7 @@ void smtc_real_set_channel_enabled( smtc_real_t* real, uint8_t enable, uint8_t c
 
 uint32_t smtc_real_get_tx_channel_frequency( smtc_real_t* real, uint8_t channel_index )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -1883,7 +1904,7 @@ uint32_t smtc_real_get_tx_channel_frequency( smtc_real_t* real, uint8_t channel_
 
 uint32_t smtc_real_get_rx1_channel_frequency( smtc_real_t* real, uint8_t channel_index )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -2033,7 +2054,7 @@ uint16_t smtc_real_mask_tx_dr_channel_up_dwell_time_check( smtc_real_t* real )
 
 uint8_t smtc_real_get_preamble_len( const smtc_real_t* real, uint8_t sf )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4: {
@@ -2106,7 +2127,7 @@ status_lorawan_t smtc_real_is_channel_mask_for_mobile_mode( const smtc_real_t* r
 
 modulation_type_t smtc_real_get_modulation_type_from_datarate( smtc_real_t* real, uint8_t datarate )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4: {
@@ -2182,7 +2203,7 @@ modulation_type_t smtc_real_get_modulation_type_from_datarate( smtc_real_t* real
 }
 void smtc_real_lora_dr_to_sf_bw( smtc_real_t* real, uint8_t in_dr, uint8_t* out_sf, lr1mac_bandwidth_t* out_bw )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4: {
@@ -2258,7 +2279,7 @@ void smtc_real_lora_dr_to_sf_bw( smtc_real_t* real, uint8_t in_dr, uint8_t* out_
 
 void smtc_real_fsk_dr_to_bitrate( smtc_real_t* real, uint8_t in_dr, uint8_t* out_bitrate )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_EU_868 )
     case SMTC_REAL_REGION_EU_868: {
@@ -2304,7 +2325,7 @@ void smtc_real_fsk_dr_to_bitrate( smtc_real_t* real, uint8_t in_dr, uint8_t* out
 
 void smtc_real_lr_fhss_dr_to_cr_bw( smtc_real_t* real, uint8_t in_dr, lr_fhss_v1_cr_t* out_cr, lr_fhss_v1_bw_t* out_bw )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_EU_868 )
     case SMTC_REAL_REGION_EU_868: {
@@ -2347,7 +2368,7 @@ lr_fhss_hc_t smtc_real_lr_fhss_get_header_count( lr_fhss_v1_cr_t in_cr )
 
 lr_fhss_v1_grid_t smtc_real_lr_fhss_get_grid( smtc_real_t* real )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_EU_868 )
     case SMTC_REAL_REGION_EU_868: {
@@ -2394,7 +2415,7 @@ uint8_t smtc_real_get_number_of_enabled_channels_for_a_datarate( smtc_real_t* re
 int8_t smtc_real_clamp_output_power_eirp_vs_freq_and_dr( smtc_real_t* real, int8_t tx_power, uint32_t tx_frequency,
                                                          uint8_t datarate )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -2553,7 +2574,7 @@ void smtc_real_set_sync_word( smtc_real_t* real, uint8_t sync_word )
 
 uint8_t* smtc_real_get_gfsk_sync_word( smtc_real_t* real )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_EU_868 )
     case SMTC_REAL_REGION_EU_868:
@@ -2594,7 +2615,7 @@ uint8_t* smtc_real_get_gfsk_sync_word( smtc_real_t* real )
 
 uint8_t* smtc_real_get_lr_fhss_sync_word( smtc_real_t* real )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_EU_868 )
     case SMTC_REAL_REGION_EU_868:
@@ -2668,7 +2689,7 @@ uint8_t smtc_real_get_max_payload_size( smtc_real_t* real, uint8_t dr, direction
     uint8_t index = ( dwell_time_enabled * real_const.const_number_of_tx_dr ) + dr;
 
 #if defined( REGION_AU_915 )
-    if( real->region_type == SMTC_REAL_REGION_AU_915 )
+    if( SMTC_REAL_REGION_TYPE( real ) == SMTC_REAL_REGION_AU_915 )
     {
         // *2 because the array contains Tx and Rx datarate
         index = ( dwell_time_enabled * real_const.const_number_of_tx_dr * 2 ) + dr;
@@ -2690,7 +2711,7 @@ uint8_t smtc_real_get_beacon_dr( smtc_real_t* real )
 
 bool smtc_real_is_beacon_hopping( smtc_real_t* real )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -2750,7 +2771,7 @@ bool smtc_real_is_beacon_hopping( smtc_real_t* real )
 
 uint32_t smtc_real_get_beacon_frequency( smtc_real_t* real, uint32_t gps_time_s )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
@@ -2816,7 +2837,7 @@ uint32_t smtc_real_get_beacon_frequency( smtc_real_t* real, uint32_t gps_time_s
 
 uint32_t smtc_real_get_ping_slot_frequency( smtc_real_t* real, uint32_t gps_time_s, uint32_t dev_addr )
 {
-    switch( real->region_type )
+    switch( SMTC_REAL_REGION_TYPE( real ) )
     {
 #if defined( REGION_WW2G4 )
     case SMTC_REAL_REGION_WW2G4:
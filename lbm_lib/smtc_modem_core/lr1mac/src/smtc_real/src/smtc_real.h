@@ -191,6 +191,14 @@ status_lorawan_t smtc_real_get_join_next_channel( smtc_real_t* real, uint8_t* tx
  */
 void smtc_real_mask_channel_used_for_tx( smtc_real_t* real );
 
+/**
+ * \brief   Tell whether the channel selection of the region keeps a state between two draws
+ * \remark  When true, each smtc_real_get_next_channel call consumes a channel and must be followed by a tx on it
+ * \param [IN]  real  Regional context
+ * \return  true if the region masks the channels already drawn
+ */
+bool smtc_real_is_channel_selection_stateful( smtc_real_t* real );
+
 /**
  * \brief
  * \remark
@@ -297,7 +297,9 @@ typedef struct smtc_real_const_s
 typedef struct smtc_real_s
 {
     smtc_real_region_types_t region_type;
-    smtc_real_const_t        real_const;
+#if !defined( SMTC_REAL_SINGLE_REGION )
+    smtc_real_const_t        constants;
+#endif
     smtc_real_ctx_t          real_ctx;
 
     union smtc_real_region_u
@@ -336,6 +338,550 @@ typedef struct smtc_real_s
 
 } smtc_real_t;
 
+/*
+ * -----------------------------------------------------------------------------
+ * --- REGIONAL PARAMETERS CONSTANTS -------------------------------------------
+ */
+
+#if defined( REGION_EU_868 )
+static const smtc_real_const_t region_eu_868_const = {
+    .const_number_of_tx_channel         = NUMBER_OF_CHANNEL_EU_868,
+    .const_number_of_rx_channel         = NUMBER_OF_CHANNEL_EU_868,
+    .const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_EU_868,
+    .const_number_of_channel_bank       = BANK_MAX_EU868,
+    .const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_EU_868,
+    .const_received_delay1              = RECEIVE_DELAY1_EU_868,
+    .const_tx_power_dbm                 = TX_POWER_EIRP_EU_868 - 2,  // EIRP to ERP
+    .const_max_tx_power_idx             = MAX_TX_POWER_IDX_EU_868,
+    .const_adr_ack_limit                = ADR_ACK_LIMIT_EU_868,
+    .const_adr_ack_delay                = ADR_ACK_DELAY_EU_868,
+    .const_datarate_offsets             = &datarate_offsets_eu_868[0][0],
+    .const_datarate_backoff             = &datarate_backoff_eu_868[0],
+    .const_ack_timeout                  = ACK_TIMEOUT_EU_868,
+    .const_freq_min                     = FREQMIN_EU_868,
+    .const_freq_max                     = FREQMAX_EU_868,
+    .const_rx2_freq                     = RX2_FREQ_EU_868,
+    .const_frequency_factor             = FREQUENCY_FACTOR_EU_868,
+    .const_rx2_dr_init                  = RX2DR_INIT_EU_868,
+    .const_sync_word_private            = SYNC_WORD_PRIVATE_EU_868,
+    .const_sync_word_public             = SYNC_WORD_PUBLIC_EU_868,
+    .const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_EU_868,
+    .const_sync_word_lr_fhss            = ( uint8_t* ) SYNC_WORD_LR_FHSS_EU_868,
+    .const_min_tx_dr                    = MIN_TX_DR_EU_868,
+    .const_max_tx_dr                    = MAX_TX_DR_EU_868,
+    .const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_EU_868,
+    .const_number_of_tx_dr              = NUMBER_OF_TX_DR_EU_868,
+    .const_min_rx_dr                    = MIN_RX_DR_EU_868,
+    .const_max_rx_dr                    = MAX_RX_DR_EU_868,
+    .const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_EU_868,
+    .const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_EU_868,
+    .const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_EU_868,
+    .const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_EU_868,
+    .const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_EU_868,
+    .const_dtc_supported                = DTC_SUPPORTED_EU_868,
+    .const_dtc_number_of_band           = BAND_EU868_MAX,
+    .const_dtc_by_band                  = &duty_cycle_by_band_eu_868[0],
+    .const_dtc_frequency_range_by_band  = &frequency_range_by_band_eu_868[0][0],
+    .const_lbt_supported                = LBT_SUPPORTED_EU_868,
+    .const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_EU_868,
+    .const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_EU_868,
+    .const_lbt_bw_hz                    = LBT_BW_HZ_EU_868,
+    .const_max_payload_m                = &M_eu_868[0],
+    .const_coding_rate                  = RAL_LORA_CR_4_5,
+    .const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_EU_868[0],
+    .const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_EU_868[0],
+    .const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_EU_868[0],
+    .const_cf_list_type_supported       = CF_LIST_SUPPORTED_EU_868,
+    .const_beacon_dr                    = BEACON_DR_EU_868,
+    .const_beacon_frequency             = BEACON_FREQ_EU_868,
+    .const_ping_slot_frequency          = PING_SLOT_FREQ_EU_868,
+};
+#endif
+
+#if defined( REGION_AS_923 )
+static const smtc_real_const_t region_as_923_const = {
+    .const_number_of_tx_channel         = NUMBER_OF_CHANNEL_AS_923,
+    .const_number_of_rx_channel         = NUMBER_OF_CHANNEL_AS_923,
+    .const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_AS_923,
+    .const_number_of_channel_bank       = BANK_MAX_AS923,
+    .const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_AS_923,
+    .const_received_delay1              = RECEIVE_DELAY1_AS_923,
+    .const_tx_power_dbm                 = TX_POWER_EIRP_AS_923 - 2,  // EIRP to ERP
+    .const_max_tx_power_idx             = MAX_TX_POWER_IDX_AS_923,
+    .const_adr_ack_limit                = ADR_ACK_LIMIT_AS_923,
+    .const_adr_ack_delay                = ADR_ACK_DELAY_AS_923,
+    .const_datarate_offsets             = &datarate_offsets_as_923[0][0][0],
+    .const_datarate_backoff             = &datarate_backoff_as_923[0][0],
+    .const_ack_timeout                  = ACK_TIMEOUT_AS_923,
+    .const_frequency_factor             = FREQUENCY_FACTOR_AS_923,
+    .const_rx2_dr_init                  = RX2DR_INIT_AS_923,
+    .const_sync_word_private            = SYNC_WORD_PRIVATE_AS_923,
+    .const_sync_word_public             = SYNC_WORD_PUBLIC_AS_923,
+    .const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_AS_923,
+    .const_min_tx_dr                    = MIN_DR_AS_923,
+    .const_max_tx_dr                    = MAX_DR_AS_923,
+    .const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_AS_923,
+    .const_min_rx_dr                    = MIN_DR_AS_923,
+    .const_max_rx_dr                    = MAX_DR_AS_923,
+    .const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_AS_923,
+    .const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_AS_923,
+    .const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_AS_923,
+    .const_number_of_tx_dr              = NUMBER_OF_TX_DR_AS_923,
+    .const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_AS_923,
+    .const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_AS_923,
+    .const_dtc_supported                = DTC_SUPPORTED_AS_923,
+    .const_lbt_supported                = LBT_SUPPORTED_AS_923,
+    .const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_AS_923,
+    .const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_AS_923,
+    .const_lbt_bw_hz                    = LBT_BW_HZ_AS_923,
+    .const_max_payload_m                = &M_as_923[0][0],
+    .const_coding_rate                  = RAL_LORA_CR_4_5,
+    .const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_AS_923[0],
+    .const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_AS_923[0],
+    .const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_AS_923[0],
+    .const_cf_list_type_supported       = CF_LIST_SUPPORTED_AS_923,
+    .const_beacon_dr                    = BEACON_DR_AS_923,
+    .const_uplink_dwell_time            = UPLINK_DWELL_TIME_AS_923,
+};
+#endif
+
+#if defined( REGION_US_915 )
+static const smtc_real_const_t region_us_915_const = {
+    .const_number_of_tx_channel         = NUMBER_OF_TX_CHANNEL_US_915,
+    .const_number_of_rx_channel         = NUMBER_OF_RX_CHANNEL_US_915,
+    .const_number_of_channel_bank       = BANK_MAX_US915,
+    .const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_US_915,
+    .const_received_delay1              = RECEIVE_DELAY1_US_915,
+    .const_tx_power_dbm                 = TX_POWER_EIRP_US_915 - 2,  // EIRP to ERP
+    .const_max_tx_power_idx             = MAX_TX_POWER_IDX_US_915,
+    .const_adr_ack_limit                = ADR_ACK_LIMIT_US_915,
+    .const_adr_ack_delay                = ADR_ACK_DELAY_US_915,
+    .const_datarate_offsets             = &datarate_offsets_us_915[0][0],
+    .const_datarate_backoff             = &datarate_backoff_us_915[0],
+    .const_ack_timeout                  = ACK_TIMEOUT_US_915,
+    .const_freq_min                     = FREQMIN_US_915,
+    .const_freq_max                     = FREQMAX_US_915,
+    .const_rx2_freq                     = RX2_FREQ_US_915,
+    .const_frequency_factor             = FREQUENCY_FACTOR_US_915,
+    .const_rx2_dr_init                  = RX2DR_INIT_US_915,
+    .const_sync_word_private            = SYNC_WORD_PRIVATE_US_915,
+    .const_sync_word_public             = SYNC_WORD_PUBLIC_US_915,
+    .const_sync_word_lr_fhss            = ( uint8_t* ) SYNC_WORD_LR_FHSS_US_915,
+    .const_min_tx_dr                    = MIN_TX_DR_US_915,
+    .const_max_tx_dr                    = MAX_TX_DR_US_915,
+    .const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_US_915,
+    .const_number_of_tx_dr              = NUMBER_OF_TX_DR_US_915,
+    .const_min_rx_dr                    = MIN_RX_DR_US_915,
+    .const_max_rx_dr                    = MAX_RX_DR_US_915,
+    .const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_US_915,
+    .const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_US_915,
+    .const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_US_915,
+    .const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_US_915,
+    .const_dtc_supported                = DTC_SUPPORTED_US_915,
+    .const_lbt_supported                = LBT_SUPPORTED_US_915,
+    .const_max_payload_m                = &M_us_915[0],
+    .const_coding_rate                  = RAL_LORA_CR_4_5,
+    .const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_US_915[0],
+    .const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_US_915[0],
+    .const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_US_915[0],
+    .const_cf_list_type_supported       = CF_LIST_SUPPORTED_US_915,
+    .const_beacon_dr                    = BEACON_DR_US_915,
+};
+#endif
+
+#if defined( REGION_AU_915 )
+static const smtc_real_const_t region_au_915_const = {
+    .const_number_of_tx_channel         = NUMBER_OF_TX_CHANNEL_AU_915,
+    .const_number_of_rx_channel         = NUMBER_OF_RX_CHANNEL_AU_915,
+    .const_number_of_channel_bank       = BANK_MAX_AU915,
+    .const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_AU_915,
+    .const_received_delay1              = RECEIVE_DELAY1_AU_915,
+    .const_tx_power_dbm                 = TX_POWER_EIRP_AU_915 - 2,  // EIRP to ERP
+    .const_max_tx_power_idx             = MAX_TX_POWER_IDX_AU_915,
+    .const_adr_ack_limit                = ADR_ACK_LIMIT_AU_915,
+    .const_adr_ack_delay                = ADR_ACK_DELAY_AU_915,
+    .const_datarate_offsets             = &datarate_offsets_au_915[0][0],
+    .const_datarate_backoff             = &datarate_backoff_au_915[0][0],
+    .const_ack_timeout                  = ACK_TIMEOUT_AU_915,
+    .const_freq_min                     = FREQMIN_AU_915,
+    .const_freq_max                     = FREQMAX_AU_915,
+    .const_rx2_freq                     = RX2_FREQ_AU_915,
+    .const_frequency_factor             = FREQUENCY_FACTOR_AU_915,
+    .const_rx2_dr_init                  = RX2DR_INIT_AU_915,
+    .const_sync_word_private            = SYNC_WORD_PRIVATE_AU_915,
+    .const_sync_word_public             = SYNC_WORD_PUBLIC_AU_915,
+    .const_sync_word_lr_fhss            = ( uint8_t* ) SYNC_WORD_LR_FHSS_AU_915,
+    .const_min_tx_dr                    = MIN_TX_DR_AU_915,
+    .const_max_tx_dr                    = MAX_TX_DR_AU_915,
+    .const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_AU_915,
+    .const_number_of_tx_dr              = NUMBER_OF_TX_DR_AU_915,
+    .const_min_rx_dr                    = MIN_RX_DR_AU_915,
+    .const_max_rx_dr                    = MAX_RX_DR_AU_915,
+    .const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_AU_915,
+    .const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_AU_915,
+    .const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_AU_915,
+    .const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_AU_923,
+    .const_dtc_supported                = DTC_SUPPORTED_AU_915,
+    .const_lbt_supported                = LBT_SUPPORTED_AU_915,
+    .const_max_payload_m                = &M_au_915[0][0],
+    .const_coding_rate                  = RAL_LORA_CR_4_5,
+    .const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_AU_915[0],
+    .const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_AU_915[0],
+    .const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_AU_915[0],
+    .const_cf_list_type_supported       = CF_LIST_SUPPORTED_AU_915,
+    .const_beacon_dr                    = BEACON_DR_AU_915,
+    .const_uplink_dwell_time            = UPLINK_DWELL_TIME_AU_915,
+};
+#endif
+
+#if defined( REGION_CN_470 )
+static const smtc_real_const_t region_cn_470_const = {
+    .const_number_of_tx_channel         = NUMBER_OF_TX_CHANNEL_CN_470,
+    .const_number_of_rx_channel         = NUMBER_OF_RX_CHANNEL_CN_470,
+    .const_number_of_channel_bank       = BANK_MAX_CN470,
+    .const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_CN_470,
+    .const_received_delay1              = RECEIVE_DELAY1_CN_470,
+    .const_tx_power_dbm                 = TX_POWER_EIRP_CN_470 - 2,  // EIRP to ERP
+    .const_max_tx_power_idx             = MAX_TX_POWER_IDX_CN_470,
+    .const_adr_ack_limit                = ADR_ACK_LIMIT_CN_470,
+    .const_adr_ack_delay                = ADR_ACK_DELAY_CN_470,
+    .const_datarate_offsets             = &datarate_offsets_cn_470[0][0],
+    .const_datarate_backoff             = &datarate_backoff_cn_470[0],
+    .const_ack_timeout                  = ACK_TIMEOUT_CN_470,
+    .const_freq_min                     = FREQMIN_CN_470,
+    .const_freq_max                     = FREQMAX_CN_470,
+    .const_frequency_factor             = FREQUENCY_FACTOR_CN_470,
+    .const_rx2_dr_init                  = RX2DR_INIT_CN_470,
+    .const_sync_word_private            = SYNC_WORD_PRIVATE_CN_470,
+    .const_sync_word_public             = SYNC_WORD_PUBLIC_CN_470,
+    .const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_CN_470,
+    .const_min_tx_dr                    = MIN_TX_DR_CN_470,
+    .const_max_tx_dr                    = MAX_TX_DR_CN_470,
+    .const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_CN_470,
+    .const_number_of_tx_dr              = NUMBER_OF_TX_DR_CN_470,
+    .const_min_rx_dr                    = MIN_RX_DR_CN_470,
+    .const_max_rx_dr                    = MAX_RX_DR_CN_470,
+    .const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_CN_470,
+    .const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_CN_470,
+    .const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_CN_470,
+    .const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_CN_470,
+    .const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_CN_470,
+    .const_dtc_supported                = DTC_SUPPORTED_CN_470,
+    .const_lbt_supported                = LBT_SUPPORTED_CN_470,
+    .const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_CN_470,
+    .const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_CN_470,
+    .const_lbt_bw_hz                    = LBT_BW_HZ_CN_470,
+    .const_max_payload_m                = &M_cn_470[0],
+    .const_coding_rate                  = RAL_LORA_CR_4_5,
+    .const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_CN_470[0],
+    .const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_CN_470[0],
+    .const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_CN_470[0],
+    .const_cf_list_type_supported       = CF_LIST_SUPPORTED_CN_470,
+    .const_beacon_dr                    = BEACON_DR_CN_470,
+};
+#endif
+
+#if defined( REGION_WW2G4 )
+static const smtc_real_const_t region_ww2g4_const = {
+    .const_number_of_tx_channel         = NUMBER_OF_CHANNEL_WW2G4,
+    .const_number_of_rx_channel         = NUMBER_OF_CHANNEL_WW2G4,
+    .const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_WW2G4,
+    .const_number_of_channel_bank       = BANK_MAX_WW2G4,
+    .const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_WW2G4,
+    .const_received_delay1              = RECEIVE_DELAY1_WW2G4,
+    .const_tx_power_dbm                 = TX_POWER_EIRP_WW2G4 - 2,  // EIRP to ERP
+    .const_max_tx_power_idx             = MAX_TX_POWER_IDX_WW2G4,
+    .const_adr_ack_limit                = ADR_ACK_LIMIT_WW2G4,
+    .const_adr_ack_delay                = ADR_ACK_DELAY_WW2G4,
+    .const_datarate_offsets             = &datarate_offsets_ww2g4[0][0],
+    .const_datarate_backoff             = &datarate_backoff_ww2g4[0],
+    .const_ack_timeout                  = ACK_TIMEOUT_WW2G4,
+    .const_freq_min                     = FREQMIN_WW2G4,
+    .const_freq_max                     = FREQMAX_WW2G4,
+    .const_rx2_freq                     = RX2_FREQ_WW2G4,
+    .const_frequency_factor             = FREQUENCY_FACTOR_WW2G4,
+    .const_rx2_dr_init                  = RX2DR_INIT_WW2G4,
+    .const_sync_word_private            = SYNC_WORD_PRIVATE_WW2G4,
+    .const_sync_word_public             = SYNC_WORD_PUBLIC_WW2G4,
+    .const_min_tx_dr                    = MIN_DR_WW2G4,
+    .const_max_tx_dr                    = MAX_DR_WW2G4,
+    .const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_WW2G4,
+    .const_min_rx_dr                    = MIN_DR_WW2G4,
+    .const_max_rx_dr                    = MAX_DR_WW2G4,
+    .const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_WW2G4,
+    .const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_WW2G4,
+    .const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_WW2G4,
+    .const_number_of_tx_dr              = NUMBER_OF_TX_DR_WW2G4,
+    .const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_WW2G4,
+    .const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_WW2G4,
+    .const_dtc_supported                = DTC_SUPPORTED_WW2G4,
+    .const_lbt_supported                = LBT_SUPPORTED_WW2G4,
+    .const_max_payload_m                = &M_ww2g4[0],
+    .const_coding_rate                  = RAL_LORA_CR_LI_4_8,
+#if defined( WW2G4_SINGLE_DATARATE )
+    .const_mobile_lowpower_dr_distri    = &DEFAULT_DR_DISTRIBUTION_WW2G4[0],
+    .const_mobile_longrange_dr_distri   = &DEFAULT_DR_DISTRIBUTION_WW2G4[0],
+#else
+    .const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_WW2G4[0],
+    .const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_WW2G4[0],
+#endif
+    .const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_WW2G4[0],
+    .const_cf_list_type_supported       = CF_LIST_SUPPORTED_WW2G4,
+    .const_beacon_dr                    = BEACON_DR_WW2G4,
+    .const_beacon_frequency             = BEACON_FREQ_WW2G4,
+    .const_ping_slot_frequency          = PING_SLOT_FREQ_WW2G4,
+};
+#endif
+
+#if defined( REGION_IN_865 )
+static const smtc_real_const_t region_in_865_const = {
+    .const_number_of_tx_channel         = NUMBER_OF_CHANNEL_IN_865,
+    .const_number_of_rx_channel         = NUMBER_OF_CHANNEL_IN_865,
+    .const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_IN_865,
+    .const_number_of_channel_bank       = BANK_MAX_IN865,
+    .const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_IN_865,
+    .const_received_delay1              = RECEIVE_DELAY1_IN_865,
+    .const_tx_power_dbm                 = TX_POWER_EIRP_IN_865 - 2,  // EIRP to ERP
+    .const_max_tx_power_idx             = MAX_TX_POWER_IDX_IN_865,
+    .const_adr_ack_limit                = ADR_ACK_LIMIT_IN_865,
+    .const_adr_ack_delay                = ADR_ACK_DELAY_IN_865,
+    .const_datarate_offsets             = &datarate_offsets_in_865[0][0],
+    .const_datarate_backoff             = &datarate_backoff_in_865[0],
+    .const_ack_timeout                  = ACK_TIMEOUT_IN_865,
+    .const_frequency_factor             = FREQUENCY_FACTOR_IN_865,
+    .const_freq_min                     = FREQMIN_IN_865,
+    .const_freq_max                     = FREQMAX_IN_865,
+    .const_rx2_freq                     = RX2_FREQ_IN_865,
+    .const_rx2_dr_init                  = RX2DR_INIT_IN_865,
+    .const_sync_word_private            = SYNC_WORD_PRIVATE_IN_865,
+    .const_sync_word_public             = SYNC_WORD_PUBLIC_IN_865,
+    .const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_IN_865,
+    .const_min_tx_dr                    = MIN_DR_IN_865,
+    .const_max_tx_dr                    = MAX_DR_IN_865,
+    .const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_IN_865,
+    .const_number_of_tx_dr              = NUMBER_OF_TX_DR_IN_865,
+    .const_min_rx_dr                    = MIN_DR_IN_865,
+    .const_max_rx_dr                    = MAX_DR_IN_865,
+    .const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_IN_865,
+    .const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_IN_865,
+    .const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_IN_865,
+    .const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_IN_865,
+    .const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_IN_865,
+    .const_dtc_supported                = DTC_SUPPORTED_IN_865,
+    .const_lbt_supported                = LBT_SUPPORTED_IN_865,
+    .const_max_payload_m                = &M_in_865[0],
+    .const_coding_rate                  = RAL_LORA_CR_4_5,
+    .const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_IN_865[0],
+    .const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_IN_865[0],
+    .const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_IN_865[0],
+    .const_cf_list_type_supported       = CF_LIST_SUPPORTED_IN_865,
+    .const_beacon_dr                    = BEACON_DR_IN_865,
+    .const_beacon_frequency             = BEACON_FREQ_IN_865,
+    .const_ping_slot_frequency          = PING_SLOT_FREQ_IN_865,
+};
+#endif
+
+#if defined( REGION_KR_920 )
+static const smtc_real_const_t region_kr_920_const = {
+    .const_number_of_tx_channel         = NUMBER_OF_CHANNEL_KR_920,
+    .const_number_of_rx_channel         = NUMBER_OF_CHANNEL_KR_920,
+    .const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_KR_920,
+    .const_number_of_channel_bank       = BANK_MAX_KR920,
+    .const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_KR_920,
+    .const_received_delay1              = RECEIVE_DELAY1_KR_920,
+    .const_tx_power_dbm                 = TX_POWER_EIRP_KR_920 - 2,  // EIRP to ERP
+    .const_max_tx_power_idx             = MAX_TX_POWER_IDX_KR_920,
+    .const_adr_ack_limit                = ADR_ACK_LIMIT_KR_920,
+    .const_adr_ack_delay                = ADR_ACK_DELAY_KR_920,
+    .const_datarate_offsets             = &datarate_offsets_kr_920[0][0],
+    .const_datarate_backoff             = &datarate_backoff_kr_920[0],
+    .const_ack_timeout                  = ACK_TIMEOUT_KR_920,
+    .const_frequency_factor             = FREQUENCY_FACTOR_KR_920,
+    .const_freq_min                     = FREQMIN_KR_920,
+    .const_freq_max                     = FREQMAX_KR_920,
+    .const_rx2_freq                     = RX2_FREQ_KR_920,
+    .const_rx2_dr_init                  = RX2DR_INIT_KR_920,
+    .const_sync_word_private            = SYNC_WORD_PRIVATE_KR_920,
+    .const_sync_word_public             = SYNC_WORD_PUBLIC_KR_920,
+    .const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_KR_920,
+    .const_min_tx_dr                    = MIN_DR_KR_920,
+    .const_max_tx_dr                    = MAX_DR_KR_920,
+    .const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_KR_920,
+    .const_min_rx_dr                    = MIN_DR_KR_920,
+    .const_max_rx_dr                    = MAX_DR_KR_920,
+    .const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_KR_920,
+    .const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_KR_920,
+    .const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_KR_920,
+    .const_number_of_tx_dr              = NUMBER_OF_TX_DR_KR_920,
+    .const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_KR_920,
+    .const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_KR_920,
+    .const_dtc_supported                = DTC_SUPPORTED_KR_920,
+    .const_lbt_supported                = LBT_SUPPORTED_KR_920,
+    .const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_KR_920,
+    .const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_KR_920,
+    .const_lbt_bw_hz                    = LBT_BW_HZ_KR_920,
+    .const_max_payload_m                = &M_kr_920[0],
+    .const_coding_rate                  = RAL_LORA_CR_4_5,
+    .const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_KR_920[0],
+    .const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_KR_920[0],
+    .const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_KR_920[0],
+    .const_cf_list_type_supported       = CF_LIST_SUPPORTED_KR_920,
+    .const_beacon_dr                    = BEACON_DR_KR_920,
+    .const_beacon_frequency             = BEACON_FREQ_KR_920,
+    .const_ping_slot_frequency          = PING_SLOT_FREQ_KR_920,
+};
+#endif
+
+#if defined( REGION_RU_864 )
+static const smtc_real_const_t region_ru_864_const = {
+    .const_number_of_tx_channel         = NUMBER_OF_CHANNEL_RU_864,
+    .const_number_of_rx_channel         = NUMBER_OF_CHANNEL_RU_864,
+    .const_number_of_boot_tx_channel    = NUMBER_OF_BOOT_TX_CHANNEL_RU_864,
+    .const_number_of_channel_bank       = BANK_MAX_RU864,
+    .const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_RU_864,
+    .const_received_delay1              = RECEIVE_DELAY1_RU_864,
+    .const_tx_power_dbm                 = TX_POWER_EIRP_RU_864 - 2,  // EIRP to ERP
+    .const_max_tx_power_idx             = MAX_TX_POWER_IDX_RU_864,
+    .const_adr_ack_limit                = ADR_ACK_LIMIT_RU_864,
+    .const_adr_ack_delay                = ADR_ACK_DELAY_RU_864,
+    .const_datarate_offsets             = &datarate_offsets_ru_864[0][0],
+    .const_datarate_backoff             = &datarate_backoff_ru_864[0],
+    .const_ack_timeout                  = ACK_TIMEOUT_RU_864,
+    .const_freq_min                     = FREQMIN_RU_864,
+    .const_freq_max                     = FREQMAX_RU_864,
+    .const_rx2_freq                     = RX2_FREQ_RU_864,
+    .const_frequency_factor             = FREQUENCY_FACTOR_RU_864,
+    .const_rx2_dr_init                  = RX2DR_INIT_RU_864,
+    .const_sync_word_private            = SYNC_WORD_PRIVATE_RU_864,
+    .const_sync_word_public             = SYNC_WORD_PUBLIC_RU_864,
+    .const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_RU_864,
+    .const_min_tx_dr                    = MIN_DR_RU_864,
+    .const_max_tx_dr                    = MAX_DR_RU_864,
+    .const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_RU_864,
+    .const_number_of_tx_dr              = NUMBER_OF_TX_DR_RU_864,
+    .const_min_rx_dr                    = MIN_DR_RU_864,
+    .const_max_rx_dr                    = MAX_DR_RU_864,
+    .const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_RU_864,
+    .const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_RU_864,
+    .const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_RU_864,
+    .const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_RU_864,
+    .const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_RU_864,
+    .const_dtc_supported                = DTC_SUPPORTED_RU_864,
+    .const_dtc_number_of_band           = BAND_RU864_MAX,
+    .const_dtc_by_band                  = &duty_cycle_by_band_ru_864[0],
+    .const_dtc_frequency_range_by_band  = &frequency_range_by_band_ru_864[0][0],
+    .const_lbt_supported                = LBT_SUPPORTED_RU_864,
+    .const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_RU_864,
+    .const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_RU_864,
+    .const_lbt_bw_hz                    = LBT_BW_HZ_RU_864,
+    .const_max_payload_m                = &M_ru_864[0],
+    .const_coding_rate                  = RAL_LORA_CR_4_5,
+    .const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_RU_864[0],
+    .const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_RU_864[0],
+    .const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_RU_864[0],
+    .const_cf_list_type_supported       = CF_LIST_SUPPORTED_RU_864,
+    .const_beacon_dr                    = BEACON_DR_RU_864,
+    .const_beacon_frequency             = BEACON_FREQ_RU_864,
+    .const_ping_slot_frequency          = PING_SLOT_FREQ_RU_864,
+};
+#endif
+
+#if defined( REGION_CN_470_RP_1_0 )
+static const smtc_real_const_t region_cn_470_rp_1_0_const = {
+    .const_number_of_tx_channel         = NUMBER_OF_TX_CHANNEL_CN_470_RP_1_0,
+    .const_number_of_rx_channel         = NUMBER_OF_RX_CHANNEL_CN_470_RP_1_0,
+    .const_number_of_channel_bank       = BANK_MAX_CN470_RP_1_0,
+    .const_join_accept_delay1           = JOIN_ACCEPT_DELAY1_CN_470_RP_1_0,
+    .const_received_delay1              = RECEIVE_DELAY1_CN_470_RP_1_0,
+    .const_tx_power_dbm                 = TX_POWER_EIRP_CN_470_RP_1_0 - 2,  // EIRP to ERP
+    .const_max_tx_power_idx             = MAX_TX_POWER_IDX_CN_470_RP_1_0,
+    .const_adr_ack_limit                = ADR_ACK_LIMIT_CN_470_RP_1_0,
+    .const_adr_ack_delay                = ADR_ACK_DELAY_CN_470_RP_1_0,
+    .const_datarate_offsets             = &datarate_offsets_cn_470_rp_1_0[0][0],
+    .const_datarate_backoff             = &datarate_backoff_cn_470_rp_1_0[0],
+    .const_ack_timeout                  = ACK_TIMEOUT_CN_470_RP_1_0,
+    .const_freq_min                     = FREQMIN_CN_470_RP_1_0,
+    .const_freq_max                     = FREQMAX_CN_470_RP_1_0,
+    .const_rx2_freq                     = RX2_FREQ_CN_470_RP_1_0,
+    .const_frequency_factor             = FREQUENCY_FACTOR_CN_470_RP_1_0,
+    .const_rx2_dr_init                  = RX2DR_INIT_CN_470_RP_1_0,
+    .const_sync_word_private            = SYNC_WORD_PRIVATE_CN_470_RP_1_0,
+    .const_sync_word_public             = SYNC_WORD_PUBLIC_CN_470_RP_1_0,
+    .const_sync_word_gfsk               = ( uint8_t* ) SYNC_WORD_GFSK_CN_470_RP_1_0,
+    .const_min_tx_dr                    = MIN_TX_DR_CN_470_RP_1_0,
+    .const_max_tx_dr                    = MAX_TX_DR_CN_470_RP_1_0,
+    .const_min_tx_dr_limit              = MIN_TX_DR_LIMIT_CN_470_RP_1_0,
+    .const_number_of_tx_dr              = NUMBER_OF_TX_DR_CN_470_RP_1_0,
+    .const_min_rx_dr                    = MIN_RX_DR_CN_470_RP_1_0,
+    .const_max_rx_dr                    = MAX_RX_DR_CN_470_RP_1_0,
+    .const_number_rx1_dr_offset         = NUMBER_RX1_DR_OFFSET_CN_470_RP_1_0,
+    .const_dr_bitfield                  = DR_BITFIELD_SUPPORTED_CN_470_RP_1_0,
+    .const_default_tx_dr_bit_field      = DEFAULT_TX_DR_BIT_FIELD_CN_470_RP_1_0,
+    .const_tx_param_setup_req_supported = TX_PARAM_SETUP_REQ_SUPPORTED_CN_470_RP_1_0,
+    .const_new_channel_req_supported    = NEW_CHANNEL_REQ_SUPPORTED_CN_470_RP_1_0,
+    .const_dtc_supported                = DTC_SUPPORTED_CN_470_RP_1_0,
+    .const_lbt_supported                = LBT_SUPPORTED_CN_470_RP_1_0,
+    .const_lbt_sniff_duration_ms        = LBT_SNIFF_DURATION_MS_CN_470_RP_1_0,
+    .const_lbt_threshold_dbm            = LBT_THRESHOLD_DBM_CN_470_RP_1_0,
+    .const_lbt_bw_hz                    = LBT_BW_HZ_CN_470_RP_1_0,
+    .const_max_payload_m                = &M_cn_470_rp_1_0[0],
+    .const_coding_rate                  = RAL_LORA_CR_4_5,
+    .const_mobile_longrange_dr_distri   = &MOBILE_LONGRANGE_DR_DISTRIBUTION_CN_470_RP_1_0[0],
+    .const_mobile_lowpower_dr_distri    = &MOBILE_LOWPER_DR_DISTRIBUTION_CN_470_RP_1_0[0],
+    .const_default_dr_distri            = &DEFAULT_DR_DISTRIBUTION_CN_470_RP_1_0[0],
+    .const_cf_list_type_supported       = CF_LIST_SUPPORTED_CN_470_RP_1_0,
+    .const_beacon_dr                    = BEACON_DR_CN_470_RP_1_0,
+};
+#endif
+
+/**
+ * Access to the regional constants and region type of a real object
+ *
+ * When SMTC_REAL_SINGLE_REGION is defined, exactly one region is bound at build time: its constants are read directly
+ * from the static const table above (no RAM copy per stack) and region dispatch switches on a compile-time value.
+ */
+#if defined( SMTC_REAL_SINGLE_REGION )
+#if( defined( REGION_EU_868 ) + defined( REGION_AS_923 ) + defined( REGION_US_915 ) + defined( REGION_AU_915 ) + \
+     defined( REGION_CN_470 ) + defined( REGION_WW2G4 ) + defined( REGION_IN_865 ) + defined( REGION_KR_920 ) +   \
+     defined( REGION_RU_864 ) + defined( REGION_CN_470_RP_1_0 ) ) != 1
+#error "SMTC_REAL_SINGLE_REGION requires exactly one region to be compiled"
+#endif
+#if defined( REGION_EU_868 )
+#define SMTC_REAL_SINGLE_REGION_TYPE SMTC_REAL_REGION_EU_868
+#define SMTC_REAL_SINGLE_REGION_CONST region_eu_868_const
+#elif defined( REGION_AS_923 )
+#error "SMTC_REAL_SINGLE_REGION is not available for AS_923: the frequency group is selected at runtime"
+#elif defined( REGION_US_915 )
+#define SMTC_REAL_SINGLE_REGION_TYPE SMTC_REAL_REGION_US_915
+#define SMTC_REAL_SINGLE_REGION_CONST region_us_915_const
+#elif defined( REGION_AU_915 )
+#define SMTC_REAL_SINGLE_REGION_TYPE SMTC_REAL_REGION_AU_915
+#define SMTC_REAL_SINGLE_REGION_CONST region_au_915_const
+#elif defined( REGION_CN_470 )
+#error "SMTC_REAL_SINGLE_REGION is not available for CN_470: the channel plan is selected at runtime"
+#elif defined( REGION_WW2G4 )
+#define SMTC_REAL_SINGLE_REGION_TYPE SMTC_REAL_REGION_WW2G4
+#define SMTC_REAL_SINGLE_REGION_CONST region_ww2g4_const
+#elif defined( REGION_IN_865 )
+#define SMTC_REAL_SINGLE_REGION_TYPE SMTC_REAL_REGION_IN_865
+#define SMTC_REAL_SINGLE_REGION_CONST region_in_865_const
+#elif defined( REGION_KR_920 )
+#define SMTC_REAL_SINGLE_REGION_TYPE SMTC_REAL_REGION_KR_920
+#define SMTC_REAL_SINGLE_REGION_CONST region_kr_920_const
+#elif defined( REGION_RU_864 )
+#define SMTC_REAL_SINGLE_REGION_TYPE SMTC_REAL_REGION_RU_864
+#define SMTC_REAL_SINGLE_REGION_CONST region_ru_864_const
+#elif defined( REGION_CN_470_RP_1_0 )
+#define SMTC_REAL_SINGLE_REGION_TYPE SMTC_REAL_REGION_CN_470_RP_1_0
+#define SMTC_REAL_SINGLE_REGION_CONST region_cn_470_rp_1_0_const
+#endif
+#define SMTC_REAL_CONST( real ) ( SMTC_REAL_SINGLE_REGION_CONST )
+#define SMTC_REAL_REGION_TYPE( real ) ( SMTC_REAL_SINGLE_REGION_TYPE )
+#else
+#define SMTC_REAL_CONST( real ) ( ( real )->constants )
+#define SMTC_REAL_REGION_TYPE( real ) ( ( real )->region_type )
+#endif
+
 #ifdef __cplusplus
 }
 #endif
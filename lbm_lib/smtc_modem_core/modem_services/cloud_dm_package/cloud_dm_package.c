@@ -1515,8 +1515,8 @@ static bool dm_status_payload( cloud_dm_t* ctx, uint8_t stack_id, uint8_t* dm_up
             }
 #if defined( ADD_SMTC_STREAM )
             case DM_INFO_STREAMPAR:
-                *p_tmp         = stream_get_port( stack_id );
-                *( p_tmp + 1 ) = stream_encrypted_mode( stack_id );
+                *p_tmp         = stream_get_port( stack_id, 0 );
+                *( p_tmp + 1 ) = stream_encrypted_mode( stack_id, 0 );
                 break;
 #endif  // ADD_SMTC_STREAM
             case DM_INFO_APPSTATUS:
@@ -131,6 +131,18 @@
 // number of words per chunk
 #define CHUNK_NW ( 2 )
 
+// number of chunks combined at once when generating a fragment, divides 32
+#define CHUNK_GROUP_SIZE ( 4 )
+
+// Fragment maximum size (3 bytes header followed by the chunks)
+#define FILE_UPLOAD_MAX_FRAGMENT_SIZE ( 100 )
+#define FILE_UPLOAD_MAX_FRAGMENT_CHUNKS ( ( FILE_UPLOAD_MAX_FRAGMENT_SIZE - 3 ) / ( CHUNK_NW * 4 ) )
+
+// The file is read by windows of SHA-256 block size, also a multiple of AES block size
+#define FILE_UPLOAD_WINDOW_SIZE ( 64 )
+#define FILE_UPLOAD_WINDOW_NW ( FILE_UPLOAD_WINDOW_SIZE / 4 )
+#define FILE_UPLOAD_NO_WINDOW ( 0xFFFF )
+
 #define FILE_UPLOAD_TOKEN 0x0E
 #define FILE_UPLOAD_DIRECTION 0x40
 
@@ -156,17 +168,20 @@ typedef enum lfu_state_e
 
 typedef struct file_upload_s
 {
-    uint8_t   sid;                   // Session Id (2bits)
-    uint16_t  average_delay;         // average frame transmission rate/delay
-    uint8_t   port;                  // applicative port on which the upload is done
-    bool      encrypt_with_appskey;  // file upload encryption option
-    uint8_t   session_counter;       // session counter
-    uint32_t* file_buf;              // data buffer
-    uint32_t  file_len;              // file len
-    uint32_t  header[3];             // Current file upload header
-    uint16_t  cct;                   // chunk count
-    uint16_t  cntx;                  // chunk transmission count
-    uint8_t   fntx;                  // frame transmission count
+    uint8_t                       sid;                   // Session Id (2bits)
+    uint16_t                      average_delay;         // average frame transmission rate/delay
+    uint8_t                       port;                  // applicative port on which the upload is done
+    bool                          encrypt_with_appskey;  // file upload encryption option
+    uint8_t                       session_counter;       // session counter
+    uint32_t*                     file_buf;              // data buffer, NULL when the file is read by callback
+    smtc_modem_file_upload_read_f read_callback;         // file read callback
+    bool                          encrypt_on_read;       // file is encrypted each time it is read
+    uint8_t                       nonce[14];             // encryption nonce
+    uint32_t                      file_len;              // file len
+    uint32_t                      header[3];             // Current file upload header
+    uint16_t                      cct;                   // chunk count
+    uint16_t                      cntx;                  // chunk transmission count
+    uint8_t                       fntx;                  // frame transmission count
 
 } file_upload_t;
 
@@ -185,6 +200,24 @@ typedef struct lfu_service_ctx_s
     lfu_ctx_t lfu_ctx[NUMBER_MAX_OF_LFU_OBJ];
 } lfu_service_ctx_t;
 
+/**
+ * @brief Window of the file (plain or encrypted, zero padded after the end of file)
+ */
+typedef struct file_upload_window_s
+{
+    uint32_t words[FILE_UPLOAD_WINDOW_NW];
+    uint16_t index;  // Window index in the file, FILE_UPLOAD_NO_WINDOW if not read yet
+} file_upload_window_t;
+
+/**
+ * @brief Incremental SHA-256 context
+ */
+typedef struct sha256_ctx_s
+{
+    uint32_t state[8];
+    uint32_t len;  // Number of bytes hashed so far
+} sha256_ctx_t;
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE VARIABLES -------------------------------------------------------
@@ -205,6 +238,23 @@ static uint8_t    lfu_service_downlink_handler( lr1_stack_mac_down_data_t* rx_do
 static lfu_ctx_t* lfu_get_ctx_from_stack_id( uint8_t stack_id, uint8_t* service_id );
 static void       lfu_add_task( lfu_ctx_t* ctx, uint32_t delay_in_s );
 
+/**
+ * @brief Create the file upload session from a RAM buffer or a read callback
+ *
+ * @param [in] stack_id       Stack Identifier
+ * @param [in] file           File buffer, NULL when read_callback is used
+ * @param [in] read_callback  File read callback, NULL when file is used
+ * @param [in] file_len       size of file
+ * @param [in] average_delay  average delay between each uplink frame
+ * @param [in] port           applicative where the data will be forwarded
+ * @param [in] encryption     Encryption with appskey option
+ * @return file_upload_return_code_t
+ */
+static file_upload_return_code_t file_upload_init_session( uint8_t stack_id, const uint8_t* file,
+                                                           smtc_modem_file_upload_read_f read_callback,
+                                                           uint32_t file_len, uint16_t average_delay, uint8_t port,
+                                                           bool encryption );
+
 // file upload management
 /**
  * @brief Process the downlink frame FILEDONE
@@ -228,13 +278,13 @@ file_upload_return_code_t file_upload_prepare_upload( lfu_ctx_t* ctx );
 /**
  * @brief File upload fragment generation
  *
- * @param [in] file_upload Pointer to File Upload context
- * @param [in] buf         buffer that will contain the fragment
- * @param [in] len         buffer size
- * @param [in] fcnt        frame counter
+ * @param [in] ctx  Pointer to LFU context
+ * @param [in] buf  buffer that will contain the fragment
+ * @param [in] len  buffer size
+ * @param [in] fcnt frame counter
  * @return int32_t Return the number of pending byte(s)
  */
-int32_t file_upload_get_fragment( file_upload_t* file_upload, uint8_t* buf, int32_t len, uint32_t fcnt );
+int32_t file_upload_get_fragment( lfu_ctx_t* ctx, uint8_t* buf, int32_t len, uint32_t fcnt );
 
 /**
  * @brief Check if there are remaining file data that need to be sent
@@ -248,17 +298,38 @@ bool file_upload_is_data_remaining( file_upload_t* file_upload );
 // Algo
 static uint32_t phash( uint32_t x );
 static uint32_t checkbits( uint32_t cid, uint32_t cct, uint32_t i );
-static void     function_xor( uint32_t* dst, uint32_t* src, int32_t nw );
-static void     gen_chunk( file_upload_t* file_upload, uint32_t* dst, uint32_t* src, uint32_t cct, uint32_t cid );
+static void     gen_chunks( lfu_ctx_t* ctx, uint32_t dst[][CHUNK_NW], uint32_t nb_chunks, uint32_t cid );
+static void     get_chunk( lfu_ctx_t* ctx, file_upload_window_t* window, uint32_t i, uint32_t* chunk );
+
+/**
+ * @brief Read a window of the file, zero padded after the end of file and encrypted if requested
+ *
+ * @param [in]  ctx    Pointer to LFU context
+ * @param [out] window Window to be filled
+ * @param [in]  index  Window index in the file
+ * @return uint32_t Number of file bytes in the window
+ */
+static uint32_t file_upload_read_window( lfu_ctx_t* ctx, file_upload_window_t* window, uint16_t index );
+
+/**
+ * @brief Compute SHA256 of the file as currently read, window by window
+ *
+ * @param [in]  ctx  Pointer to LFU context
+ * @param [out] hash Contains the computed hash
+ */
+static void file_upload_hash( lfu_ctx_t* ctx, uint32_t* hash );
 
 /**
- * @brief Compute SHA256
+ * @brief Incremental SHA256: init, update with whole 64 bytes blocks, final with the remaining bytes
  *
+ * @param [in] sha  SHA256 context
  * @param [in] hash Contains the computed hash
  * @param [in] msg  input buffer
- * @param [in] len  input buffer length
+ * @param [in] len  input buffer length, multiple of 64 for sha256_update
  */
-static void sha256( uint32_t* hash, const uint8_t* msg, uint32_t len );
+static void sha256_init( sha256_ctx_t* sha );
+static void sha256_update( sha256_ctx_t* sha, const uint8_t* msg, uint32_t len );
+static void sha256_final( sha256_ctx_t* sha, uint32_t* hash, const uint8_t* msg, uint32_t len );
 
 /*
  * -----------------------------------------------------------------------------
@@ -300,49 +371,14 @@ void lfu_services_init( uint8_t* service_id, uint8_t task_id,
 file_upload_return_code_t file_upload_init( uint8_t stack_id, const uint8_t* file, uint32_t file_len,
                                             uint16_t average_delay, uint8_t port, bool encryption )
 {
-    IS_VALID_STACK_ID( stack_id );
-    uint8_t    service_id;
-    lfu_ctx_t* ctx = lfu_get_ctx_from_stack_id( stack_id, &service_id );
-    SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
-
-    if( file_len > FILE_UPLOAD_MAX_SIZE )
-    {
-        SMTC_MODEM_HAL_TRACE_ERROR( "FileUpload is too large (%d > %d )\n", file_len, FILE_UPLOAD_MAX_SIZE );
-        return FILE_UPLOAD_ERROR_SIZE;
-    }
-    if( file_len == 0 )
-    {
-        SMTC_MODEM_HAL_TRACE_ERROR( "File Upload size shall be different from 0\n" );
-        return FILE_UPLOAD_ERROR_SIZE;
-    }
-    if( ctx->state != LFU_NOT_INIT )
-    {
-        SMTC_MODEM_HAL_TRACE_ERROR( "File Upload still in going\n" );
-        return FILE_UPLOAD_ERROR_BUSY;
-    }
-
-    uint16_t sz_tmp = file_len + FILE_UPLOAD_HEADER_SIZE;
-    uint32_t cct    = ( sz_tmp + ( ( 4 * CHUNK_NW ) - 1 ) ) / ( 4 * CHUNK_NW );
-
-    ctx->lfu.sid                  = UPLOAD_SID & 0x3;
-    ctx->lfu.session_counter      = ( ctx->lfu.session_counter + 1 ) & 0xf;
-    ctx->lfu.encrypt_with_appskey = encryption;
-    ctx->lfu.average_delay        = average_delay;
-    ctx->lfu.port                 = port;
-    ctx->lfu.file_len             = file_len;
-    ctx->lfu.file_buf             = ( uint32_t* ) file;
-    ctx->lfu.cct                  = cct;
-    ctx->lfu.cntx                 = 0;
-    ctx->lfu.fntx                 = 0;
-    ctx->lfu.header[0] =
-        ( port ) + ( encryption << 8 ) + ( ( file_len & 0xFF ) << 16 ) + ( ( ( file_len & 0xFF00 ) >> 8 ) << 24 );
-
-    ctx->state = LFU_INIT_AND_FILLED;
-
-    SMTC_MODEM_HAL_TRACE_PRINTF( "File Upload Init done: cipher_mode: %d, size:%d, average_delay:%d, index:%d\n",
-                                 encryption, file_len, average_delay, port );
+    return file_upload_init_session( stack_id, file, NULL, file_len, average_delay, port, encryption );
+}
 
-    return FILE_UPLOAD_OK;
+file_upload_return_code_t file_upload_init_from_callback( uint8_t stack_id, smtc_modem_file_upload_read_f read_callback,
+                                                          uint32_t file_len, uint16_t average_delay, uint8_t port,
+                                                          bool encryption )
+{
+    return file_upload_init_session( stack_id, NULL, read_callback, file_len, average_delay, port, encryption );
 }
 
 file_upload_return_code_t file_upload_start( uint8_t stack_id )
@@ -431,8 +467,8 @@ static void lfu_service_on_launch( void* service_id )
     SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( " %d service_id %d \n", __func__, idx );
     IS_VALID_OBJECT_ID( idx );
 
-    int32_t file_upload_chunk_size         = 0;
-    uint8_t file_upload_chunk_payload[242] = { 0 };
+    int32_t  file_upload_chunk_size = 0;
+    uint8_t* file_upload_chunk_payload;
 
     if( lorawan_api_isjoined( lfu_ctx[idx].stack_id ) != JOINED )
     {
@@ -452,10 +488,19 @@ static void lfu_service_on_launch( void* service_id )
         SMTC_MODEM_HAL_TRACE_ERROR( "No File upload on going \n" );
         return;
     }
+
+    // Chunk is built directly in the stack tx buffer
+    file_upload_chunk_payload = lorawan_api_payload_buffer_get( lfu_ctx[idx].stack_id );
+    if( file_upload_chunk_payload == NULL )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "Stack busy \n" );
+        return;
+    }
     uint32_t max_payload_size = lorawan_api_next_max_payload_length_get( lfu_ctx[idx].stack_id );
-    file_upload_chunk_size    = file_upload_get_fragment( &lfu_ctx[idx].lfu, file_upload_chunk_payload,
-                                                       ( max_payload_size > 100 ) ? 100 : max_payload_size,
-                                                          lorawan_api_fcnt_up_get( lfu_ctx[idx].stack_id ) );
+    file_upload_chunk_size    = file_upload_get_fragment(
+        &lfu_ctx[idx], file_upload_chunk_payload,
+        ( max_payload_size > FILE_UPLOAD_MAX_FRAGMENT_SIZE ) ? FILE_UPLOAD_MAX_FRAGMENT_SIZE : max_payload_size,
+        lorawan_api_fcnt_up_get( lfu_ctx[idx].stack_id ) );
     if( file_upload_chunk_size > 0 )
     {
         uint8_t dm_port;
@@ -592,19 +637,72 @@ static void lfu_add_task( lfu_ctx_t* ctx, uint32_t delay_in_s )
     modem_supervisor_add_task( &lfu_task );
 }
 
+static file_upload_return_code_t file_upload_init_session( uint8_t stack_id, const uint8_t* file,
+                                                           smtc_modem_file_upload_read_f read_callback,
+                                                           uint32_t file_len, uint16_t average_delay, uint8_t port,
+                                                           bool encryption )
+{
+    IS_VALID_STACK_ID( stack_id );
+    uint8_t    service_id;
+    lfu_ctx_t* ctx = lfu_get_ctx_from_stack_id( stack_id, &service_id );
+    SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
+
+    if( file_len > FILE_UPLOAD_MAX_SIZE )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "FileUpload is too large (%d > %d )\n", file_len, FILE_UPLOAD_MAX_SIZE );
+        return FILE_UPLOAD_ERROR_SIZE;
+    }
+    if( file_len == 0 )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "File Upload size shall be different from 0\n" );
+        return FILE_UPLOAD_ERROR_SIZE;
+    }
+    if( ctx->state != LFU_NOT_INIT )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "File Upload still in going\n" );
+        return FILE_UPLOAD_ERROR_BUSY;
+    }
+
+    uint16_t sz_tmp = file_len + FILE_UPLOAD_HEADER_SIZE;
+    uint32_t cct    = ( sz_tmp + ( ( 4 * CHUNK_NW ) - 1 ) ) / ( 4 * CHUNK_NW );
+
+    ctx->lfu.sid                  = UPLOAD_SID & 0x3;
+    ctx->lfu.session_counter      = ( ctx->lfu.session_counter + 1 ) & 0xf;
+    ctx->lfu.encrypt_with_appskey = encryption;
+    ctx->lfu.average_delay        = average_delay;
+    ctx->lfu.port                 = port;
+    ctx->lfu.file_len             = file_len;
+    ctx->lfu.file_buf             = ( uint32_t* ) file;
+    ctx->lfu.read_callback        = read_callback;
+    ctx->lfu.encrypt_on_read      = false;
+    ctx->lfu.cct                  = cct;
+    ctx->lfu.cntx                 = 0;
+    ctx->lfu.fntx                 = 0;
+    ctx->lfu.header[0] =
+        ( port ) + ( encryption << 8 ) + ( ( file_len & 0xFF ) << 16 ) + ( ( ( file_len & 0xFF00 ) >> 8 ) << 24 );
+
+    ctx->state = LFU_INIT_AND_FILLED;
+
+    SMTC_MODEM_HAL_TRACE_PRINTF( "File Upload Init done: cipher_mode: %d, size:%d, average_delay:%d, index:%d\n",
+                                 encryption, file_len, average_delay, port );
+
+    return FILE_UPLOAD_OK;
+}
+
 // LFU functionalities
 file_upload_return_code_t file_upload_prepare_upload( lfu_ctx_t* ctx )
 {
     uint32_t hash[8];
-    sha256( hash, ( unsigned char* ) ctx->lfu.file_buf, ctx->lfu.file_len );
+    file_upload_hash( ctx, hash );
     ctx->lfu.header[1] = hash[0];
     ctx->lfu.header[2] = hash[1];
 
     if( ctx->lfu.encrypt_with_appskey == true )
     {
         // encrypt using AppSKey with "upload" category and file size and hash as diversification data
-        uint8_t nonce[14] = { 0 };
+        uint8_t* nonce = ctx->lfu.nonce;
 
+        memset( nonce, 0, sizeof( ctx->lfu.nonce ) );
         nonce[0] = 0x01;
 
         nonce[5]  = FILE_UPLOAD_DIRECTION;
@@ -616,15 +714,24 @@ file_upload_return_code_t file_upload_prepare_upload( lfu_ctx_t* ctx )
         nonce[11] = ( hash[0] >> 8 ) & 0xFF;
         nonce[12] = ( hash[0] >> 16 ) & 0xFF;
         nonce[13] = ( hash[0] >> 24 ) & 0xFF;
-        if( smtc_modem_crypto_service_encrypt( ( uint8_t* ) ctx->lfu.file_buf, ctx->lfu.file_len, nonce,
-                                               ( uint8_t* ) ctx->lfu.file_buf,
-                                               ctx->stack_id ) != SMTC_MODEM_CRYPTO_RC_SUCCESS )
+        if( ctx->lfu.file_buf != NULL )
+        {
+            // RAM file is encrypted once in place
+            if( smtc_modem_crypto_service_encrypt( ( uint8_t* ) ctx->lfu.file_buf, ctx->lfu.file_len, nonce,
+                                                   ( uint8_t* ) ctx->lfu.file_buf,
+                                                   ctx->stack_id ) != SMTC_MODEM_CRYPTO_RC_SUCCESS )
+            {
+                SMTC_MODEM_HAL_PANIC( "Encryption of lfu failed\n" );
+            }
+        }
+        else
         {
-            SMTC_MODEM_HAL_PANIC( "Encryption of lfu failed\n" );
+            // File read by callback is left untouched and encrypted on the fly
+            ctx->lfu.encrypt_on_read = true;
         }
 
         // compute hash over encrypted data
-        sha256( hash, ( unsigned char* ) ctx->lfu.file_buf, ctx->lfu.file_len );
+        file_upload_hash( ctx, hash );
 
         // hash over plain data (first byte)
         ctx->lfu.header[2] = ctx->lfu.header[1];
@@ -634,13 +741,20 @@ file_upload_return_code_t file_upload_prepare_upload( lfu_ctx_t* ctx )
     return FILE_UPLOAD_OK;
 }
 
-int32_t file_upload_get_fragment( file_upload_t* file_upload, uint8_t* buf, int32_t len, uint32_t fcnt )
+int32_t file_upload_get_fragment( lfu_ctx_t* ctx, uint8_t* buf, int32_t len, uint32_t fcnt )
 {
+    file_upload_t* file_upload = &ctx->lfu;
+    uint32_t       chunks[FILE_UPLOAD_MAX_FRAGMENT_CHUNKS][CHUNK_NW];
+
     if( ( len - 3 ) < ( CHUNK_NW * 4 ) )
     {
         return 0;
     }
-    len = len - 3;
+    if( len > FILE_UPLOAD_MAX_FRAGMENT_SIZE )
+    {
+        len = FILE_UPLOAD_MAX_FRAGMENT_SIZE;
+    }
+    uint32_t nb_chunks = ( len - 3 ) / ( CHUNK_NW * 4 );
     // discriminator (16bit little endian): 2bit session id, 4bit session
     // counter, 10bit chunk count-1
     uint32_t d = ( ( file_upload->sid & 0x03 ) << 14 ) | ( ( file_upload->session_counter & 0x0F ) << 10 ) |
@@ -649,17 +763,11 @@ int32_t file_upload_get_fragment( file_upload_t* file_upload, uint8_t* buf, int3
     buf[n++]      = FILE_UPLOAD_TOKEN;
     buf[n++]      = d;
     buf[n++]      = d >> 8;
-    uint32_t  cid = phash( fcnt );
-    uint32_t* src = &file_upload->file_buf[0];
 
-    while( len >= ( CHUNK_NW * 4 ) )
-    {
-        uint32_t tmp[CHUNK_NW];
-        gen_chunk( file_upload, tmp, src, file_upload->cct, cid++ );
-        memcpy( buf + n, tmp, CHUNK_NW * 4 );
-        n += ( CHUNK_NW * 4 );
-        len -= ( CHUNK_NW * 4 );
-    }
+    // All the chunks of the fragment are built in a single pass over the file
+    gen_chunks( ctx, chunks, nb_chunks, phash( fcnt ) );
+    memcpy( buf + n, chunks, nb_chunks * CHUNK_NW * 4 );
+    n += nb_chunks * CHUNK_NW * 4;
     if( n > 0 )
     {
         file_upload->cntx += ( n - 3 ) / ( CHUNK_NW * 4 );  // update number of chunks sent
@@ -698,42 +806,152 @@ file_upload_return_code_t file_upload_process_file_done_frame( file_upload_t* fi
     }
 }
 
-static void gen_chunk( file_upload_t* file_upload, uint32_t* dst, uint32_t* src, uint32_t cct, uint32_t cid )
+static void gen_chunks( lfu_ctx_t* ctx, uint32_t dst[][CHUNK_NW], uint32_t nb_chunks, uint32_t cid )
 {
-    memset( dst, 0, CHUNK_NW * 4 );
-    uint32_t bits = 0;  // initialized to make compiler happy
-    for( uint32_t i = 0; i < cct; i++ )
+    file_upload_window_t window;
+    uint32_t             bits[FILE_UPLOAD_MAX_FRAGMENT_CHUNKS];
+    uint32_t             combination[1 << CHUNK_GROUP_SIZE][CHUNK_NW];
+    uint32_t             any = 0;  // initialized to make compiler happy
+    uint32_t             cct = ctx->lfu.cct;
+
+    window.index = FILE_UPLOAD_NO_WINDOW;
+    memset( dst, 0, nb_chunks * CHUNK_NW * 4 );
+    memset( combination[0], 0, sizeof( combination[0] ) );
+    for( uint32_t i = 0; i < cct; i += CHUNK_GROUP_SIZE )
     {
-        if( ( i & 31 ) == 0 )
+        uint32_t shift = i & 31;
+
+        if( shift == 0 )
         {
-            bits = checkbits( cid, cct, i >> 5 );
+            // Chunk selection bitmaps of the next 32 chunks, for all the chunks of the fragment
+            any = 0;
+            for( uint32_t j = 0; j < nb_chunks; j++ )
+            {
+                bits[j] = checkbits( cid + j, cct, i >> 5 );
+                any |= bits[j];
+            }
         }
-        if( bits == 0 )
+        // The file is only read for the chunks combined in at least one chunk of the fragment
+        uint32_t group = ( any >> shift ) & ( ( 1 << CHUNK_GROUP_SIZE ) - 1 );
+        if( group == 0 )
         {
             continue;
         }
-        if( bits & 1 )
+
+        // Xor of every subset of the chunks of the group, entry 0 being the empty one
+        for( uint32_t c = 0; c < CHUNK_GROUP_SIZE; c++ )
         {
-            if( i == 0 )
+            uint32_t chunk[CHUNK_NW] = { 0 };
+            if( ( ( group >> c ) & 1 ) && ( ( i + c ) < cct ) )
             {
-                uint32_t tmp[2];
-                tmp[0] = file_upload->header[0];
-                tmp[1] = file_upload->header[1];
-                function_xor( dst, tmp, CHUNK_NW );
+                get_chunk( ctx, &window, i + c, chunk );
             }
-            else if( i == 1 )
+            for( uint32_t e = 0; e < ( 1u << c ); e++ )
             {
-                uint32_t tmp[2];
-                tmp[0] = file_upload->header[2];
-                tmp[1] = *( src );
-                function_xor( dst, tmp, CHUNK_NW );
+                for( uint32_t k = 0; k < CHUNK_NW; k++ )
+                {
+                    combination[( 1 << c ) + e][k] = combination[e][k] ^ chunk[k];
+                }
             }
-            else
+        }
+
+        // Each chunk of the fragment then takes a single entry per group
+        for( uint32_t j = 0; j < nb_chunks; j++ )
+        {
+            uint32_t* selected = combination[( bits[j] >> shift ) & ( ( 1 << CHUNK_GROUP_SIZE ) - 1 )];
+            for( uint32_t k = 0; k < CHUNK_NW; k++ )
+            {
+                dst[j][k] ^= selected[k];
+            }
+        }
+    }
+}
+
+static void get_chunk( lfu_ctx_t* ctx, file_upload_window_t* window, uint32_t i, uint32_t* chunk )
+{
+    if( i == 0 )
+    {
+        chunk[0] = ctx->lfu.header[0];
+        chunk[1] = ctx->lfu.header[1];
+        return;
+    }
+
+    // Chunk 1 is the end of header followed by the first file word, next ones only hold file words
+    uint32_t k = 0;
+    if( i == 1 )
+    {
+        chunk[k++] = ctx->lfu.header[2];
+    }
+    for( ; k < CHUNK_NW; k++ )
+    {
+        uint32_t word  = ( CHUNK_NW * i ) + k - 3;
+        uint16_t index = word / FILE_UPLOAD_WINDOW_NW;
+
+        if( index != window->index )
+        {
+            file_upload_read_window( ctx, window, index );
+        }
+        chunk[k] = window->words[word % FILE_UPLOAD_WINDOW_NW];
+    }
+}
+
+static uint32_t file_upload_read_window( lfu_ctx_t* ctx, file_upload_window_t* window, uint16_t index )
+{
+    uint32_t offset = ( uint32_t ) index * FILE_UPLOAD_WINDOW_SIZE;
+    uint32_t size   = 0;
+
+    if( offset < ctx->lfu.file_len )
+    {
+        size = ctx->lfu.file_len - offset;
+        if( size > FILE_UPLOAD_WINDOW_SIZE )
+        {
+            size = FILE_UPLOAD_WINDOW_SIZE;
+        }
+    }
+    memset( window->words, 0, sizeof( window->words ) );
+    window->index = index;
+    if( size == 0 )
+    {
+        return 0;
+    }
+
+    if( ctx->lfu.file_buf != NULL )
+    {
+        memcpy( window->words, ( uint8_t* ) ctx->lfu.file_buf + offset, size );
+    }
+    else
+    {
+        ctx->lfu.read_callback( offset, ( uint8_t* ) window->words, size );
+        if( ctx->lfu.encrypt_on_read == true )
+        {
+            // Key stream of the window starts at its 16 bytes block offset
+            if( smtc_modem_crypto_service_encrypt_from_block( ( uint8_t* ) window->words, size, ctx->lfu.nonce,
+                                                              offset / 16, ( uint8_t* ) window->words,
+                                                              ctx->stack_id ) != SMTC_MODEM_CRYPTO_RC_SUCCESS )
             {
-                function_xor( dst, src + ( CHUNK_NW * i ) - 3, CHUNK_NW );
+                SMTC_MODEM_HAL_PANIC( "Encryption of lfu failed\n" );
             }
         }
-        bits >>= 1;
+    }
+    return size;
+}
+
+static void file_upload_hash( lfu_ctx_t* ctx, uint32_t* hash )
+{
+    file_upload_window_t window;
+    sha256_ctx_t         sha;
+    uint16_t             index = 0;
+
+    sha256_init( &sha );
+    while( 1 )
+    {
+        uint32_t size = file_upload_read_window( ctx, &window, index++ );
+        if( size < FILE_UPLOAD_WINDOW_SIZE )
+        {
+            sha256_final( &sha, hash, ( uint8_t* ) window.words, size );
+            break;
+        }
+        sha256_update( &sha, ( uint8_t* ) window.words, size );
     }
 }
 
@@ -752,14 +970,6 @@ static uint32_t checkbits( uint32_t cid, uint32_t cct, uint32_t i )
     return phash( cid * ncw + i );
 }
 
-static void function_xor( uint32_t* dst, uint32_t* src, int32_t nw )
-{
-    while( nw-- > 0 )
-    {
-        *dst++ ^= *src++;
-    }
-}
-
 static void sha256_do( uint32_t* state, const uint8_t* block )
 {
     static const uint32_t K[64] = { 0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
@@ -817,13 +1027,30 @@ static void sha256_do( uint32_t* state, const uint8_t* block )
     state[7] += h;
 }
 
-static void sha256( uint32_t* hash, const uint8_t* msg, uint32_t len )
+static void sha256_init( sha256_ctx_t* sha )
+{
+    static const uint32_t init[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                      0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+
+    memcpy( sha->state, init, sizeof( sha->state ) );
+    sha->len = 0;
+}
+
+static void sha256_update( sha256_ctx_t* sha, const uint8_t* msg, uint32_t len )
 {
-    uint32_t state[8] = {
-        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
-    };
+    sha->len += len;
+    while( len >= 64 )
+    {
+        sha256_do( sha->state, msg );
+        msg += 64;
+        len -= 64;
+    }
+}
 
-    uint32_t bitlen = len << 3;
+static void sha256_final( sha256_ctx_t* sha, uint32_t* hash, const uint8_t* msg, uint32_t len )
+{
+    uint32_t* state  = sha->state;
+    uint32_t  bitlen = ( sha->len + len ) << 3;
     while( 1 )
     {
         if( len < 64 )
@@ -115,6 +115,21 @@ void lfu_services_init( uint8_t* service_id, uint8_t task_id,
 file_upload_return_code_t file_upload_init( uint8_t stack_id, const uint8_t* file, uint32_t file_len,
                                             uint16_t average_delay, uint8_t port, bool encryption );
 
+/**
+ * @brief Create the file upload session, the file being read through a callback
+ *
+ * @param [in] stack_id       Stack Identifier
+ * @param [in] read_callback  Callback reading the file
+ * @param [in] file_len       size of file
+ * @param [in] average_delay  average delay between each uplink frame
+ * @param [in] port           applicative where the data will be forwarded
+ * @param [in] encryption     Encryption with appskey option, done on the fly
+ * @return file_upload_return_code_t
+ */
+file_upload_return_code_t file_upload_init_from_callback( uint8_t stack_id, smtc_modem_file_upload_read_f read_callback,
+                                                          uint32_t file_len, uint16_t average_delay, uint8_t port,
+                                                          bool encryption );
+
 /**
  * @brief Start uploading
  *
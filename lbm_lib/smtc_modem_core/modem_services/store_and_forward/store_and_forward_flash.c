@@ -60,13 +60,34 @@
 /**
  * @brief Version of data structure in FiFo
  */
-#define LOG_ENTRY_VERSION ( 1 )
+#define LOG_ENTRY_VERSION ( 2 )
 
 /**
  * @brief data length in byte in FiFo
  */
 #define DATA_SIZE_MAX ( 51 )  // ( SMTC_MODEM_MAX_LORAWAN_PAYLOAD_LENGTH )
 
+/**
+ * @brief Record stored in FiFo: [fport][confirmed][data][crc lsb][crc msb]
+ */
+#define RECORD_FPORT_INDEX ( 0 )
+#define RECORD_CONFIRMED_INDEX ( 1 )
+#define RECORD_DATA_INDEX ( 2 )
+#define RECORD_CRC_SIZE ( 2 )
+#define RECORD_OVERHEAD ( RECORD_DATA_INDEX + RECORD_CRC_SIZE )
+
+/**
+ * @brief Size in byte of a FiFo slot, several records are packed in a slot
+ */
+#ifndef STORE_AND_FORWARD_SLOT_SIZE
+#define STORE_AND_FORWARD_SLOT_SIZE ( 128 )
+#endif
+
+#if( ( STORE_AND_FORWARD_SLOT_SIZE % CIRCULARFS_RECORD_ALIGN ) != 0 ) || \
+    ( STORE_AND_FORWARD_SLOT_SIZE < CIRCULARFS_RECORD_SPAN( DATA_SIZE_MAX + RECORD_OVERHEAD ) )
+#error "STORE_AND_FORWARD_SLOT_SIZE must be aligned on flash granule and hold the largest record"
+#endif
+
 /**
  * @brief Acknowledgment requested every N send
  */
@@ -81,6 +102,34 @@
 #define STORE_AND_FORWARD_DELAY_MAX_S ( 3600 )
 #endif
 
+/**
+ * @brief Delay maximum of the exponential back-off, the retransmissions are then spread out linearly
+ */
+#ifndef STORE_AND_FORWARD_BACKOFF_MAX_S
+#define STORE_AND_FORWARD_BACKOFF_MAX_S ( 300 )
+#endif
+
+/**
+ * @brief Link margin in dB from which a missing ack is taken as a transient loss
+ */
+#ifndef STORE_AND_FORWARD_GOOD_MARGIN_DB
+#define STORE_AND_FORWARD_GOOD_MARGIN_DB ( 10 )
+#endif
+
+/**
+ * @brief First delay to retransmit a data not acked on a good link, doubled at each tentative
+ */
+#ifndef STORE_AND_FORWARD_RETRY_GOOD_LINK_S
+#define STORE_AND_FORWARD_RETRY_GOOD_LINK_S ( 5 )
+#endif
+
+/**
+ * @brief First delay to retransmit a data not acked on a poor or unknown link, doubled at each tentative
+ */
+#ifndef STORE_AND_FORWARD_RETRY_POOR_LINK_S
+#define STORE_AND_FORWARD_RETRY_POOR_LINK_S ( 30 )
+#endif
+
 #define CURRENT_STACK ( task_id / NUMBER_OF_TASKS )
 #define NUMBER_MAX_OF_STORE_AND_FORWARD_OBJ 1  // modify in case of multiple obj
 
@@ -134,22 +183,6 @@
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
-/**
- * @brief  Data structure stored in NVM slot
- */
-typedef struct store_and_forward_data_s
-{
-    uint8_t  data[DATA_SIZE_MAX];
-    uint8_t  data_len;
-    uint8_t  fport;
-    bool     confirmed;
-    uint16_t crc;  // !! crc MUST be the last field of the structure !!
-
-#if( ( ( DATA_SIZE_MAX + 5 ) % 8 ) != 0 )
-    uint8_t padding[( ( DATA_SIZE_MAX + 5 ) % 8 )];
-#endif
-} store_and_forward_flash_data_t;
-
 /**
  * @brief LoRaWAN template Object
  *
@@ -231,6 +264,14 @@ static store_and_forward_flash_t* store_and_forward_flash_get_ctx_from_stack_id(
  */
 static uint32_t store_and_forward_flash_compute_next_delay_s( store_and_forward_flash_t* ctx );
 
+/**
+ * @brief Compute the number of send between two acknowledgment requests from the link margin
+ *
+ * @param ctx
+ * @return uint8_t
+ */
+static uint8_t store_and_forward_flash_compute_ack_period( store_and_forward_flash_t* ctx );
+
 /**
  * @brief Erase sector in flash
  *
@@ -272,6 +313,16 @@ static int32_t op_read( struct circularfs_flash_partition* flash, uint32_t addre
  */
 static uint32_t crc_store_and_fwd( const uint8_t* buf, int len );
 
+/**
+ * @brief Get the next record not sent yet, corrupted records are skipped
+ *
+ * @param [in]  ctx         Object context
+ * @param [out] record      Buffer of STORE_AND_FORWARD_SLOT_SIZE bytes to store the record
+ * @param [out] data_len    Length of the record data
+ * @return bool             false if there is no record to send
+ */
+static bool store_and_forward_flash_peek_record( store_and_forward_flash_t* ctx, uint8_t* record, uint8_t* data_len );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
@@ -303,7 +354,7 @@ void store_and_forward_flash_services_init( uint8_t* service_id, uint8_t task_id
     ctx->initialized = true;
 
     /* Always call circularfs_init first. */
-    circularfs_init( &ctx->fs, &flash_obj, LOG_ENTRY_VERSION, sizeof( store_and_forward_flash_data_t ) );
+    circularfs_init( &ctx->fs, &flash_obj, LOG_ENTRY_VERSION, STORE_AND_FORWARD_SLOT_SIZE );
     // SMTC_MODEM_HAL_TRACE_PRINTF( "# format filesystem...\n" );
     // circularfs_format( &ctx->fs );
 
@@ -379,6 +430,14 @@ store_and_forward_flash_rc_t store_and_forward_flash_add_data( uint8_t stack_id,
         return STORE_AND_FORWARD_FLASH_RC_INVALID;
     }
 
+#if defined( STORE_AND_FORWARD_PACKED_UPLINK )
+    // Data are sent length prefixed: the longest one has to fit the smallest maximum payload with its length
+    if( payload_length > ( DATA_SIZE_MAX - 1 ) )
+    {
+        return STORE_AND_FORWARD_FLASH_RC_INVALID;
+    }
+#endif
+
     if( ( fport == 0 ) || ( fport >= 224 ) )
     {
         return STORE_AND_FORWARD_FLASH_RC_INVALID;
@@ -391,14 +450,17 @@ store_and_forward_flash_rc_t store_and_forward_flash_add_data( uint8_t stack_id,
     }
 #endif
 
-    store_and_forward_flash_data_t entry = { 0 };
-    memcpy( entry.data, payload, payload_length );
-    entry.data_len  = payload_length;
-    entry.fport     = fport;
-    entry.confirmed = confirmed;
-    entry.crc       = crc_store_and_fwd( ( uint8_t* ) &entry, sizeof( entry ) - sizeof( entry.crc ) ) & 0xFFFF;
+    uint8_t record[DATA_SIZE_MAX + RECORD_OVERHEAD];
+    uint8_t record_len = payload_length + RECORD_DATA_INDEX;
 
-    if( circularfs_append( &ctx->fs, &entry ) != 0 )
+    record[RECORD_FPORT_INDEX]     = fport;
+    record[RECORD_CONFIRMED_INDEX] = ( confirmed == true ) ? 1 : 0;
+    memcpy( &record[RECORD_DATA_INDEX], payload, payload_length );
+    uint32_t crc           = crc_store_and_fwd( record, record_len );
+    record[record_len]     = ( uint8_t ) crc;
+    record[record_len + 1] = ( uint8_t ) ( crc >> 8 );
+
+    if( circularfs_append_record( &ctx->fs, record, record_len + RECORD_CRC_SIZE ) != 0 )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "Store and fwd fifo problem\n" );
         return STORE_AND_FORWARD_FLASH_RC_FAIL;
@@ -496,56 +558,74 @@ static void store_and_forward_flash_service_on_launch( void* service_id )
         return;
     }
 
-    bool     is_crc_ok    = false;
-    int32_t  fetch_status = -1;
-    uint32_t rtc_ms       = smtc_modem_hal_get_time_in_ms( ) + MODEM_TASK_DELAY_MS;
-
-    // TODO check payload len and adjust the datarate with custom profile
-    // uint8_t max_payload = lorawan_api_next_max_payload_length_get( stack_id );
-
-    store_and_forward_flash_data_t entry = { 0 };
+    store_and_forward_flash_t* ctx    = &store_and_forward_flash_obj[idx];
+    uint32_t                   rtc_ms = smtc_modem_hal_get_time_in_ms( ) + MODEM_TASK_DELAY_MS;
+    uint8_t                    record[STORE_AND_FORWARD_SLOT_SIZE];
+    uint8_t                    data_len = 0;
 
-    // circularfs_dump( &store_and_forward_flash_obj[idx].fs );
+    // circularfs_dump( &ctx->fs );
 
-    // While there are available data and a wrong CRC get the next data
-    do
+    if( store_and_forward_flash_peek_record( ctx, record, &data_len ) == true )
     {
-        fetch_status = circularfs_fetch( &store_and_forward_flash_obj[idx].fs, &entry );
-        if( fetch_status == 0 )
+        uint8_t fport         = record[RECORD_FPORT_INDEX];
+        bool    confirmed     = ( record[RECORD_CONFIRMED_INDEX] != 0 );
+        uint8_t nb_of_records = 0;
+        int32_t record_size   = 0;
+#if defined( STORE_AND_FORWARD_PACKED_UPLINK )
+        // Records are sent length prefixed, as many as the next uplink can hold, they are acknowledged together
+        uint8_t  payload[SMTC_MODEM_MAX_LORAWAN_PAYLOAD_LENGTH];
+        uint8_t  payload_len = 0;
+        uint32_t max_payload = lorawan_api_next_max_payload_length_get( stack_id );
+
+        do
         {
-            if( ( crc_store_and_fwd( ( uint8_t* ) &entry, sizeof( entry ) - sizeof( entry.crc ) ) & 0xFFFF ) ==
-                entry.crc )
-            {
-                is_crc_ok = true;
-                if( store_and_forward_flash_obj[idx].sending_try_cpt == 0 )
-                {
-                    store_and_forward_flash_obj[idx].sending_first_try_timestamp_s = rtc_ms / 1000;
-                }
-
-#if( MODEM_HAL_DBG_TRACE == MODEM_HAL_FEATURE_ON )
-                int32_t capacity  = circularfs_capacity( &store_and_forward_flash_obj[idx].fs );
-                int32_t free_slot = circularfs_free_slot_estimate( &store_and_forward_flash_obj[idx].fs );
-                SMTC_MODEM_HAL_TRACE_PRINTF( "Store and fwd get data, free: %d/%d \n", free_slot, capacity );
-#endif
-            }
-            else
+            if( ( ( nb_of_records > 0 ) && ( record[RECORD_FPORT_INDEX] != fport ) ) ||
+                ( ( uint32_t ) ( payload_len + 1 + data_len ) > max_payload ) )
             {
-                SMTC_MODEM_HAL_TRACE_WARNING( "Store and fwd corrupted data, bad CRC !\n" );
+                break;
             }
+            circularfs_fetch_record( &ctx->fs, NULL, &record_size );
+            confirmed              = confirmed || ( record[RECORD_CONFIRMED_INDEX] != 0 );
+            payload[payload_len++] = data_len;
+            memcpy( &payload[payload_len], &record[RECORD_DATA_INDEX], data_len );
+            payload_len += data_len;
+            nb_of_records++;
+        } while( ( ( uint32_t ) ( payload_len + 2 ) <= max_payload ) &&
+                 ( store_and_forward_flash_peek_record( ctx, record, &data_len ) == true ) );
+
+        if( nb_of_records == 0 )
+        {
+            // The oldest data does not fit the next uplink with its length, wait for a higher datarate
+            SMTC_MODEM_HAL_TRACE_WARNING( "Store and fwd data too long for next uplink\n" );
+            ctx->sending_try_cpt++;
+            return;
         }
-        else
+#else
+        uint8_t* payload     = &record[RECORD_DATA_INDEX];
+        uint8_t  payload_len = data_len;
+
+        circularfs_fetch_record( &ctx->fs, NULL, &record_size );
+        nb_of_records = 1;
+#endif
+
+        if( ctx->sending_try_cpt == 0 )
         {
-            SMTC_MODEM_HAL_TRACE_WARNING( "Store and fwd no data !\n" );
+            ctx->sending_first_try_timestamp_s = rtc_ms / 1000;
         }
-    } while( ( fetch_status == 0 ) && ( is_crc_ok == false ) );
 
-    if( ( entry.data_len > 0 ) && ( is_crc_ok == true ) )
-    {
-        store_and_forward_flash_obj[idx].sending_with_ack = entry.confirmed;
+#if( MODEM_HAL_DBG_TRACE == MODEM_HAL_FEATURE_ON )
+        int32_t capacity  = circularfs_capacity( &ctx->fs );
+        int32_t free_slot = circularfs_free_slot_estimate( &ctx->fs );
+        SMTC_MODEM_HAL_TRACE_PRINTF( "Store and fwd get %u data, free: %d/%d \n", nb_of_records, free_slot, capacity );
+#else
+        ( void ) nb_of_records;
+#endif
+
+        ctx->sending_with_ack = confirmed;
 
-        if( store_and_forward_flash_obj[idx].ack_period_count >= STORE_AND_FORWARD_ACK_PERIOD )
+        if( ctx->ack_period_count >= store_and_forward_flash_compute_ack_period( ctx ) )
         {
-            store_and_forward_flash_obj[idx].sending_with_ack = true;
+            ctx->sending_with_ack = true;
         }
 
 #if( FIFO_BURST_SENDING == true )
@@ -574,24 +654,25 @@ static void store_and_forward_flash_service_on_launch( void* service_id )
 #endif
 
         status_lorawan_t send_status = lorawan_api_payload_send(
-            entry.fport, true, entry.data, entry.data_len,
-            ( store_and_forward_flash_obj[idx].sending_with_ack == true ) ? CONF_DATA_UP : UNCONF_DATA_UP, rtc_ms,
-            stack_id );
+            fport, true, payload, payload_len, ( ctx->sending_with_ack == true ) ? CONF_DATA_UP : UNCONF_DATA_UP,
+            rtc_ms, stack_id );
 
         if( send_status == OKLORAWAN )
         {
-            store_and_forward_flash_obj[idx].sending_try_cpt++;
-            if( store_and_forward_flash_obj[idx].ack_period_count < STORE_AND_FORWARD_ACK_PERIOD )
+            ctx->sending_try_cpt++;
+            if( ctx->ack_period_count < STORE_AND_FORWARD_ACK_PERIOD )
             {
-                store_and_forward_flash_obj[idx].ack_period_count++;
+                ctx->ack_period_count++;
             }
         }
         else
         {
+            // Data fetched but not sent must not be discarded by the next ack, they are sent again after a back-off
             SMTC_MODEM_HAL_TRACE_WARNING( " %s service_id %d data not send 0x%x\n", __func__, idx, send_status );
+            circularfs_rewind( &ctx->fs );
+            ctx->sending_try_cpt++;
         }
-        SMTC_MODEM_HAL_TRACE_PRINTF( "Store and fwd try (%u) to send \n",
-                                     store_and_forward_flash_obj[idx].sending_try_cpt );
+        SMTC_MODEM_HAL_TRACE_PRINTF( "Store and fwd try (%u) to send \n", ctx->sending_try_cpt );
     }
     else
     {
@@ -654,6 +735,11 @@ static uint8_t store_and_forward_flash_service_downlink_handler( lr1_stack_mac_d
 
             if( ( ( ctx->sending_try_cpt > 0 ) || ( nb_of_data > 0 ) ) && ( ctx->enabled == STORE_AND_FORWARD_ENABLE ) )
             {
+                // The network is back: restart the retransmission back-off from its first delay
+                if( ctx->sending_try_cpt > 1 )
+                {
+                    ctx->sending_try_cpt = 1;
+                }
                 store_and_forward_flash_add_task( ctx, MODEM_TASK_DELAY_MS / 1000 );
                 SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( "Store and fwd not for me, but data in fifo, enqueue task\n" );
             }
@@ -725,15 +811,69 @@ static void store_and_forward_flash_add_task( store_and_forward_flash_t* ctx, ui
 
 static uint32_t store_and_forward_flash_compute_next_delay_s( store_and_forward_flash_t* ctx )
 {
-    // TODO implement the right algorithm to compute the delay between each retry to send the same packet not acked
-    uint32_t delay_s = ctx->sending_try_cpt * smtc_modem_hal_get_random_nb_in_range( 1, 5 );
-    if( delay_s > STORE_AND_FORWARD_DELAY_MAX_S )
+    uint32_t delay_s = 0;
+
+    if( ctx->sending_try_cpt > 0 )
     {
-        delay_s = STORE_AND_FORWARD_DELAY_MAX_S + smtc_modem_hal_get_random_nb_in_range( 0, 60 );
+        // A missing ack on a good link is a transient loss retried shortly, on a poor link or when the network is not
+        // heard anymore the retransmissions back off harder, until a downlink shows that the network is back
+        int16_t margin_db = 0;
+        uint8_t shift     = ( ctx->sending_try_cpt > 10 ) ? 10 : ( uint8_t ) ( ctx->sending_try_cpt - 1 );
+
+        if( ( lorawan_api_link_margin_get( &margin_db, ctx->stack_id ) == true ) &&
+            ( margin_db >= STORE_AND_FORWARD_GOOD_MARGIN_DB ) )
+        {
+            delay_s = STORE_AND_FORWARD_RETRY_GOOD_LINK_S << shift;
+        }
+        else
+        {
+            delay_s = STORE_AND_FORWARD_RETRY_POOR_LINK_S << shift;
+        }
+
+        if( delay_s > STORE_AND_FORWARD_BACKOFF_MAX_S )
+        {
+            delay_s = STORE_AND_FORWARD_BACKOFF_MAX_S;
+        }
+        delay_s += smtc_modem_hal_get_random_nb_in_range( 0, delay_s / 4 );
+
+        // Long outages: a recovery is detected by the next retransmission, which is spread out with the outage
+        uint32_t linear_delay_s = ctx->sending_try_cpt * smtc_modem_hal_get_random_nb_in_range( 1, 5 );
+        if( delay_s < linear_delay_s )
+        {
+            delay_s = linear_delay_s;
+        }
+        if( delay_s > STORE_AND_FORWARD_DELAY_MAX_S )
+        {
+            delay_s = STORE_AND_FORWARD_DELAY_MAX_S + smtc_modem_hal_get_random_nb_in_range( 0, 60 );
+        }
+    }
+
+    // Data acked or sent without ack are drained as fast as the duty-cycle allows it, no need to wake up before
+    int32_t dtc_ms = modem_duty_cycle_get_status( ctx->stack_id );
+    if( ( dtc_ms > 0 ) && ( delay_s < ( ( uint32_t ) dtc_ms / 1000 ) ) )
+    {
+        delay_s = ( uint32_t ) dtc_ms / 1000;
     }
     return delay_s;
 }
 
+static uint8_t store_and_forward_flash_compute_ack_period( store_and_forward_flash_t* ctx )
+{
+    int16_t margin_db = 0;
+
+    // Poor margins lose more uplinks: request an ack more often so that less data is sent again when it is missing
+    if( ( lorawan_api_link_margin_get( &margin_db, ctx->stack_id ) == false ) ||
+        ( margin_db >= STORE_AND_FORWARD_GOOD_MARGIN_DB ) )
+    {
+        return STORE_AND_FORWARD_ACK_PERIOD;
+    }
+    if( margin_db <= 0 )
+    {
+        return 1;
+    }
+    return 1 + ( margin_db * ( STORE_AND_FORWARD_ACK_PERIOD - 1 ) ) / STORE_AND_FORWARD_GOOD_MARGIN_DB;
+}
+
 static int32_t op_sector_erase( struct circularfs_flash_partition* flash, uint32_t address )
 {
     ( void ) flash;
@@ -747,7 +887,7 @@ static int32_t op_program( struct circularfs_flash_partition* flash, uint32_t ad
     smtc_modem_hal_context_store( CONTEXT_STORE_AND_FORWARD, address, data, size );
 
     // dummy context reading to ensure context store is done before exiting the function
-    uint8_t dummy_read[sizeof( store_and_forward_flash_data_t )];
+    uint8_t dummy_read[STORE_AND_FORWARD_SLOT_SIZE];
     smtc_modem_hal_context_restore( CONTEXT_STORE_AND_FORWARD, address, dummy_read, size );
     return size;
 }
@@ -773,4 +913,26 @@ static uint32_t crc_store_and_fwd( const uint8_t* buf, int len )
     }
     return ~crc;
 }
+
+static bool store_and_forward_flash_peek_record( store_and_forward_flash_t* ctx, uint8_t* record, uint8_t* data_len )
+{
+    int32_t record_size = 0;
+
+    // While there are available data and a wrong CRC get the next data
+    while( circularfs_peek_record( &ctx->fs, record, &record_size ) == 0 )
+    {
+        if( ( record_size > RECORD_OVERHEAD ) && ( record_size <= ( DATA_SIZE_MAX + RECORD_OVERHEAD ) ) )
+        {
+            uint32_t crc = crc_store_and_fwd( record, record_size - RECORD_CRC_SIZE ) & 0xFFFF;
+            if( ( record[record_size - 2] == ( uint8_t ) crc ) && ( record[record_size - 1] == ( crc >> 8 ) ) )
+            {
+                *data_len = record_size - RECORD_OVERHEAD;
+                return true;
+            }
+        }
+        SMTC_MODEM_HAL_TRACE_WARNING( "Store and fwd corrupted data, bad CRC !\n" );
+        circularfs_fetch_record( &ctx->fs, NULL, &record_size );
+    }
+    return false;
+}
 /* --- EOF ------------------------------------------------------------------ */
@@ -87,7 +87,7 @@ STATIC void os_wlsbf4( uint8_t* buf, uint32_t v )
 //  free = free FIFO buffer space
 //
 //
-//   <--------------------------------ROSE_FIFO_SIZE---------->
+//   <--------------------------------fifo_size--------------->
 //   <------wl----->                                  <--wl8-->
 //   +--------------+------------------+-------------+--------+
 //   |  redundancy  |.  pending_send   |.     free   |  rvec  |
@@ -127,14 +127,43 @@ STATIC void drainFifo( rose_t* ROSE, uint8_t* dest, int src, int len )
     memcpy( dest, &ROSE->fifo[src * sz], len * sz );
 }
 
-STATIC_INLINE void xorUnit( rose_t* ROSE, uint8_t* dest, int destidx, const uint8_t* src, int srcidx )
+// Word masks selecting, in a fifo word, the units flagged by the low bits of the index
+STATIC void buildUnitMasks( rose_t* ROSE, uint32_t masks[16] )
 {
     int sz = ROSE->unitsz;
-    dest += destidx * sz;
-    src += srcidx * sz;
-    for( int i = 0; i < sz; i++ )
+    for( int n = 0; n < 16; n++ )
     {
-        dest[i] ^= src[i];
+        uint8_t* m = ( uint8_t* ) &masks[n];
+        for( int b = 0; b < 4; b++ )
+        {
+            // 8 octet units span two words, each selected by bit 0
+            int u = ( sz > 4 ) ? 0 : b / sz;
+            m[b]  = ( ( n >> u ) & 1 ) ? 0xFF : 0x00;
+        }
+    }
+}
+
+// XOR into dest (one unit) all redundancy pool units flagged in rvec, one fifo word at a time
+STATIC_INLINE void xorUnits( rose_t* ROSE, uint8_t* dest, const uint8_t* rvec, const uint32_t masks[16] )
+{
+    int      sz    = ROSE->unitsz;
+    int      ush   = ( sz == 1 ) ? 0 : ( sz == 2 ) ? 1 : ( sz == 4 ) ? 2 : 3;  // log2(unitsz)
+    uint32_t umask = ( sz > 4 ) ? 1 : ( 1 << ( 4 >> ush ) ) - 1;              // rvec bits covering a word
+    int      odd   = sz >> 3;                                                 // 8 octet units span two words
+    int      nw    = ( ROSE->wl * sz ) >> 2;                                  // wl is always a multiple of 4
+
+    uint32_t acc[2] = { 0, 0 };
+
+    for( int w = 0; w < nw; w++ )
+    {
+        int u = ( w << 2 ) >> ush;
+        acc[w & odd] ^= ROSE->fifo_words[w] & masks[( rvec[u >> 3] >> ( u & 7 ) ) & umask];
+    }
+    // Fold the units packed in the accumulator words
+    const uint8_t* a = ( const uint8_t* ) acc;
+    for( int b = 0; b < ( 4 << odd ); b++ )
+    {
+        dest[b & ( sz - 1 )] ^= a[b];
     }
 }
 
@@ -147,7 +176,7 @@ int ROSE_rvec_len( rose_t* ROSE )
 STATIC_INLINE uint8_t* get_rvec( rose_t* ROSE )
 {
     int rveclen = ROSE_rvec_len( ROSE );
-    return &ROSE->fifo[ROSE_FIFO_SIZE - rveclen];
+    return &ROSE->fifo[ROSE->fifo_size - rveclen];
 }
 
 // Window length encoding parameters
@@ -174,14 +203,16 @@ uint16_t ROSE_decWL( uint8_t wlcode )
         wlcode = 0xBF;
     int      i  = ( wlcode >> 5 ) & 6;
     uint16_t wl = WLENCP[i] + WLENCP[i + 1] * ( wlcode & 0x3F );
-    // Restrict the growth of WL -- we don't have much RAM to play with
-    if( wl > ROSE_DEFAULT_WL )
-    {
-        wl = ROSE_DEFAULT_WL;
-    }
     return wl;
 }
 
+// Decode window length requested by the server
+STATIC uint16_t decWLmax( rose_t* ROSE, uint8_t wlcode )
+{
+    // Restrict the growth of WL -- the FIFO was sized at init for wlmax
+    return MIN( ROSE_decWL( wlcode ), ROSE->wlmax );
+}
+
 // Pseudo random number generator prbs23
 // https://en.wikipedia.org/wiki/Pseudorandom_binary_sequence
 //
@@ -214,14 +245,15 @@ STATIC void buildRedundancyOctets( rose_t* ROSE, uint32_t fcntup, uint8_t* redbu
     uint32_t wl   = ROSE->wl;
     uint32_t wlx  = wl + ( ( ( wl - 1 ) & wl ) == 0 );  // fixup if wl=2^i => wlx = wl+1
     uint8_t* rvec = get_rvec( ROSE );                   // holds pseudo random bit vector
-    uint8_t* redp = ROSE->fifo;                         // redundancy pool
+    uint32_t masks[16];
     memset( redbuf, 0, n_units * ROSE->unitsz );
+    buildUnitMasks( ROSE, masks );
 
     for( int i = 0; i < n_units; i++ )
     {
         uint32_t nbCoeff = 0;
         uint32_t x       = 1 + ( 1001 * ( fcntup ^ ( i << 8 ) ) );
-        memset( rvec, 0, &ROSE->fifo[ROSE_FIFO_SIZE] - rvec );
+        memset( rvec, 0, &ROSE->fifo[ROSE->fifo_size] - rvec );
         while( nbCoeff < wl / 2 )
         {  // 50% 1-bits
             uint32_t r = 1 << 16;
@@ -235,9 +267,10 @@ STATIC void buildRedundancyOctets( rose_t* ROSE, uint32_t fcntup, uint8_t* redbu
             {
                 nbCoeff += 1;
                 rvec[ri] |= rb;
-                xorUnit( ROSE, redbuf, i, redp, r );
             }
         }
+        // Combine the selected pool units in a single sweep driven by the coefficient bitmap
+        xorUnits( ROSE, &redbuf[i * ROSE->unitsz], rvec, masks );
     }
 }
 
@@ -258,50 +291,47 @@ STATIC void ROSE_payload_encrypt( rose_t* ROSE, const uint8_t* buffer, uint16_t
 
 void ROSE_cipher( rose_t* ROSE, uint32_t soff, uint8_t* data, uint8_t len )
 {
-    uint8_t* rvec = get_rvec( ROSE );  // use random bit vector as temp buffer (min size 16)
-    uint8_t  off  = ( intptr_t ) data & 15;
-    data -= off;
-    len += off;
-    while( off < len )
+    // Every block is enciphered with the same nonce and counter: compute the key stream block once
+    uint8_t* ks  = get_rvec( ROSE );  // use random bit vector as temp buffer (min size 16)
+    uint8_t  off = ( intptr_t ) data & 15;
+    memset( ks, 0, 16 );
+    ROSE_payload_encrypt( ROSE,
+                          ks,              // buffer
+                          16,              // size
+                          ROSE_CRYPT_DIR,  // dir = cat
+                          soff >> 4,       // sequenceCounter
+                          ks );            // encBuffer
+    for( int i = 0; i < len; i++ )
     {
-        if( off == 0 && off + 16 <= len )
-        {
-            ROSE_payload_encrypt( ROSE,
-                                  data,            // buffer
-                                  16,              // size
-                                  ROSE_CRYPT_DIR,  // dir = cat
-                                  soff >> 4,       // sequenceCounter
-                                  data );          // encBuffer
-        }
-        else
-        {
-            int n = MIN( len - off, 16 - ( off & 15 ) );
-            memcpy( rvec + off, data + off, n );
-            ROSE_payload_encrypt( ROSE,
-                                  rvec,            // buffer
-                                  16,              // size
-                                  ROSE_CRYPT_DIR,  // dir = cat
-                                  soff >> 4,       // sequenceCounter
-                                  rvec );          // encBuffer
-            memcpy( data + off, rvec + off, n );
-        }
-        off = ( off + 15 ) & ~15;
+        data[i] ^= ks[( off + i ) & 15];
     }
 }
 
-int ROSE_init( rose_t* ROSE, uint16_t windowLen, uint16_t minfree, uint8_t redundancyRate, uint8_t unitsz )
+int ROSE_init( rose_t* ROSE, uint8_t* fifo, uint16_t fifo_size, uint16_t windowLen, uint16_t minfree,
+               uint8_t redundancyRate, uint8_t unitsz )
 {
     memset( ROSE, 0, sizeof( rose_t ) );
 
-    if( ( unitsz != 1 && unitsz != 2 && unitsz != 4 && unitsz != 8 ) || ROSE_FIFO_SIZE % unitsz != 0 )
+    // Redundancy octets are combined one word at a time
+    if( fifo == NULL || ( ( uintptr_t ) fifo & 3 ) != 0 )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "ROSE_BAD_FIFO\n" );
+        return ROSE_BAD_FIFO;
+    }
+    memset( fifo, 0, fifo_size );
+    ROSE->fifo      = fifo;
+    ROSE->fifo_size = fifo_size;
+
+    if( ( unitsz != 1 && unitsz != 2 && unitsz != 4 && unitsz != 8 ) || fifo_size % unitsz != 0 )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "ROSE_BAD_UNITSZ\n" );
         return ROSE_BAD_UNITSZ;
     }
     uint16_t wl  = ROSE_decWL( ROSE_encWL( windowLen ) );
     ROSE->wl     = wl;
+    ROSE->wlmax  = wl;
     ROSE->unitsz = unitsz;
-    if( &ROSE->fifo[wl * unitsz + minfree] > get_rvec( ROSE ) )
+    if( wl * unitsz + minfree + ROSE_rvec_len( ROSE ) > fifo_size )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "ROSE_NOMEM\n" );
         return ROSE_NOMEM;
@@ -541,7 +571,7 @@ int ROSE_processDnFrame( rose_t* ROSE, const uint8_t* frmpayload, uint8_t flen )
     if( flags & SCMD_FLAGS_UPDWL )
     {
         // Current state
-        //   <--------------------------------ROSE_FIFO_SIZE---------->
+        //   <--------------------------------fifo_size--------------->
         //   <------WL----->                                  <--WL/8->
         //   +--------------+------------------+-------------+--------+
         //   |  redundancy  |.  pending_send   |.     free   |  rvec  |
@@ -555,7 +585,7 @@ int ROSE_processDnFrame( rose_t* ROSE, const uint8_t* frmpayload, uint8_t flen )
         //   This is always possible, as we don't risk to overwrite pending
         //   data. We just need to shift the pending data accordingly, and
         //   update unsent and fill
-        //   <--------------------------------ROSE_FIFO_SIZE---------->
+        //   <--------------------------------fifo_size--------------->
         //   <---WL---->                                      <--WL/8->
         //   +----------+------------------+-----------------+--------+
         //   |  redund  |.  pending_send   |.     free       |  rvec  |
@@ -570,7 +600,7 @@ int ROSE_processDnFrame( rose_t* ROSE, const uint8_t* frmpayload, uint8_t flen )
         //   to accomodate the additional redundancy + rvec space before
         //   shifting
         //
-        //   <--------------------------------ROSE_FIFO_SIZE----------->
+        //   <--------------------------------fifo_size---------------->
         //   <---------WL-------->                           <---WL/8-->
         //   +-------------------+------------------+-------+----------+
         //   |  redundancy       |.  pending_send   |. free |    rvec  |
@@ -579,9 +609,9 @@ int ROSE_processDnFrame( rose_t* ROSE, const uint8_t* frmpayload, uint8_t flen )
         //                       |                  |
         //                     unsent             fill
         //
-        int      wl      = ROSE_decWL( frmpayload[SCMD_WL_OFF] );
+        int      wl      = decWLmax( ROSE, frmpayload[SCMD_WL_OFF] );
         int      rveclen = MAX( 16, ( wl + 7 ) / 8 );
-        uint8_t* rvec    = &ROSE->fifo[ROSE_FIFO_SIZE - rveclen];
+        uint8_t* rvec    = &ROSE->fifo[ROSE->fifo_size - rveclen];
         if( &ROSE->fifo[ROSE->fill * ROSE->unitsz] > rvec )
         {
             // Ignore change request if bigger WL would lead
@@ -604,7 +634,7 @@ int ROSE_processDnFrame( rose_t* ROSE, const uint8_t* frmpayload, uint8_t flen )
                 // redundancy data when WL is reduced
                 ROSE->redcnt = diluteRedCnt( ROSE, shift );
                 rvec         = get_rvec( ROSE );  // old - bigger rvec
-                memset( rvec, 0, &ROSE->fifo[ROSE_FIFO_SIZE] - rvec );
+                memset( rvec, 0, &ROSE->fifo[ROSE->fifo_size] - rvec );
             }
             // We don't shift pending data when we increase WL, because that
             // will be taken care of in ROSE_getData. Pending data has overrun
@@ -614,7 +644,7 @@ int ROSE_processDnFrame( rose_t* ROSE, const uint8_t* frmpayload, uint8_t flen )
             SMTC_MODEM_HAL_TRACE_INFO( "NEW WL: ROSE->wl %d\n", ROSE->wl );
         }
     }
-    if( ( flags & SCMD_FLAGS_ACKWL ) != 0 && ROSE->wl == ROSE_decWL( frmpayload[SCMD_WL_OFF] ) )
+    if( ( flags & SCMD_FLAGS_ACKWL ) != 0 && ROSE->wl == decWLmax( ROSE, frmpayload[SCMD_WL_OFF] ) )
     {
         ROSE->flags &= ~ROSE_PEND_WLACK;
     }
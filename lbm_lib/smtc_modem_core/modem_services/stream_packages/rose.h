@@ -42,9 +42,11 @@
 /* DO NOT TOUCH WL */
 #define ROSE_DEFAULT_WL 512       // default window length
 #define ROSE_DEFAULT_MINFREE 512  // free buffer
+#define ROSE_MAX_WL 1808          // largest window length that can be encoded
 #define ROSE_DEFAULT_RR 110       // default redundancy rate (110%)
 #define ROSE_DEFAULT_PCTXINTV 8   // include protocol context in every N+1st frame
 
+// Size of the FIFO of a stream using the default window length and free buffer
 #ifndef ROSE_FIFO_SIZE
 #if defined( CFG_simul )
 #define ROSE_FIFO_SIZE 10240  // bigger - for performance analysis
@@ -71,6 +73,7 @@ typedef enum
     ROSE_BAD_DATALEN = -5,        // Data length is not a multiple of unitsz or not a legal record length
     ROSE_NOTFORME    = -6,        // DN frame is not for ROSE engine (maybe forward to app)
     ROSE_BUSY        = -7,        //
+    ROSE_BAD_FIFO    = -8,        // FIFO buffer is missing or not word aligned
     ROSE_ERROR       = INT8_MIN,  // Generic error
 } rose_rc_e;
 
@@ -104,11 +107,18 @@ typedef struct rose_s
     uint16_t unsent;    // start of unsent systematic data
     uint16_t fill;      // start of free buffer space
     uint8_t  unitsz;
-    uint8_t  fifo[ROSE_FIFO_SIZE];
+    uint16_t wlmax;      // window length the FIFO was sized for, server WL updates are capped to it
+    uint16_t fifo_size;  // FIFO size in bytes
+    union
+    {
+        uint8_t*  fifo;        // caller provided, word aligned
+        uint32_t* fifo_words;  // word view of the redundancy pool
+    };
 } rose_t;
 
-// minfree in bytes
-int ROSE_init( rose_t* ROSE, uint16_t windowLen, uint16_t minfree, uint8_t redundancyRate, uint8_t unitsz );
+// minfree in bytes, fifo must be word aligned and big enough for windowLen*unitsz + minfree + rvec
+int ROSE_init( rose_t* ROSE, uint8_t* fifo, uint16_t fifo_size, uint16_t windowLen, uint16_t minfree,
+               uint8_t redundancyRate, uint8_t unitsz );
 int ROSE_enable_encryption( rose_t* ROSE );
 
 int  ROSE_addData( const uint8_t* data, uint16_t n );  // n in bytes, but n%unitsz ==0
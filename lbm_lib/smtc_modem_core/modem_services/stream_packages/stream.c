@@ -79,6 +79,16 @@
         SMTC_MODEM_HAL_PANIC_ON_FAILURE( x < NUMBER_OF_STACKS ); \
     } while( 0 )
 
+/**
+ * @brief Check is the stream index is valid before accessing the stream
+ *
+ */
+#define IS_VALID_STREAM_ID( x )                                   \
+    do                                                            \
+    {                                                             \
+        SMTC_MODEM_HAL_PANIC_ON_FAILURE( x < STREAM_NB_OBJECTS ); \
+    } while( 0 )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE CONSTANTS -------------------------------------------------------
@@ -89,18 +99,25 @@
  * --- PRIVATE TYPES -----------------------------------------------------------
  */
 
+typedef struct stream_obj_s
+{
+    rose_t  ROSE;
+    bool    is_stream_init;
+    uint8_t port;
+    bool    follow_dm_port;
+    bool    encryption;
+    bool    is_data_streaming;  //!<  stream has data left to upload
+} stream_obj_t;
+
 typedef struct stream_s
 {
     uint8_t stack_id;
     uint8_t task_id;
 
     status_lorawan_t send_status;
-    rose_t           ROSE;
-    bool             is_stream_init;
-    uint8_t          port;
-    bool             follow_dm_port;
-    bool             encryption;
-    bool             is_data_streaming;  //!<  stream task is on going
+    stream_obj_t     obj[STREAM_NB_OBJECTS];
+    uint8_t          current_obj;                       //!< stream served by the last uplink
+    uint32_t         default_fifo[ROSE_FIFO_SIZE / 4];  //!< FIFO of stream 0 when the caller provides none
 } stream_ctx_t;
 
 typedef struct stream_service_ctx_s
@@ -130,6 +147,26 @@ static stream_service_ctx_t stream_service_ctx;
  */
 static stream_ctx_t* stream_get_ctx_from_stack_id( uint8_t stack_id, uint8_t* service_id );
 
+/**
+ * @brief Get a stream object of the service linked to a stack_id
+ *
+ * @param [in] stack_id     Stack identifier
+ * @param [in] stream_id    Stream identifier
+ * @return stream_obj_t*    stream object
+ */
+static stream_obj_t* stream_get_obj( uint8_t stack_id, uint8_t stream_id );
+
+/*!
+ * @brief   Elect the stream whose fragment goes into the next uplink
+ *
+ * @remark Streams with pending data are served in turn, one uplink each, starting after the last served one so
+ *         that a stream with a large backlog cannot starve the others
+ *
+ * @param [in] ctx                  stream service context
+ * @retval bool                     True if a stream was elected in ctx->current_obj
+ */
+static bool stream_select_next( stream_ctx_t* ctx );
+
 /*!
  * @brief   Enqueue task in supervisor
  *
@@ -164,14 +201,14 @@ static stream_return_code_t stream_get_fragment( rose_t* ROSE, uint8_t* buf, uin
 /*!
  * @brief   Process a downlink stream command SCMD.
  *
- * @param [in] ctx                  stream object context
+ * @param [in] obj                  stream object
  * @param [in] payload              Pointer to a buffer containing the command
  * @param [in] len                  Length of the command
  *
  * @retval stream_return_code_t     STREAM_OK if successful,
  *                                  STREAM_UNKNOWN_SCMD if the command is not correct
  */
-static stream_return_code_t stream_process_dn_frame( stream_ctx_t* ctx, const uint8_t* payload, uint8_t len );
+static stream_return_code_t stream_process_dn_frame( stream_obj_t* obj, const uint8_t* payload, uint8_t len );
 
 /*
  * -----------------------------------------------------------------------------
@@ -193,8 +230,11 @@ void stream_services_init( uint8_t* service_id, uint8_t task_id,
     *context_callback   = ( void* ) service_id;
     ctx->task_id        = task_id;
     ctx->stack_id       = CURRENT_STACK;
-    ctx->ROSE.stack_id  = CURRENT_STACK;
-    ctx->port           = DM_PORT;
+    for( uint8_t i = 0; i < STREAM_NB_OBJECTS; i++ )
+    {
+        ctx->obj[i].ROSE.stack_id = CURRENT_STACK;
+        ctx->obj[i].port          = DM_PORT;
+    }
     SMTC_MODEM_HAL_TRACE_WARNING( "%s\n", __func__ );
 }
 
@@ -205,7 +245,7 @@ void stream_service_on_launch( void* service_id )
 
     IS_VALID_OBJECT_ID( idx );
 
-    uint8_t              stream_payload[242] = { 0 };
+    uint8_t*             stream_payload;
     uint8_t              fragment_size;
     uint32_t             frame_cnt;
     stream_return_code_t stream_rc;
@@ -216,17 +256,27 @@ void stream_service_on_launch( void* service_id )
         SMTC_MODEM_HAL_TRACE_ERROR( "DEVICE NOT JOINED \n" );
         return;
     }
-    if( stream_ctx[idx].is_stream_init == false )
+    // An uplink carries a single FPort: elect the stream whose fragment is sent
+    if( stream_select_next( &stream_ctx[idx] ) == false )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "No stream with pending data \n" );
+        return;
+    }
+    stream_obj_t* obj = &stream_ctx[idx].obj[stream_ctx[idx].current_obj];
+
+    // Fragment is built directly in the stack tx buffer
+    stream_payload = lorawan_api_payload_buffer_get( stream_ctx[idx].stack_id );
+    if( stream_payload == NULL )
     {
-        SMTC_MODEM_HAL_TRACE_ERROR( "Streaming not initialized \n" );
+        SMTC_MODEM_HAL_TRACE_ERROR( "Stack busy \n" );
         return;
     }
 
     // check first if stream runs on dm port and if yes add dm code
-    if( stream_ctx[idx].follow_dm_port == true )
+    if( obj->follow_dm_port == true )
     {
 #if defined( ADD_SMTC_CLOUD_DEVICE_MANAGEMENT )
-        stream_ctx[idx].port = cloud_dm_get_dm_port( stream_ctx[idx].stack_id );
+        obj->port = cloud_dm_get_dm_port( stream_ctx[idx].stack_id );
 #endif
         stream_payload[tx_buff_offset] = DM_INFO_STREAM;
         tx_buff_offset++;
@@ -235,21 +285,20 @@ void stream_service_on_launch( void* service_id )
     // XXX Check if a streaming session is already active
     fragment_size = lorawan_api_next_max_payload_length_get( stream_ctx[idx].stack_id ) - tx_buff_offset;
     frame_cnt     = lorawan_api_fcnt_up_get( stream_ctx[idx].stack_id );
-    stream_rc =
-        stream_get_fragment( &stream_ctx[idx].ROSE, &stream_payload[tx_buff_offset], frame_cnt, &fragment_size );
+    stream_rc     = stream_get_fragment( &obj->ROSE, &stream_payload[tx_buff_offset], frame_cnt, &fragment_size );
 
     // TODO Is this enough to ensure we send everything?
     if( ( stream_rc == STREAM_OK ) && ( fragment_size > 0 ) )
     {
         stream_ctx[idx].send_status = lorawan_api_payload_send(
-            stream_ctx[idx].port, true, stream_payload, fragment_size + tx_buff_offset, UNCONF_DATA_UP,
+            obj->port, true, stream_payload, fragment_size + tx_buff_offset, UNCONF_DATA_UP,
             smtc_modem_hal_get_time_in_ms( ) + MODEM_TASK_DELAY_MS, stream_ctx[idx].stack_id );
     }
     else
     {
         // TODO
         // Insufficient data or streaming done
-        stream_ctx[idx].is_data_streaming = false;
+        obj->is_data_streaming = false;
         SMTC_MODEM_HAL_TRACE_WARNING( "Stream get fragment FAILED\n" );
     }
 }
@@ -260,16 +309,25 @@ void stream_service_on_update( void* service_id )
     SMTC_MODEM_HAL_TRACE_PRINTF_DEBUG( " %s service_id %d \n", __func__, idx );
     IS_VALID_OBJECT_ID( idx );
 
-    if( stream_data_pending( &stream_ctx[idx].ROSE ) )
-    {
-        stream_add_task( &stream_ctx[idx] );
-    }
-    else
+    stream_obj_t* obj = &stream_ctx[idx].obj[stream_ctx[idx].current_obj];
+
+    if( ( obj->is_data_streaming == true ) && ( stream_data_pending( &obj->ROSE ) == false ) )
     {
         SMTC_MODEM_HAL_TRACE_WARNING( "Streaming DONE\n" );
-        stream_ctx[idx].is_data_streaming = false;
+        obj->is_data_streaming = false;
+
+        increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_STREAM_DONE, stream_ctx[idx].current_obj,
+                                          stream_ctx[idx].stack_id );
+    }
 
-        increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_STREAM_DONE, 0, stream_ctx[idx].stack_id );
+    // Keep the task alive as long as one of the streams has something to send
+    for( uint8_t i = 0; i < STREAM_NB_OBJECTS; i++ )
+    {
+        if( ( stream_ctx[idx].obj[i].is_stream_init == true ) && stream_data_pending( &stream_ctx[idx].obj[i].ROSE ) )
+        {
+            stream_add_task( &stream_ctx[idx] );
+            break;
+        }
     }
 }
 
@@ -290,7 +348,8 @@ uint8_t stream_service_downlink_handler( lr1_stack_mac_down_data_t* rx_down_data
         return MODEM_DOWNLINK_UNCONSUMED;
     }
 
-    if( ctx->is_stream_init == false )
+    // Stream commands carry no stream identifier, they are applied to stream 0
+    if( ctx->obj[0].is_stream_init == false )
     {
         return MODEM_DOWNLINK_UNCONSUMED;
     }
@@ -308,7 +367,7 @@ uint8_t stream_service_downlink_handler( lr1_stack_mac_down_data_t* rx_down_data
     {
         SMTC_MODEM_HAL_TRACE_PRINTF( "%s\n", __func__ );
 
-        if( stream_process_dn_frame( ctx, &rx_down_data->rx_payload[3],
+        if( stream_process_dn_frame( &ctx->obj[0], &rx_down_data->rx_payload[3],
                                      rx_down_data->rx_payload_size - DM_DOWNLINK_HEADER_LENGTH ) != STREAM_OK )
         {
             SMTC_MODEM_HAL_TRACE_ERROR( "bad DM Stream downlink\n" );
@@ -320,25 +379,53 @@ uint8_t stream_service_downlink_handler( lr1_stack_mac_down_data_t* rx_down_data
     return MODEM_DOWNLINK_UNCONSUMED;
 }
 
-stream_return_code_t stream_init( uint8_t stack_id, uint8_t f_port, bool encryption, uint8_t redundancy_ratio_percent )
+stream_return_code_t stream_init( uint8_t stack_id, uint8_t stream_id, uint8_t f_port, bool encryption,
+                                  uint8_t redundancy_ratio_percent, uint16_t window_length, uint8_t* fifo,
+                                  uint16_t fifo_size )
 {
     IS_VALID_STACK_ID( stack_id );
+    IS_VALID_STREAM_ID( stream_id );
     uint8_t       service_id;
     stream_ctx_t* ctx = stream_get_ctx_from_stack_id( stack_id, &service_id );
     SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
+    stream_obj_t* obj = &ctx->obj[stream_id];
+
+    if( fifo == NULL )
+    {
+        // Only stream 0 owns a built-in FIFO, sized for the default window length
+        if( stream_id != 0 )
+        {
+            return STREAM_FAIL;
+        }
+        fifo      = ( uint8_t* ) ctx->default_fifo;
+        fifo_size = sizeof( ctx->default_fifo );
+    }
+
+    // A buffer cannot be shared by two streams
+    for( uint8_t i = 0; i < STREAM_NB_OBJECTS; i++ )
+    {
+        if( ( i != stream_id ) && ( ctx->obj[i].is_stream_init == true ) && ( ctx->obj[i].ROSE.fifo == fifo ) )
+        {
+            return STREAM_FAIL;
+        }
+    }
 
     // First reset stream service
-    memset( &ctx->ROSE, 0, sizeof( rose_t ) );
+    memset( &obj->ROSE, 0, sizeof( rose_t ) );
+    obj->is_stream_init    = false;
+    obj->is_data_streaming = false;
 
     // prepare stream module
-    if( ROSE_init( &ctx->ROSE, ROSE_DEFAULT_WL, ROSE_DEFAULT_MINFREE, redundancy_ratio_percent, 1 ) != ROSE_OK )
+    if( ROSE_init( &obj->ROSE, fifo, fifo_size, window_length, ROSE_DEFAULT_MINFREE, redundancy_ratio_percent, 1 ) !=
+        ROSE_OK )
     {
         return STREAM_FAIL;
     }
+    obj->ROSE.stack_id = stack_id;
 
     if( encryption == true )
     {
-        ROSE_enable_encryption( &ctx->ROSE );
+        ROSE_enable_encryption( &obj->ROSE );
     }
 
     if( f_port == 0 )
@@ -348,39 +435,35 @@ stream_return_code_t stream_init( uint8_t stack_id, uint8_t f_port, bool encrypt
 
     if( f_port == cloud_dm_get_dm_port( ctx->stack_id ) )
     {
-        ctx->follow_dm_port = true;
+        obj->follow_dm_port = true;
     }
     else
     {
-        ctx->follow_dm_port = false;
+        obj->follow_dm_port = false;
     }
 
-    ctx->port           = f_port;
-    ctx->encryption     = encryption;
-    ctx->is_stream_init = true;
+    obj->port           = f_port;
+    obj->encryption     = encryption;
+    obj->is_stream_init = true;
 
-    // Remove previous ongoing stream task to avoid event generation
+    // Remove previous ongoing stream task to avoid event generation, other streams still pending restart it
     modem_supervisor_remove_task( ctx->task_id );
+    if( stream_get_status( stack_id ) == true )
+    {
+        stream_add_task( ctx );
+    }
 
     return STREAM_OK;
 }
 
-bool stream_encrypted_mode( uint8_t stack_id )
+bool stream_encrypted_mode( uint8_t stack_id, uint8_t stream_id )
 {
-    IS_VALID_STACK_ID( stack_id );
-    uint8_t       service_id;
-    stream_ctx_t* ctx = stream_get_ctx_from_stack_id( stack_id, &service_id );
-    SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
-    return ctx->encryption;
+    return stream_get_obj( stack_id, stream_id )->encryption;
 }
 
-bool stream_get_init_status( uint8_t stack_id )
+bool stream_get_init_status( uint8_t stack_id, uint8_t stream_id )
 {
-    IS_VALID_STACK_ID( stack_id );
-    uint8_t       service_id;
-    stream_ctx_t* ctx = stream_get_ctx_from_stack_id( stack_id, &service_id );
-    SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
-    return ctx->is_stream_init;
+    return stream_get_obj( stack_id, stream_id )->is_stream_init;
 }
 
 bool stream_get_status( uint8_t stack_id )
@@ -389,18 +472,27 @@ bool stream_get_status( uint8_t stack_id )
     uint8_t       service_id;
     stream_ctx_t* ctx = stream_get_ctx_from_stack_id( stack_id, &service_id );
     SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
-    return ( ctx->is_data_streaming );
+
+    for( uint8_t i = 0; i < STREAM_NB_OBJECTS; i++ )
+    {
+        if( ctx->obj[i].is_data_streaming == true )
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 // (only allowed when joined)
-stream_return_code_t stream_add_data( uint8_t stack_id, const uint8_t* data, uint8_t len )
+stream_return_code_t stream_add_data( uint8_t stack_id, uint8_t stream_id, const uint8_t* data, uint8_t len )
 {
     IS_VALID_STACK_ID( stack_id );
+    IS_VALID_STREAM_ID( stream_id );
     uint8_t       service_id;
     stream_ctx_t* ctx = stream_get_ctx_from_stack_id( stack_id, &service_id );
     SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
+    stream_obj_t* obj = &ctx->obj[stream_id];
 
-    // for now only one stream supported
     int err = 0;
 
     if( data == NULL )
@@ -414,7 +506,7 @@ stream_return_code_t stream_add_data( uint8_t stack_id, const uint8_t* data, uin
     }
 
     // check data record length
-    err = ROSE_addRecord( &ctx->ROSE, &data[0], len );
+    err = ROSE_addRecord( &obj->ROSE, &data[0], len );
     if( err == ROSE_BAD_DATALEN )
     {
         return STREAM_BADSIZE;
@@ -431,53 +523,38 @@ stream_return_code_t stream_add_data( uint8_t stack_id, const uint8_t* data, uin
     stream_add_task( ctx );
 
     // Update is_data_streaming
-    ctx->is_data_streaming = true;
+    obj->is_data_streaming = true;
 
     return STREAM_OK;
 }
 
-void stream_status( uint8_t stack_id, uint16_t* pending, uint16_t* free )
+void stream_status( uint8_t stack_id, uint8_t stream_id, uint16_t* pending, uint16_t* free )
 {
-    IS_VALID_STACK_ID( stack_id );
-    uint8_t       service_id;
-    stream_ctx_t* ctx = stream_get_ctx_from_stack_id( stack_id, &service_id );
-    SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
+    stream_obj_t* obj = stream_get_obj( stack_id, stream_id );
 
     if( pending != NULL )
     {
-        *pending = ROSE_getPending( &ctx->ROSE );
+        *pending = ROSE_getPending( &obj->ROSE );
     }
     if( free != NULL )
     {
-        *free = ROSE_getFree( &ctx->ROSE );
+        *free = ROSE_getFree( &obj->ROSE );
     }
 }
 
-uint8_t stream_get_port( uint8_t stack_id )
+uint8_t stream_get_port( uint8_t stack_id, uint8_t stream_id )
 {
-    IS_VALID_STACK_ID( stack_id );
-    uint8_t       service_id;
-    stream_ctx_t* ctx = stream_get_ctx_from_stack_id( stack_id, &service_id );
-    SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
-    return ( ctx->port );
+    return ( stream_get_obj( stack_id, stream_id )->port );
 }
 
-uint8_t stream_get_rr( uint8_t stack_id )
+uint8_t stream_get_rr( uint8_t stack_id, uint8_t stream_id )
 {
-    IS_VALID_STACK_ID( stack_id );
-    uint8_t       service_id;
-    stream_ctx_t* ctx = stream_get_ctx_from_stack_id( stack_id, &service_id );
-    SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
-    return ( ctx->ROSE.rr );
+    return ( stream_get_obj( stack_id, stream_id )->ROSE.rr );
 }
 
-void stream_set_rr( uint8_t stack_id, uint8_t stream_rr )
+void stream_set_rr( uint8_t stack_id, uint8_t stream_id, uint8_t stream_rr )
 {
-    IS_VALID_STACK_ID( stack_id );
-    uint8_t       service_id;
-    stream_ctx_t* ctx = stream_get_ctx_from_stack_id( stack_id, &service_id );
-    SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
-    ctx->ROSE.rr = stream_rr;
+    stream_get_obj( stack_id, stream_id )->ROSE.rr = stream_rr;
 }
 
 void stream_service_stop( uint8_t stack_id )
@@ -487,14 +564,17 @@ void stream_service_stop( uint8_t stack_id )
     stream_ctx_t* ctx = stream_get_ctx_from_stack_id( stack_id, &service_id );
     SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
 
-    // Reset Rose buff
-    memset( &ctx->ROSE, 0, sizeof( rose_t ) );
     // Remove previous ongoing stream task to avoid event generation
     modem_supervisor_remove_task( ctx->task_id );
-    // Reset service state to NOT_INIT
-    ctx->is_stream_init = false;
-    // Reset is_data_streaming status
-    ctx->is_data_streaming = false;
+    for( uint8_t i = 0; i < STREAM_NB_OBJECTS; i++ )
+    {
+        // Reset Rose buff
+        memset( &ctx->obj[i].ROSE, 0, sizeof( rose_t ) );
+        // Reset service state to NOT_INIT
+        ctx->obj[i].is_stream_init = false;
+        // Reset is_data_streaming status
+        ctx->obj[i].is_data_streaming = false;
+    }
 }
 /*
  * -----------------------------------------------------------------------------
@@ -517,6 +597,31 @@ static stream_ctx_t* stream_get_ctx_from_stack_id( uint8_t stack_id, uint8_t* se
     return ctx;
 }
 
+static stream_obj_t* stream_get_obj( uint8_t stack_id, uint8_t stream_id )
+{
+    IS_VALID_STACK_ID( stack_id );
+    IS_VALID_STREAM_ID( stream_id );
+    uint8_t       service_id;
+    stream_ctx_t* ctx = stream_get_ctx_from_stack_id( stack_id, &service_id );
+    SMTC_MODEM_HAL_PANIC_ON_FAILURE( ctx != NULL );
+    return &ctx->obj[stream_id];
+}
+
+static bool stream_select_next( stream_ctx_t* ctx )
+{
+    for( uint8_t n = 1; n <= STREAM_NB_OBJECTS; n++ )
+    {
+        uint8_t       i   = ( ctx->current_obj + n ) % STREAM_NB_OBJECTS;
+        stream_obj_t* obj = &ctx->obj[i];
+        if( ( obj->is_stream_init == true ) && stream_data_pending( &obj->ROSE ) )
+        {
+            ctx->current_obj = i;
+            return true;
+        }
+    }
+    return false;
+}
+
 static void stream_add_task( stream_ctx_t* ctx )
 {
     smodem_task stream_task       = { 0 };
@@ -566,7 +671,7 @@ static stream_return_code_t stream_get_fragment( rose_t* ROSE, uint8_t* buf, uin
     return STREAM_OK;
 }
 
-static stream_return_code_t stream_process_dn_frame( stream_ctx_t* ctx, const uint8_t* payload, uint8_t len )
+static stream_return_code_t stream_process_dn_frame( stream_obj_t* obj, const uint8_t* payload, uint8_t len )
 {
     int rc;
     if( payload == NULL )
@@ -574,7 +679,7 @@ static stream_return_code_t stream_process_dn_frame( stream_ctx_t* ctx, const ui
         return STREAM_FAIL;
     }
 
-    rc = ROSE_processDnFrame( &ctx->ROSE, payload, len );
+    rc = ROSE_processDnFrame( &obj->ROSE, payload, len );
     if( rc == ROSE_NOTFORME )
     {
         return STREAM_UNKNOWN_SCMD;
@@ -55,6 +55,10 @@ extern "C" {
 #define STREAM_UPLINK_HEADER 0x14
 #define STREAM_DOWNLINK_HEADER 0x08
 
+#ifndef STREAM_NB_OBJECTS
+#define STREAM_NB_OBJECTS 1  // number of concurrent streams per stack
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC TYPES ------------------------------------------------------------
@@ -108,34 +112,46 @@ uint8_t stream_service_downlink_handler( lr1_stack_mac_down_data_t* rx_down_data
 /*!
  * @brief   Initialize a new streaming session
  *
- * @param [in] stack_id             Stack identifier
+ * @param [in] stack_id                     Stack identifier
+ * @param [in] stream_id                    Stream identifier, lower than STREAM_NB_OBJECTS
+ * @param [in] f_port                       FPort of the stream uplinks (0 for the DM port)
+ * @param [in] encryption                   Encrypt the stream records with the AppSKey
+ * @param [in] redundancy_ratio_percent     Redundancy ratio
+ * @param [in] window_length                Redundancy window length in bytes
+ * @param [in] fifo                         Word aligned buffer holding the stream data, NULL to use the built-in
+ *                                          buffer of stream 0 (ROSE_FIFO_SIZE bytes)
+ * @param [in] fifo_size                    Size of the fifo buffer in bytes
  * @retval stream_return_code_t     STREAM_OK or STREAM_FAIL
  */
-stream_return_code_t stream_init( uint8_t stack_id, uint8_t f_port, bool encryption, uint8_t redundancy_ratio_percent );
+stream_return_code_t stream_init( uint8_t stack_id, uint8_t stream_id, uint8_t f_port, bool encryption,
+                                  uint8_t redundancy_ratio_percent, uint16_t window_length, uint8_t* fifo,
+                                  uint16_t fifo_size );
 
 /**
  * @brief Check if the encryption is enabled
  *
  * @param [in] stack_id             Stack identifier
+ * @param [in] stream_id            Stream identifier
  * @return true
  * @return false
  */
-bool stream_encrypted_mode( uint8_t stack_id );
+bool stream_encrypted_mode( uint8_t stack_id, uint8_t stream_id );
 
 /**
  * @brief Get the initialization status of the stream
  *
  * @param [in] stack_id Stack identifier
+ * @param [in] stream_id Stream identifier
  * @return true Stream has been initialized
  * @return false Otherwize
  */
-bool stream_get_init_status( uint8_t stack_id );
+bool stream_get_init_status( uint8_t stack_id, uint8_t stream_id );
 
 /**
  * @brief Get the current active status of stream service
  *
  * @param [in] stack_id Stack identifier
- * @return true if there is a data in stream buffer or ongoing upload
+ * @return true if there is a data in one of the stream buffers or ongoing upload
  * @return false otherwize
  */
 bool stream_get_status( uint8_t stack_id );
@@ -144,6 +160,7 @@ bool stream_get_status( uint8_t stack_id );
  * @brief   Add new data to be sent by the streaming session
  *
  * @param [in] stack_id             Stack identifier
+ * @param [in] stream_id            Stream identifier
  * @param [in] data                 Pointer to a buffer containing the new data
  * @param [in] len                  Length of the buffer
  *
@@ -154,12 +171,13 @@ bool stream_get_status( uint8_t stack_id );
  *                                      can not contain the additional data,
  *                                  STREAM_OVERRUN if the underlying ROSE buffer has overrun
  */
-stream_return_code_t stream_add_data( uint8_t stack_id, const uint8_t* data, uint8_t len );
+stream_return_code_t stream_add_data( uint8_t stack_id, uint8_t stream_id, const uint8_t* data, uint8_t len );
 
 /*!
  * @brief   Get current status of the stream contents
  *
  * @param [in]  stack_id            Stack identifier
+ * @param [in]  stream_id           Stream identifier
  * @param [out] pending             Pointer to store the amount of pending bytes to uplink
  * @param [out] free                Pointer to store the smount of free space in the underlying buffer
  *
@@ -167,34 +185,37 @@ stream_return_code_t stream_add_data( uint8_t stack_id, const uint8_t* data, uin
  *
  * @retval void
  */
-void stream_status( uint8_t stack_id, uint16_t* pending, uint16_t* free );
+void stream_status( uint8_t stack_id, uint8_t stream_id, uint16_t* pending, uint16_t* free );
 
 /*!
  * @brief    get the stream port
- * @param   [in]  void
+ * @param   [in]  stack_id            Stack identifier
+ * @param   [in]  stream_id           Stream identifier
  * @retval  [out] port
  */
-uint8_t stream_get_port( uint8_t stack_id );
+uint8_t stream_get_port( uint8_t stack_id, uint8_t stream_id );
 
 /**
  * @brief get stream redundancy
  *
  * @param [in] stack_id            Stack identifier
+ * @param [in] stream_id           Stream identifier
  * @retval stream_rr stream redundancy
  */
-uint8_t stream_get_rr( uint8_t stack_id );
+uint8_t stream_get_rr( uint8_t stack_id, uint8_t stream_id );
 
 /**
  * @brief set stream redundancy
  *
  * @param [in] stack_id            Stack identifier
+ * @param [in] stream_id           Stream identifier
  * @param [in] stream_rr           stream redundancy
  * @retval void
  */
-void stream_set_rr( uint8_t stack_id, uint8_t stream_rr );
+void stream_set_rr( uint8_t stack_id, uint8_t stream_id, uint8_t stream_rr );
 
 /**
- * @brief Stop properly stream service
+ * @brief Stop properly stream service, all streams of the stack are reset
  *
  * @param [in] stack_id Stack identifier
  */
@@ -129,6 +129,7 @@ struct
 static uint32_t supervisor_check_user_alarm( void );
 static uint32_t supervisor_run_lorawan_engine( uint8_t stack_id );
 static uint32_t supervisor_find_next_task( void );
+static void     supervisor_set_task_pending( uint8_t task_index, bool pending );
 
 static void supervisor_idle_task_on_launch( void* context );
 static void supervisor_idle_task_on_update( void* context );
@@ -142,6 +143,9 @@ void modem_supervisor_init( void )
 {
     memset( &task_manager, 0, sizeof( stask_manager ) );
 
+    // Pending tasks are tracked in a 32-bit mask per stack and pending stacks in a 32-bit mask
+    SMTC_MODEM_HAL_PANIC_ON_FAILURE( ( NUMBER_OF_TASKS <= 32 ) && ( NUMBER_OF_STACKS <= 32 ) );
+
     for( uint8_t i = 0; i < NUMBER_OF_TASKS * NUMBER_OF_STACKS; i++ )
     {
         task_manager.modem_task[i].priority       = TASK_FINISH;
@@ -215,6 +219,7 @@ task_valid_t modem_supervisor_remove_task( uint16_t id )
     {
         task_manager.modem_task[id].priority     = TASK_FINISH;
         task_manager.modem_task[id].task_enabled = false;
+        supervisor_set_task_pending( id, false );
         return TASK_VALID;
     }
     SMTC_MODEM_HAL_TRACE_ERROR( "modem_supervisor_remove_task id = %d unknown\n", id );
@@ -237,6 +242,7 @@ task_valid_t modem_supervisor_add_task( smodem_task* task )
         task_manager.modem_task[task_index].task_context      = task->task_context;
         task_manager.modem_task[task_index].task_enabled      = true;
         task_manager.modem_task[task_index].updated_locked    = task->updated_locked;
+        supervisor_set_task_pending( task_index, task->priority != TASK_FINISH );
         return TASK_VALID;
     }
     SMTC_MODEM_HAL_TRACE_ERROR( "modem_supervisor_add_task id = %d unknown\n", task->id );
@@ -290,6 +296,7 @@ uint32_t modem_supervisor_engine( void )
         task_manager.modem_task[task_manager.next_task_id].launched_timestamp = smtc_modem_hal_get_time_in_s( );
         supervisor_on_launch_func[CURRENT_TASK_ID]( supervisor_context_callback[CURRENT_TASK_ID] );
         task_manager.modem_task[task_manager.next_task_id].priority = TASK_FINISH;
+        supervisor_set_task_pending( task_manager.next_task_id, false );
     }
     uint32_t alarm                 = modem_get_user_alarm( );
     uint32_t user_alarm_in_seconds = MODEM_MAX_ALARM_S / 1000;
@@ -373,80 +380,74 @@ static uint32_t supervisor_run_lorawan_engine( uint8_t stack_id )
 
 static uint32_t supervisor_find_next_task( void )
 {
-    // Find stacks that can continue to send uplink frame in regard of duty-cycle regulation
-    int32_t dtc_ms                            = MODEM_MAX_TIME;
-    uint8_t available_stack[NUMBER_OF_STACKS] = { 0 };
+    int32_t         dtc_ms             = MODEM_MAX_TIME;
+    bool            dtc_evaluated      = false;
+    task_priority_t next_task_priority = TASK_FINISH;
+    int32_t         next_task_time     = MODEM_MAX_TIME;
+    bool            next_task_in_past  = false;
+    uint32_t        now_s              = smtc_modem_hal_get_time_in_s( );
 
-    for( uint8_t i = 0; i < NUMBER_OF_STACKS; i++ )
+    // Only the stacks and tasks flagged as pending are visited: the cost depends on the number of pending tasks
+    // instead of NUMBER_OF_TASKS * NUMBER_OF_STACKS
+    uint32_t stacks_mask = task_manager.pending_stacks_mask;
+    while( stacks_mask != 0 )
     {
-        int32_t dtc_ms_tmp = modem_duty_cycle_get_status( i );
-        if( dtc_ms_tmp <= 0 )
+        uint8_t stack_id = ( uint8_t ) __builtin_ctz( stacks_mask );
+        stacks_mask &= stacks_mask - 1;
+
+        if( task_manager.modem_is_suspended[stack_id] == true )
         {
-            available_stack[i] = 1;
+            continue;
         }
+
+        // Find if the stack can continue to send uplink frame in regard of duty-cycle regulation
+        int32_t dtc_ms_tmp      = modem_duty_cycle_get_status( stack_id );
+        bool    available_stack = ( dtc_ms_tmp <= 0 ) ? true : false;
+        dtc_evaluated           = true;
         if( dtc_ms > dtc_ms_tmp )
         {
             dtc_ms = dtc_ms_tmp;
         }
-    }
-
-    task_priority_t next_task_priority = TASK_FINISH;
-    int32_t         next_task_time     = MODEM_MAX_TIME;
 
-    // Find the highest priority task in the past
-    for( uint8_t stack_id = 0; stack_id < NUMBER_OF_STACKS; stack_id++ )
-    {
-        for( task_id_t k = 0; k < NUMBER_OF_TASKS; k++ )
+        uint32_t tasks_mask = task_manager.pending_tasks_mask[stack_id];
+        while( tasks_mask != 0 )
         {
-            uint8_t i = ( stack_id * NUMBER_OF_TASKS ) + k;
-            if( ( task_manager.modem_task[i].priority != TASK_FINISH ) &&
-                ( task_manager.modem_task[i].priority <= task_manager.modem_mute_with_priority[stack_id] ) &&
-                ( task_manager.modem_is_suspended[stack_id] == false ) )
+            task_id_t k = ( task_id_t ) __builtin_ctz( tasks_mask );
+            tasks_mask &= tasks_mask - 1;
+
+            uint8_t      i    = ( stack_id * NUMBER_OF_TASKS ) + k;
+            smodem_task* task = &task_manager.modem_task[i];
+
+            if( ( task->priority > task_manager.modem_mute_with_priority[stack_id] ) ||
+                ( ( available_stack == false ) && ( task->priority != TASK_BYPASS_DUTY_CYCLE ) ) )
             {
-                int32_t next_task_time_tmp =
-                    ( int32_t ) ( task_manager.modem_task[i].time_to_execute_s - smtc_modem_hal_get_time_in_s( ) );
-
-                if( ( next_task_time_tmp <= 0 ) && ( task_manager.modem_task[i].priority <= next_task_priority ) &&
-                    ( next_task_time_tmp <= next_task_time ) &&
-                    ( ( available_stack[stack_id] == 1 ) ||
-                      ( ( available_stack[stack_id] == 0 ) &&
-                        ( task_manager.modem_task[i].priority == TASK_BYPASS_DUTY_CYCLE ) ) ) )
+                continue;
+            }
+
+            int32_t next_task_time_tmp = ( int32_t ) ( task->time_to_execute_s - now_s );
+
+            if( next_task_time_tmp <= 0 )
+            {
+                // Highest priority task in the past
+                if( ( task->priority <= next_task_priority ) && ( next_task_time_tmp <= next_task_time ) )
                 {
-                    next_task_priority        = task_manager.modem_task[i].priority;
+                    next_task_in_past         = true;
+                    next_task_priority        = task->priority;
                     next_task_time            = next_task_time_tmp;
                     task_manager.next_task_id = ( task_id_t ) i;
                 }
             }
-        }
-    }
-
-    // No task in the past was found, select the least in the future for wake up
-    if( next_task_priority == TASK_FINISH )
-    {
-        for( uint8_t stack_id = 0; stack_id < NUMBER_OF_STACKS; stack_id++ )
-        {
-            for( task_id_t k = 0; k < NUMBER_OF_TASKS; k++ )
+            else if( ( next_task_in_past == false ) && ( next_task_time_tmp < next_task_time ) )
             {
-                uint8_t i = ( stack_id * NUMBER_OF_TASKS ) + k;
-                if( ( task_manager.modem_task[i].priority != TASK_FINISH ) &&
-                    ( task_manager.modem_task[i].priority <= task_manager.modem_mute_with_priority[stack_id] ) &&
-                    ( task_manager.modem_is_suspended[stack_id] == false ) )
-                {
-                    int32_t next_task_time_tmp =
-                        ( int32_t ) ( task_manager.modem_task[i].time_to_execute_s - smtc_modem_hal_get_time_in_s( ) );
-                    if( ( next_task_time_tmp < next_task_time ) &&
-                        ( ( available_stack[stack_id] == 1 ) ||
-                          ( ( available_stack[stack_id] == 0 ) &&
-                            ( task_manager.modem_task[i].priority == TASK_BYPASS_DUTY_CYCLE ) ) ) )
-                    {
-                        next_task_time            = next_task_time_tmp;
-                        task_manager.next_task_id = ( task_id_t ) i;
-                    }
-                }
+                // No task in the past found so far, keep the least in the future for wake up
+                next_task_time            = next_task_time_tmp;
+                task_manager.next_task_id = ( task_id_t ) i;
             }
         }
     }
-    if( ( dtc_ms > 0 ) && ( next_task_time == MODEM_MAX_TIME ) )
+
+    // Without any pending stack, dtc_ms still holds its init value and is not a duty-cycle remaining time
+    if( ( dtc_evaluated == true ) && ( dtc_ms > 0 ) && ( next_task_time == MODEM_MAX_TIME ) )
     {
         SMTC_MODEM_HAL_TRACE_WARNING_DEBUG( "Duty Cycle, remaining time: %dms\n", dtc_ms );
         task_manager.next_task_id = IDLE_TASK;
@@ -464,6 +465,26 @@ static uint32_t supervisor_find_next_task( void )
     }
 }
 
+static void supervisor_set_task_pending( uint8_t task_index, bool pending )
+{
+    uint8_t  stack_id = task_index / NUMBER_OF_TASKS;
+    uint32_t task_bit = ( uint32_t ) 1 << ( task_index % NUMBER_OF_TASKS );
+
+    if( pending == true )
+    {
+        task_manager.pending_tasks_mask[stack_id] |= task_bit;
+        task_manager.pending_stacks_mask |= ( uint32_t ) 1 << stack_id;
+    }
+    else
+    {
+        task_manager.pending_tasks_mask[stack_id] &= ~task_bit;
+        if( task_manager.pending_tasks_mask[stack_id] == 0 )
+        {
+            task_manager.pending_stacks_mask &= ~( ( uint32_t ) 1 << stack_id );
+        }
+    }
+}
+
 static void supervisor_idle_task_on_launch( void* context )
 {
 }
@@ -135,6 +135,8 @@ typedef struct stask_manager
     task_id_t       next_task_id;
     bool            modem_is_suspended[NUMBER_OF_STACKS];
     task_priority_t modem_mute_with_priority[NUMBER_OF_STACKS];
+    uint32_t        pending_tasks_mask[NUMBER_OF_STACKS];  //!< bit k set when task k of the stack is not TASK_FINISH
+    uint32_t        pending_stacks_mask;                   //!< bit n set when stack n has at least one pending task
 } stask_manager;
 
 /*
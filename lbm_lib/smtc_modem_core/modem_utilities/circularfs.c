@@ -39,6 +39,7 @@
 
 #include <inttypes.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "smtc_modem_hal_dbg_trace.h"
 #include "circularfs.h"
@@ -61,6 +62,17 @@
 // [0][0][0][F] formatting
 // [0][0][0][0] erasing
 
+/**
+ * Sector layout tag, stored next to the object version: a partition written with another sector header layout is
+ * reported as incompatible by circularfs_scan().
+ */
+#define SECTOR_LAYOUT 0x53554D32 /**< "SUM2": header with summary. */
+
+// summary, each field is programmed once between two erases
+// summary_full      [F] not full / [~count][count] full, count slots were valid when the sector got full
+// summary_garbage   [F] / [0] a slot was discarded after the read head, summary_full count is not exact anymore
+// summary_discarded [F] / [0] the read head left the sector, it only holds discarded slots
+
 typedef struct sector_header
 {
     uint64_t version;
@@ -68,6 +80,9 @@ typedef struct sector_header
     uint64_t status_in_used;
     uint64_t status_formating;
     uint64_t status_erasing;
+    uint64_t summary_full;
+    uint64_t summary_garbage;
+    uint64_t summary_discarded;
 } sector_header_t;
 
 static int32_t _sector_address( struct circularfs* fs, int32_t sector_offset )
@@ -75,6 +90,13 @@ static int32_t _sector_address( struct circularfs* fs, int32_t sector_offset )
     return ( fs->flash->sector_offset + sector_offset ) * fs->flash->sector_size;
 }
 
+static uint64_t _sector_version( struct circularfs* fs )
+{
+    return ( ( uint64_t ) SECTOR_LAYOUT << 32 ) | fs->version;
+}
+
+#if( MODEM_HAL_DBG_TRACE == MODEM_HAL_FEATURE_ON )
+// Only needed by circularfs_dump, the scan reads the whole header at once
 static int32_t _sector_get_version( struct circularfs* fs, int32_t sector, uint32_t* version )
 {
     sector_header_t status_tmp = { 0 };
@@ -83,34 +105,34 @@ static int32_t _sector_get_version( struct circularfs* fs, int32_t sector, uint3
     *version    = ( uint32_t ) status_tmp.version;
     return ret;
 }
-static int32_t _sector_get_status( struct circularfs* fs, int32_t sector, uint32_t* status )
-{
-    sector_header_t status_tmp = { 0 };
+#endif  // MODEM_HAL_DBG_TRACE
 
-    int32_t ret = fs->flash->read( fs->flash, _sector_address( fs, sector ), &status_tmp, sizeof( sector_header_t ) );
+static int32_t _sector_status_from_header( const sector_header_t* status_tmp, uint32_t* status )
+{
+    int32_t ret = 0;
 
-    if( ( status_tmp.status_free == ~0ULL ) && ( status_tmp.status_in_used == ~0ULL ) &&
-        ( status_tmp.status_formating == ~0ULL ) && ( status_tmp.status_erasing == ~0ULL ) )
+    if( ( status_tmp->status_free == ~0ULL ) && ( status_tmp->status_in_used == ~0ULL ) &&
+        ( status_tmp->status_formating == ~0ULL ) && ( status_tmp->status_erasing == ~0ULL ) )
     {
         *status = SECTOR_ERASED;
     }
-    else if( ( status_tmp.status_free == 0ULL ) && ( status_tmp.status_in_used == ~0ULL ) &&
-             ( status_tmp.status_formating == ~0ULL ) && ( status_tmp.status_erasing == ~0ULL ) )
+    else if( ( status_tmp->status_free == 0ULL ) && ( status_tmp->status_in_used == ~0ULL ) &&
+             ( status_tmp->status_formating == ~0ULL ) && ( status_tmp->status_erasing == ~0ULL ) )
     {
         *status = SECTOR_FREE;
     }
-    else if( ( status_tmp.status_free == 0ULL ) && ( status_tmp.status_in_used == 0ULL ) &&
-             ( status_tmp.status_formating == ~0ULL ) && ( status_tmp.status_erasing == ~0ULL ) )
+    else if( ( status_tmp->status_free == 0ULL ) && ( status_tmp->status_in_used == 0ULL ) &&
+             ( status_tmp->status_formating == ~0ULL ) && ( status_tmp->status_erasing == ~0ULL ) )
     {
         *status = SECTOR_IN_USE;
     }
-    else if( ( status_tmp.status_free == 0ULL ) && ( status_tmp.status_in_used == 0ULL ) &&
-             ( status_tmp.status_formating == 0ULL ) && ( status_tmp.status_erasing == ~0ULL ) )
+    else if( ( status_tmp->status_free == 0ULL ) && ( status_tmp->status_in_used == 0ULL ) &&
+             ( status_tmp->status_formating == 0ULL ) && ( status_tmp->status_erasing == ~0ULL ) )
     {
         *status = SECTOR_FORMATTING;
     }
-    else if( ( status_tmp.status_free == 0ULL ) && ( status_tmp.status_in_used == 0ULL ) &&
-             ( status_tmp.status_formating == 0ULL ) && ( status_tmp.status_erasing == 0ULL ) )
+    else if( ( status_tmp->status_free == 0ULL ) && ( status_tmp->status_in_used == 0ULL ) &&
+             ( status_tmp->status_formating == 0ULL ) && ( status_tmp->status_erasing == 0ULL ) )
     {
         *status = SECTOR_ERASING;
     }
@@ -121,6 +143,19 @@ static int32_t _sector_get_status( struct circularfs* fs, int32_t sector, uint32
     return ret;
 }
 
+static int32_t _sector_get_status( struct circularfs* fs, int32_t sector, uint32_t* status )
+{
+    sector_header_t status_tmp = { 0 };
+
+    int32_t ret = fs->flash->read( fs->flash, _sector_address( fs, sector ), &status_tmp, sizeof( sector_header_t ) );
+
+    if( _sector_status_from_header( &status_tmp, status ) != 0 )
+    {
+        ret = -1;
+    }
+    return ret;
+}
+
 static int32_t _sector_set_status( struct circularfs* fs, int32_t sector, uint32_t status )
 {
     uint64_t status_tmp = 0ULL;
@@ -164,12 +199,33 @@ static int32_t _sector_free( struct circularfs* fs, int32_t sector, bool guard )
     }
 
     fs->flash->sector_erase( fs->flash, sector_addr );
-    fs->flash->program( fs->flash, sector_addr + offsetof( struct sector_header, version ), &fs->version,
-                        sizeof( fs->version ) );
+    uint64_t version = _sector_version( fs );
+    fs->flash->program( fs->flash, sector_addr + offsetof( struct sector_header, version ), &version,
+                        sizeof( version ) );
     _sector_set_status( fs, sector, SECTOR_FREE );
     return 0;
 }
 
+/**
+ * Program a summary field of a sector, unless it was already (even partially) programmed.
+ */
+static void _sector_summary_set( struct circularfs* fs, int32_t sector, uint32_t field, uint64_t value )
+{
+    uint64_t current = 0ULL;
+    fs->flash->read( fs->flash, _sector_address( fs, sector ) + field, &current, sizeof( current ) );
+    if( current == ~0ULL )
+    {
+        fs->flash->program( fs->flash, _sector_address( fs, sector ) + field, &value, sizeof( value ) );
+    }
+}
+
+static bool _sector_summary_is_set( struct circularfs* fs, int32_t sector, uint32_t field )
+{
+    uint64_t current = ~0ULL;
+    fs->flash->read( fs->flash, _sector_address( fs, sector ) + field, &current, sizeof( current ) );
+    return current == 0ULL;
+}
+
 /**
  * @}
  * @defgroup slot status
@@ -256,6 +312,59 @@ static int32_t _slot_set_status( struct circularfs* fs, struct circularfs_loc* l
     return -1;
 }
 
+/**
+ * @}
+ * @defgroup sector summary
+ * @{
+ */
+
+/** Record the number of valid slots of a sector which just got full. */
+static void _sector_seal( struct circularfs* fs, int32_t sector )
+{
+    uint64_t summary = 0ULL;
+    uint32_t count   = 0;
+
+    fs->flash->read( fs->flash, _sector_address( fs, sector ) + offsetof( struct sector_header, summary_full ),
+                     &summary, sizeof( summary ) );
+    if( summary != ~0ULL )
+    {
+        return;
+    }
+    for( int32_t slot = 0; slot < fs->slots_per_sector; slot++ )
+    {
+        struct circularfs_loc loc    = { sector, slot, 0 };
+        uint32_t              status = 0;
+        _slot_get_status( fs, &loc, &status );
+        if( status == SLOT_VALID )
+        {
+            count++;
+        }
+    }
+    summary = ( ( uint64_t ) ( ~count ) << 32 ) | count;
+    fs->flash->program( fs->flash, _sector_address( fs, sector ) + offsetof( struct sector_header, summary_full ),
+                        &summary, sizeof( summary ) );
+}
+
+/**
+ * Get the number of valid slots of a sector from its summary.
+ * @returns false if the sector is not full or its summary is not exact, slots must then be checked one by one.
+ */
+static bool _sector_get_valid_count( struct circularfs* fs, int32_t sector, uint32_t* count )
+{
+    sector_header_t header;
+
+    fs->flash->read( fs->flash, _sector_address( fs, sector ), &header, sizeof( header ) );
+
+    uint32_t full = ( uint32_t ) header.summary_full;
+    if( ( header.summary_garbage != ~0ULL ) || ( ( uint32_t ) ( header.summary_full >> 32 ) != ~full ) ||
+        ( full > ( uint32_t ) fs->slots_per_sector ) )
+    {
+        return false;
+    }
+    *count = full;
+    return true;
+}
+
 /**
  * @}
  * @defgroup loc
@@ -270,7 +379,8 @@ static bool _loc_equal( struct circularfs_loc* a, struct circularfs_loc* b )
 /** Advance a location to the beginning of the next sector. */
 static void _loc_advance_sector( struct circularfs* fs, struct circularfs_loc* loc )
 {
-    loc->slot = 0;
+    loc->slot   = 0;
+    loc->offset = 0;
     loc->sector++;
     if( loc->sector >= fs->flash->sector_count )
     {
@@ -282,12 +392,315 @@ static void _loc_advance_sector( struct circularfs* fs, struct circularfs_loc* l
 static void _loc_advance_slot( struct circularfs* fs, struct circularfs_loc* loc )
 {
     loc->slot++;
+    loc->offset = 0;
     if( loc->slot >= fs->slots_per_sector )
     {
         _loc_advance_sector( fs, loc );
     }
 }
 
+/** Advance the read head to the next slot, recording the sector it leaves as discarded. */
+static void _read_advance_slot( struct circularfs* fs )
+{
+    int32_t sector = fs->read.sector;
+
+    _loc_advance_slot( fs, &fs->read );
+    if( fs->read.sector != sector )
+    {
+        _sector_summary_set( fs, sector, offsetof( struct sector_header, summary_discarded ), 0ULL );
+    }
+}
+
+/** Count the valid slots from a location up to the write head. */
+static int32_t _count_valid( struct circularfs* fs, struct circularfs_loc* from )
+{
+    int32_t count = 0;
+
+    /* Use a temporary loc for iteration. */
+    struct circularfs_loc loc = *from;
+    while( !_loc_equal( &loc, &fs->write ) )
+    {
+        uint32_t status = 0;
+
+        /* Whole sectors are counted from their summary when it is exact. */
+        if( ( loc.slot == 0 ) && ( loc.sector != fs->write.sector ) &&
+            ( _sector_get_valid_count( fs, loc.sector, &status ) == true ) )
+        {
+            count += status;
+            _loc_advance_sector( fs, &loc );
+            continue;
+        }
+
+        _slot_get_status( fs, &loc, &status );
+
+        if( status == SLOT_VALID )
+        {
+            count++;
+        }
+
+        _loc_advance_slot( fs, &loc );
+    }
+
+    /* The slot at the write head is counted once it holds records not read yet. */
+    if( fs->write.offset > loc.offset )
+    {
+        count++;
+    }
+
+    return count;
+}
+
+/** Count the slot at the write head if it holds records which were not read from a location. */
+static int32_t _count_write_slot( struct circularfs* fs, struct circularfs_loc* from )
+{
+    int32_t offset = _loc_equal( from, &fs->write ) ? from->offset : 0;
+    return ( fs->write.offset > offset ) ? 1 : 0;
+}
+
+/**
+ * Make the write sector writable, freeing the next sector to keep the invariant.
+ *
+ * There are three sectors involved in appending a value:
+ * - the sector where the append happens: it has to be writable
+ * - the next sector: it must be free (invariant)
+ * - the next-next sector: read & cursor heads are moved there if needed
+ */
+static int32_t _write_prepare( struct circularfs* fs )
+{
+    uint32_t status;
+
+    ///////////////////////////////////////
+    ////////////
+    /* Make sure the next sector is free. */
+    int32_t next_sector = ( fs->write.sector + 1 ) % fs->flash->sector_count;
+    _sector_get_status( fs, next_sector, &status );
+    if( status != SECTOR_FREE )
+    {
+        /* Next sector must be freed. But first... */
+
+        /* Move the read & cursor heads out of the way. */
+        if( fs->read.sector == next_sector )
+        {
+            _loc_advance_sector( fs, &fs->read );
+        }
+        if( fs->cursor.sector == next_sector )
+        {
+            _loc_advance_sector( fs, &fs->cursor );
+        }
+
+        /* Free the next sector. */
+        _sector_free( fs, next_sector, true );
+    }
+    ////////////
+    ///////////////////////////////////////
+
+    /* Now we can make sure the current write sector is writable. */
+    _sector_get_status( fs, fs->write.sector, &status );
+    if( status == SECTOR_FREE )
+    {
+        /* Free sector. Mark as used. */
+        _sector_set_status( fs, fs->write.sector, SECTOR_IN_USE );
+    }
+    else if( status != SECTOR_IN_USE )
+    {
+        SMTC_MODEM_HAL_TRACE_PRINTF( "circularfs_append: corrupted filesystem\r\n" );
+        return -1;
+    }
+    return 0;
+}
+
+/** Advance the write head to the next slot, summarizing the sector once full. */
+static void _write_advance_slot( struct circularfs* fs )
+{
+    int32_t write_sector = fs->write.sector;
+
+    _loc_advance_slot( fs, &fs->write );
+    if( fs->write.sector != write_sector )
+    {
+        _sector_seal( fs, write_sector );
+    }
+}
+
+/**
+ * @}
+ * @defgroup record
+ * @{
+ */
+
+// record, starting on a CIRCULARFS_RECORD_ALIGN boundary of the slot payload
+// [size lsb][size msb][data][0xFF padding up to the next boundary]
+// the records of a slot end at its first erased granule, a torn header is skipped one granule at a time so that
+// readers and the writer resuming after a reset agree on where records start
+
+/**
+ * Read the header of the record at a location.
+ * @returns Record size, 0 past the last record of the slot, -1 for a torn header.
+ */
+static int32_t _record_get_size( struct circularfs* fs, struct circularfs_loc* loc )
+{
+    uint8_t header[CIRCULARFS_RECORD_ALIGN];
+    bool    erased = true;
+
+    if( ( loc->offset + CIRCULARFS_RECORD_ALIGN ) > fs->object_size )
+    {
+        return 0;
+    }
+    fs->flash->read( fs->flash, _slot_address( fs, loc ) + sizeof( struct slot_header ) + loc->offset, header,
+                     sizeof( header ) );
+    for( uint8_t i = 0; i < sizeof( header ); i++ )
+    {
+        if( header[i] != 0xFF )
+        {
+            erased = false;
+        }
+    }
+    if( erased == true )
+    {
+        return 0;
+    }
+
+    int32_t size = header[0] | ( header[1] << 8 );
+    if( ( size == 0 ) || ( ( loc->offset + CIRCULARFS_RECORD_SPAN( size ) ) > fs->object_size ) )
+    {
+        return -1;
+    }
+    return size;
+}
+
+/** Advance a location past the record whose header was read. */
+static void _record_advance( struct circularfs_loc* loc, int32_t size )
+{
+    loc->offset += ( size > 0 ) ? CIRCULARFS_RECORD_SPAN( size ) : CIRCULARFS_RECORD_ALIGN;
+}
+
+/** Find where the next record of a slot has to be appended. */
+static int32_t _record_get_end( struct circularfs* fs, struct circularfs_loc* slot )
+{
+    struct circularfs_loc loc = { slot->sector, slot->slot, 0 };
+
+    while( 1 )
+    {
+        int32_t size = _record_get_size( fs, &loc );
+        if( size == 0 )
+        {
+            return loc.offset;
+        }
+        _record_advance( &loc, size );
+    }
+}
+
+/** Program a record at the write head, the data of its first and last granules being padded. */
+static void _record_program( struct circularfs* fs, const uint8_t* record, int32_t size )
+{
+    uint8_t granule[CIRCULARFS_RECORD_ALIGN];
+    int32_t address = _slot_address( fs, &fs->write ) + sizeof( struct slot_header ) + fs->write.offset;
+    int32_t head    = CIRCULARFS_RECORD_ALIGN - CIRCULARFS_RECORD_HEADER_SIZE;
+
+    head = ( size < head ) ? size : head;
+    memset( granule, 0xFF, sizeof( granule ) );
+    granule[0] = ( uint8_t ) size;
+    granule[1] = ( uint8_t ) ( size >> 8 );
+    memcpy( &granule[CIRCULARFS_RECORD_HEADER_SIZE], record, head );
+    fs->flash->program( fs->flash, address, granule, sizeof( granule ) );
+    address += CIRCULARFS_RECORD_ALIGN;
+    record += head;
+    size -= head;
+
+    int32_t body = size & ~( CIRCULARFS_RECORD_ALIGN - 1 );
+    if( body > 0 )
+    {
+        fs->flash->program( fs->flash, address, record, body );
+        address += body;
+        record += body;
+        size -= body;
+    }
+    if( size > 0 )
+    {
+        memset( granule, 0xFF, sizeof( granule ) );
+        memcpy( granule, record, size );
+        fs->flash->program( fs->flash, address, granule, sizeof( granule ) );
+    }
+}
+
+/**
+ * Commit the records of the slot at the write head.
+ * Reserved and valid states are programmed at once, and a slot of records left reserved by a power loss is still
+ * read: its records are checked one by one anyway.
+ */
+static void _record_commit( struct circularfs* fs )
+{
+    uint64_t status_tmp[2] = { 0ULL, 0ULL };
+
+    if( fs->write.offset == 0 )
+    {
+        return;
+    }
+    fs->flash->program( fs->flash, _slot_address( fs, &fs->write ) + offsetof( struct slot_header, status_reserved ),
+                        status_tmp, sizeof( status_tmp ) );
+    _write_advance_slot( fs );
+}
+
+/** Get the record at the read cursor, advancing it if requested. */
+static int32_t _record_fetch( struct circularfs* fs, void* record, int32_t* size, bool advance )
+{
+    struct circularfs_loc loc = fs->cursor;
+    int32_t               ret = -1;
+
+    /* Records of the slot at the write head are read before it is committed. */
+    while( ( _loc_equal( &loc, &fs->write ) == false ) || ( loc.offset < fs->write.offset ) )
+    {
+        uint32_t status      = SLOT_VALID;
+        int32_t  record_size = 0;
+
+        /* The slot status is checked when entering it. */
+        if( ( loc.offset == 0 ) && ( _loc_equal( &loc, &fs->write ) == false ) )
+        {
+            _slot_get_status( fs, &loc, &status );
+        }
+        if( ( status == SLOT_VALID ) || ( status == SLOT_RESERVED ) )
+        {
+            record_size = _record_get_size( fs, &loc );
+        }
+        if( record_size == 0 )
+        {
+            if( _loc_equal( &loc, &fs->write ) == true )
+            {
+                break;
+            }
+            _loc_advance_slot( fs, &loc );
+            continue;
+        }
+        if( record_size > 0 )
+        {
+            if( record != NULL )
+            {
+                fs->flash->read( fs->flash,
+                                 _slot_address( fs, &loc ) + sizeof( struct slot_header ) + loc.offset +
+                                     CIRCULARFS_RECORD_HEADER_SIZE,
+                                 record, record_size );
+            }
+            *size = record_size;
+            ret   = 0;
+        }
+        _record_advance( &loc, record_size );
+        if( ret == 0 )
+        {
+            break;
+        }
+    }
+
+    if( advance == true )
+    {
+        /* Leave a slot as soon as its last record is fetched, so that it is not counted anymore. */
+        if( ( ret == 0 ) && ( _loc_equal( &loc, &fs->write ) == false ) && ( _record_get_size( fs, &loc ) == 0 ) )
+        {
+            _loc_advance_slot( fs, &loc );
+        }
+        fs->cursor = loc;
+    }
+    return ret;
+}
+
 /**
  * @}
  */
@@ -332,10 +745,13 @@ int32_t circularfs_format( struct circularfs* fs, bool guard )
     /* Start reading & writing at the first sector. */
     fs->read.sector   = 0;
     fs->read.slot     = 0;
+    fs->read.offset   = 0;
     fs->write.sector  = 0;
     fs->write.slot    = 0;
+    fs->write.offset  = 0;
     fs->cursor.sector = 0;
     fs->cursor.slot   = 0;
+    fs->cursor.offset = 0;
 
     return 0;
 }
@@ -363,10 +779,11 @@ int32_t circularfs_scan( struct circularfs* fs )
         // struct sector_header header;
         // fs->flash->read( fs->flash, addr, &header, sizeof( header ) );
 
-        uint32_t header_version;
-        uint32_t header_status;
-        _sector_get_version( fs, sector, &header_version );
-        _sector_get_status( fs, sector, &header_status );
+        /* Read sector header once, the summary is used below. */
+        sector_header_t header;
+        uint32_t        header_status = 0xFF;
+        fs->flash->read( fs->flash, _sector_address( fs, sector ), &header, sizeof( header ) );
+        _sector_status_from_header( &header, &header_status );
 
         /* Detect partially-formatted partitions. */
         if( ( header_status == SECTOR_FORMATTING ) ||
@@ -393,9 +810,10 @@ int32_t circularfs_scan( struct circularfs* fs )
 
         /* Detect obsolete versions. We can't do this earlier because the version
          * could have been invalid due to a partial erase. */
-        if( header_version != fs->version )
+        if( header.version != _sector_version( fs ) )
         {
-            SMTC_MODEM_HAL_TRACE_PRINTF( "circularfs_scan: incompatible version 0x%08" PRIx32 "\r\n", header_version );
+            SMTC_MODEM_HAL_TRACE_PRINTF( "circularfs_scan: incompatible version 0x%08" PRIx32 "\r\n",
+                                         ( uint32_t ) header.version );
             return -1;
         }
 
@@ -441,32 +859,61 @@ int32_t circularfs_scan( struct circularfs* fs )
         write_sector = 0;
     }
 
-    /* Scan the write sector and skip all occupied slots at the beginning. */
-    fs->write.sector = write_sector;
-    fs->write.slot   = 0;
-    while( fs->write.sector == write_sector )
+    /* Find the first erased slot of the write sector. Slots are always written in order so occupied slots are all
+     * at the beginning, and a bisection is enough. */
+    int32_t first = 0;
+    int32_t last  = fs->slots_per_sector;
+    while( first < last )
     {
-        uint32_t status;
-        _slot_get_status( fs, &fs->write, &status );
+        struct circularfs_loc loc    = { write_sector, ( first + last ) / 2, 0 };
+        uint32_t              status = SLOT_GARBAGE;
+        _slot_get_status( fs, &loc, &status );
         if( status == SLOT_ERASED )
         {
-            break;
+            last = loc.slot;
         }
-
-        _loc_advance_slot( fs, &fs->write );
+        else
+        {
+            first = loc.slot + 1;
+        }
+    }
+    fs->write.sector = write_sector;
+    fs->write.slot   = first;
+    fs->write.offset = 0;
+    if( first == fs->slots_per_sector )
+    {
+        /* The sector is full: complete its summary if power was lost before, we're at the beginning of a FREE
+         * sector now. */
+        _sector_seal( fs, write_sector );
+        _loc_advance_sector( fs, &fs->write );
+    }
+    else
+    {
+        /* Resume appending records to the slot at the write head. */
+        fs->write.offset = _record_get_end( fs, &fs->write );
     }
-    /* If the sector was full, we're at the beginning of a FREE sector now. */
 
     /* Position the read head at the start of the first IN_USE sector, then skip
-     * over garbage/invalid slots until something of value is found or we reach
-     * the write head which means there's no data. */
+     * over discarded sectors and garbage/invalid slots until something of value
+     * is found or we reach the write head which means there's no data. */
     fs->read.sector = read_sector;
     fs->read.slot   = 0;
+    fs->read.offset = 0;
     while( !_loc_equal( &fs->read, &fs->write ) )
     {
-        uint32_t status;
+        uint32_t status = 0;
+
+        if( ( fs->read.slot == 0 ) && ( fs->read.sector != fs->write.sector ) &&
+            ( _sector_summary_is_set( fs, fs->read.sector, offsetof( struct sector_header, summary_discarded ) ) ==
+              true ) )
+        {
+            _loc_advance_sector( fs, &fs->read );
+            continue;
+        }
+
+        /* A slot of records left reserved by a power loss still holds records. */
         _slot_get_status( fs, &fs->read, &status );
-        if( status == SLOT_VALID )
+        if( ( status == SLOT_VALID ) || ( status == SLOT_RESERVED ) )
         {
             break;
         }
@@ -503,120 +950,78 @@ int32_t circularfs_count_estimate( struct circularfs* fs )
 {
     int32_t sector_diff = ( fs->write.sector - fs->read.sector + fs->flash->sector_count ) % fs->flash->sector_count;
 
-    return sector_diff * fs->slots_per_sector + fs->write.slot - fs->read.slot;
+    return sector_diff * fs->slots_per_sector + fs->write.slot - fs->read.slot + _count_write_slot( fs, &fs->read );
 }
 
 int32_t circularfs_count_estimate_from_last_fetch( struct circularfs* fs )
 {
     int32_t sector_diff = ( fs->write.sector - fs->cursor.sector + fs->flash->sector_count ) % fs->flash->sector_count;
 
-    return sector_diff * fs->slots_per_sector + fs->write.slot - fs->cursor.slot;
+    return sector_diff * fs->slots_per_sector + fs->write.slot - fs->cursor.slot +
+           _count_write_slot( fs, &fs->cursor );
 }
 
 int32_t circularfs_count_exact( struct circularfs* fs )
 {
-    int32_t count = 0;
-
-    /* Use a temporary loc for iteration. */
-    struct circularfs_loc loc = fs->read;
-    while( !_loc_equal( &loc, &fs->write ) )
-    {
-        uint32_t status = 0;
-        _slot_get_status( fs, &loc, &status );
-
-        if( status == SLOT_VALID )
-        {
-            count++;
-        }
-
-        _loc_advance_slot( fs, &loc );
-    }
-
-    return count;
+    return _count_valid( fs, &fs->read );
 }
 
 int32_t circularfs_count_exact_from_last_fetch( struct circularfs* fs )
 {
-    int32_t count = 0;
+    return _count_valid( fs, &fs->cursor );
+}
 
-    /* Use a temporary loc for iteration. */
-    struct circularfs_loc loc = fs->cursor;
-    while( !_loc_equal( &loc, &fs->write ) )
+int32_t circularfs_append( struct circularfs* fs, const void* object )
+{
+    if( _write_prepare( fs ) != 0 )
     {
-        uint32_t status = 0;
-        _slot_get_status( fs, &loc, &status );
+        return -1;
+    }
 
-        if( status == SLOT_VALID )
-        {
-            count++;
-        }
+    /* Preallocate slot. */
+    _slot_set_status( fs, &fs->write, SLOT_RESERVED );
 
-        _loc_advance_slot( fs, &loc );
-    }
+    /* Write object. */
+    fs->flash->program( fs->flash, _slot_address( fs, &fs->write ) + sizeof( struct slot_header ), object,
+                        fs->object_size );
 
-    return count;
+    /* Commit write. */
+    _slot_set_status( fs, &fs->write, SLOT_VALID );
+
+    _write_advance_slot( fs );
+
+    return 0;
 }
 
-int32_t circularfs_append( struct circularfs* fs, const void* object )
+int32_t circularfs_append_record( struct circularfs* fs, const void* record, int32_t size )
 {
-    uint32_t status;
+    int32_t span = CIRCULARFS_RECORD_SPAN( size );
 
-    /*
-     * There are three sectors involved in appending a value:
-     * - the sector where the append happens: it has to be writable
-     * - the next sector: it must be free (invariant)
-     * - the next-next sector: read & cursor heads are moved there if needed
-     */
-    ///////////////////////////////////////
-    ////////////
-    /* Make sure the next sector is free. */
-    int32_t next_sector = ( fs->write.sector + 1 ) % fs->flash->sector_count;
-    _sector_get_status( fs, next_sector, &status );
-    if( status != SECTOR_FREE )
+    if( ( size <= 0 ) || ( span > fs->object_size ) )
     {
-        /* Next sector must be freed. But first... */
-
-        /* Move the read & cursor heads out of the way. */
-        if( fs->read.sector == next_sector )
-        {
-            _loc_advance_sector( fs, &fs->read );
-        }
-        if( fs->cursor.sector == next_sector )
-        {
-            _loc_advance_sector( fs, &fs->cursor );
-        }
-
-        /* Free the next sector. */
-        _sector_free( fs, next_sector, true );
+        return -1;
     }
-    ////////////
-    ///////////////////////////////////////
 
-    /* Now we can make sure the current write sector is writable. */
-    _sector_get_status( fs, fs->write.sector, &status );
-    if( status == SECTOR_FREE )
+    /* Commit the slot at the write head when the record does not fit in it. */
+    if( ( fs->write.offset + span ) > fs->object_size )
     {
-        /* Free sector. Mark as used. */
-        _sector_set_status( fs, fs->write.sector, SECTOR_IN_USE );
+        _record_commit( fs );
     }
-    else if( status != SECTOR_IN_USE )
+
+    /* Sectors are prepared when the first record of a slot is written. */
+    if( ( fs->write.offset == 0 ) && ( _write_prepare( fs ) != 0 ) )
     {
-        SMTC_MODEM_HAL_TRACE_PRINTF( "circularfs_append: corrupted filesystem\r\n" );
         return -1;
     }
 
-    /* Preallocate slot. */
-    _slot_set_status( fs, &fs->write, SLOT_RESERVED );
-
-    /* Write object. */
-    fs->flash->program( fs->flash, _slot_address( fs, &fs->write ) + sizeof( struct slot_header ), object,
-                        fs->object_size );
+    _record_program( fs, record, size );
+    fs->write.offset += span;
 
-    /* Commit write. */
-    _slot_set_status( fs, &fs->write, SLOT_VALID );
-
-    /* Advance the write head. */
-    _loc_advance_slot( fs, &fs->write );
+    /* Commit the slot as soon as it is full. */
+    if( ( fs->write.offset + CIRCULARFS_RECORD_ALIGN ) > fs->object_size )
+    {
+        _record_commit( fs );
+    }
 
     return 0;
 }
@@ -644,13 +1049,24 @@ int32_t circularfs_fetch( struct circularfs* fs, void* object )
     return -1;
 }
 
+int32_t circularfs_fetch_record( struct circularfs* fs, void* record, int32_t* size )
+{
+    return _record_fetch( fs, record, size, true );
+}
+
+int32_t circularfs_peek_record( struct circularfs* fs, void* record, int32_t* size )
+{
+    return _record_fetch( fs, record, size, false );
+}
+
 int32_t circularfs_discard( struct circularfs* fs )
 {
     while( !_loc_equal( &fs->read, &fs->cursor ) )
     {
         _slot_set_status( fs, &fs->read, SLOT_GARBAGE );
-        _loc_advance_slot( fs, &fs->read );
+        _read_advance_slot( fs );
     }
+    fs->read.offset = fs->cursor.offset;
 
     return 0;
 }
@@ -677,6 +1093,8 @@ int32_t circularfs_discard_item_x_from_head_position( struct circularfs* fs, uin
             }
             if( status == SLOT_VALID )
             {
+                /* Valid count of the sector summary is no longer exact. */
+                _sector_summary_set( fs, loc.sector, offsetof( struct sector_header, summary_garbage ), 0ULL );
                 _slot_set_status( fs, &loc, SLOT_GARBAGE );
             }
         }
@@ -685,17 +1103,17 @@ int32_t circularfs_discard_item_x_from_head_position( struct circularfs* fs, uin
         count++;
     }
 
-    /* Move the read cursor to the next valid data */
+    /* Move the read cursor to the next valid data, stopping at a reserved slot as circularfs_scan() does */
     while( !_loc_equal( &fs->read, &fs->write ) )
     {
-        uint32_t status;
+        uint32_t status = 0;
         _slot_get_status( fs, &fs->read, &status );
-        if( status == SLOT_VALID )
+        if( ( status == SLOT_VALID ) || ( status == SLOT_RESERVED ) )
         {
             break;
         }
 
-        _loc_advance_slot( fs, &fs->read );
+        _read_advance_slot( fs );
     }
 
     return 0;
@@ -754,7 +1172,7 @@ void circularfs_dump( struct circularfs* fs )
 
         for( int32_t slot = 0; slot < fs->slots_per_sector; slot++ )
         {
-            struct circularfs_loc loc    = { sector, slot };
+            struct circularfs_loc loc    = { sector, slot, 0 };
             uint32_t              status = 0;
             _slot_get_status( fs, &loc, &status );
 
@@ -52,11 +52,21 @@ extern "C" {
  * --- PUBLIC MACROS -----------------------------------------------------------
  */
 
+/**
+ * Flash space taken by a record of size bytes in a slot: records are length prefixed and padded to the flash
+ * programming granule so that each granule is programmed once.
+ */
+#define CIRCULARFS_RECORD_SPAN( size ) \
+    ( ( ( size ) + CIRCULARFS_RECORD_HEADER_SIZE + CIRCULARFS_RECORD_ALIGN - 1 ) & ~( CIRCULARFS_RECORD_ALIGN - 1 ) )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
  */
 
+#define CIRCULARFS_RECORD_HEADER_SIZE 2 /**< Record length prefix, in bytes. */
+#define CIRCULARFS_RECORD_ALIGN 8       /**< Flash programming granule, records are aligned on it. */
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC TYPES ------------------------------------------------------------
@@ -100,6 +110,7 @@ struct circularfs_loc
 {
     int32_t sector;
     int32_t slot;
+    int32_t offset; /**< Record offset in the slot, always 0 for fixed size objects. */
 };
 
 /**
@@ -151,6 +162,7 @@ int32_t circularfs_format( struct circularfs* fs, bool guard );
 
 /**
  * Scan the flash memory for a valid filesystem.
+ * Reads one header per sector, then bisects the write sector.
  *
  * @param fs Initialized RingFS instance.
  * @returns Zero on success, -1 on failure.
@@ -180,7 +192,8 @@ int32_t circularfs_count_estimate_from_last_fetch( struct circularfs* fs );
 
 /**
  * Calculate exact object count.
- * Runs in O(n).
+ * Runs in O(sectors + slots per sector), full sectors being counted from their
+ * summary, O(n) only for sectors whose objects were discarded out of order.
  *
  * @param fs Initialized RingFS instance.
  * @returns Exact object count on success, -1 on failure.
@@ -198,6 +211,22 @@ int32_t circularfs_count_exact_from_last_fetch( struct circularfs* fs );
  */
 int32_t circularfs_append( struct circularfs* fs, const void* object );
 
+/**
+ * Append a variable length record at the end of the ring. Deletes oldest objects as needed.
+ *
+ * Records are packed in slots, object_size being then the size of a slot: a slot is committed once the next
+ * record does not fit in it anymore, records appended to the slot at the write head are kept across resets and
+ * can be fetched before it is committed. A ring stores either objects or records, object_size must be a multiple
+ * of CIRCULARFS_RECORD_ALIGN and the flash partition aligned on it. A record torn by a power loss may be fetched
+ * corrupted, its contents must be checked by the caller.
+ *
+ * @param fs Initialized RingFS instance.
+ * @param record Record to be stored.
+ * @param size Size of the record, CIRCULARFS_RECORD_SPAN( size ) must not exceed object_size.
+ * @returns Zero on success, -1 on failure.
+ */
+int32_t circularfs_append_record( struct circularfs* fs, const void* record, int32_t size );
+
 /**
  * Fetch next object from the ring, oldest-first. Advances read cursor.
  *
@@ -207,8 +236,30 @@ int32_t circularfs_append( struct circularfs* fs, const void* object );
  */
 int32_t circularfs_fetch( struct circularfs* fs, void* object );
 
+/**
+ * Fetch next record from the ring, oldest-first. Advances read cursor.
+ *
+ * @param fs Initialized RingFS instance.
+ * @param record Buffer of object_size bytes to store retrieved record, NULL to skip it.
+ * @param size Size of the retrieved record.
+ * @returns Zero on success, -1 on failure.
+ */
+int32_t circularfs_fetch_record( struct circularfs* fs, void* record, int32_t* size );
+
+/**
+ * Get next record from the ring without advancing read cursor.
+ *
+ * @param fs Initialized RingFS instance.
+ * @param record Buffer of object_size bytes to store retrieved record, NULL to only get its size.
+ * @param size Size of the retrieved record.
+ * @returns Zero on success, -1 on failure.
+ */
+int32_t circularfs_peek_record( struct circularfs* fs, void* record, int32_t* size );
+
 /**
  * Discard all fetched objects up to the read cursor.
+ * A slot of records is discarded once all its records are, the ones fetched from a slot still holding records
+ * not fetched yet are fetched again after a reset.
  *
  * @param fs Initialized RingFS instance.
  * @returns Zero on success, -1 on failure.
@@ -467,11 +467,24 @@ void modem_downlink_callback( lr1_stack_mac_down_data_t* rx_down_data )
         metadata.rssi = ( int8_t ) ( rx_down_data->rx_metadata.rx_rssi + 64 );
     }
 
-    for( uint8_t i = 0; i < NUMBER_OF_SERVICES + NUMBER_OF_LORAWAN_MANAGEMENT_TASKS; i++ )
+    // LoRaWAN management tasks receive every downlink event
+    for( uint8_t i = 0; i < NUMBER_OF_LORAWAN_MANAGEMENT_TASKS; i++ )
     {
         downlink_used_by_services += downlink_services_callback[i]( rx_down_data );
     }
 
+    // Services registered on an FPort only receive the frames of this FPort
+    for( uint8_t i = 0; i < NUMBER_OF_SERVICES; i++ )
+    {
+        uint8_t fport = modem_service_config[i].downlink_fport;
+        if( ( fport == MODEM_SERVICE_ANY_FPORT ) || ( ( rx_down_data->rx_metadata.rx_fport_present == true ) &&
+                                                      ( rx_down_data->rx_metadata.rx_fport == fport ) ) )
+        {
+            downlink_used_by_services +=
+                downlink_services_callback[i + NUMBER_OF_LORAWAN_MANAGEMENT_TASKS]( rx_down_data );
+        }
+    }
+
     if( rx_down_data->rx_metadata.rx_window == RECEIVE_NONE )
     {
         return;
@@ -488,7 +501,11 @@ void modem_downlink_callback( lr1_stack_mac_down_data_t* rx_down_data )
         }
         else
         {
-            increment_asynchronous_msgnumber( SMTC_MODEM_EVENT_DOWNDATA, 0, rx_down_data->stack_id );
+            modem_event_payload_t payload = { 0 };
+            payload.downdata.rssi         = metadata.rssi;
+            payload.downdata.snr          = metadata.snr;
+            payload.downdata.fport        = metadata.fport;
+            modem_event_push( SMTC_MODEM_EVENT_DOWNDATA, 0, rx_down_data->stack_id, &payload );
             fifo_ctrl_print_stat( &fifo_ctrl_obj );
         }
     }
@@ -38,6 +38,7 @@
  */
 #include <stdint.h>   // C99 types
 #include <stdbool.h>  // bool type
+#include <string.h>   // memset
 
 #include "modem_event_utilities.h"
 #include "smtc_modem_hal_dbg_trace.h"
@@ -47,19 +48,17 @@
  */
 struct
 {
-    uint8_t asynchronous_msgnumber;
-    uint8_t modem_event_stack_id[MODEM_NUMBER_OF_EVENTS];
-    uint8_t modem_event_count[MODEM_NUMBER_OF_EVENTS];
-    uint8_t modem_event_status[MODEM_NUMBER_OF_EVENTS];
-    uint8_t asynch_msg[MODEM_NUMBER_OF_EVENTS];
+    modem_event_record_t queue[MODEM_EVENT_QUEUE_SIZE + 1];  // one slot is kept free to tell full from empty
+    uint8_t              queue_wr;  // index of the next record to push, only written by the producer
+    uint8_t              queue_rd;  // index of the next record to pop, only written by the consumer
+    uint32_t             overflow_count;
     void ( *app_callback )( void );
 } modem_event_ctx;
 
-#define asynchronous_msgnumber modem_event_ctx.asynchronous_msgnumber
-#define modem_event_count modem_event_ctx.modem_event_count
-#define modem_event_stack_id modem_event_ctx.modem_event_stack_id
-#define modem_event_status modem_event_ctx.modem_event_status
-#define asynch_msg modem_event_ctx.asynch_msg
+#define queue modem_event_ctx.queue
+#define queue_wr modem_event_ctx.queue_wr
+#define queue_rd modem_event_ctx.queue_rd
+#define overflow_count modem_event_ctx.overflow_count
 #define app_callback modem_event_ctx.app_callback
 
 /*
@@ -76,109 +75,138 @@ struct
  * -----------------------------------------------------------------------------
  * --- PRIVATE FUNCTIONS DECLARATION -------------------------------------------
  */
+
+/**
+ * @brief Merge an event into the most recent pending record of the same type and stack
+ *
+ * @param [in] event_type type of asynchronous message
+ * @param [in] status     status of asynchronous message
+ * @param [in] stack_id   stack identifier
+ * @param [in] payload    data of the event, NULL if the event has none
+ * @return true if a record has been found and updated
+ */
+static bool modem_event_coalesce( uint8_t event_type, uint8_t status, uint8_t stack_id,
+                                  const modem_event_payload_t* payload );
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC FUNCTIONS DEFINITION ---------------------------------------------
  */
 void modem_event_init( void ( *callback )( void ) )
 {
-    for( int i = 0; i < MODEM_NUMBER_OF_EVENTS; i++ )
-    {
-        set_modem_event_count_and_status( i, 0, 0 );
-    }
-    asynchronous_msgnumber = 0;
-    app_callback           = callback;
+    queue_wr       = 0;
+    queue_rd       = 0;
+    overflow_count = 0;
+    app_callback   = callback;
 }
-uint8_t get_modem_event_count( smtc_modem_event_type_t event_type )
+
+uint8_t get_asynchronous_msgnumber( void )
 {
-    if( event_type >= MODEM_NUMBER_OF_EVENTS )
-    {
-        SMTC_MODEM_HAL_PANIC( );
-    }
+    return ( uint8_t ) ( ( queue_wr + MODEM_EVENT_QUEUE_SIZE + 1 - queue_rd ) % ( MODEM_EVENT_QUEUE_SIZE + 1 ) );
+}
 
-    return ( modem_event_count[event_type] );
+void increment_asynchronous_msgnumber( uint8_t event_type, uint8_t status, uint8_t stack_id )
+{
+    modem_event_push( event_type, status, stack_id, NULL );
 }
 
-uint8_t get_modem_event_status( uint8_t event_type )
+void modem_event_push( uint8_t event_type, uint8_t status, uint8_t stack_id, const modem_event_payload_t* payload )
 {
     if( event_type >= MODEM_NUMBER_OF_EVENTS )
     {
-        SMTC_MODEM_HAL_PANIC( );
+        return;
     }
-    return ( modem_event_status[event_type] );
-}
 
-void set_modem_event_count_and_status( uint8_t event_type, uint8_t value, uint8_t status )
-{
-    if( event_type < MODEM_NUMBER_OF_EVENTS )
+    // Past the headroom, repeated events are merged so that the remaining slots stay available for the other types:
+    // the records beyond the first of each type and stack never exceed the headroom, so the queue cannot be full
+    // while a type and stack has no pending record
+    uint8_t next_wr = ( queue_wr + 1 ) % ( MODEM_EVENT_QUEUE_SIZE + 1 );
+    if( ( get_asynchronous_msgnumber( ) >= ( MODEM_EVENT_QUEUE_SIZE - MODEM_EVENT_RECORD_KEYS ) ) &&
+        ( modem_event_coalesce( event_type, status, stack_id, payload ) == true ) )
     {
-        modem_event_count[event_type]  = value;
-        modem_event_status[event_type] = status;
+        overflow_count++;
     }
-}
-
-void increment_modem_event_count_and_status( uint8_t event_type, uint8_t status )
-{
-    if( event_type < MODEM_NUMBER_OF_EVENTS )
+    else if( next_wr == queue_rd )
+    {
+        // Only reached with a stack_id out of the keys accounted in MODEM_EVENT_RECORD_KEYS
+        overflow_count++;
+        SMTC_MODEM_HAL_TRACE_WARNING( "Event queue full, event %d dropped\n", event_type );
+    }
+    else
     {
-        if( modem_event_count[event_type] < 255 )
+        modem_event_record_t* record = &queue[queue_wr];
+
+        record->timestamp_ms  = smtc_modem_hal_get_time_in_ms( );
+        record->event_type    = event_type;
+        record->status        = status;
+        record->stack_id      = stack_id;
+        record->missed_events = 0;
+        if( payload != NULL )
+        {
+            record->payload = *payload;
+        }
+        else
         {
-            modem_event_count[event_type]++;
+            memset( &record->payload, 0, sizeof( record->payload ) );
         }
-        // Set last status even if the number of event max is reached
-        modem_event_status[event_type] = status;
+
+        // Publish the record only once it is complete
+        queue_wr = next_wr;
     }
-}
 
-void decrement_asynchronous_msgnumber( void )
-{
-    if( asynchronous_msgnumber > 0 )
+    if( *app_callback != NULL )
     {
-        asynchronous_msgnumber--;
+        app_callback( );
     }
-    else
+}
+
+bool modem_event_pop( modem_event_record_t* record )
+{
+    if( queue_rd == queue_wr )
     {
-        asynchronous_msgnumber = 0;
+        return false;
     }
+    *record  = queue[queue_rd];
+    queue_rd = ( queue_rd + 1 ) % ( MODEM_EVENT_QUEUE_SIZE + 1 );
+    return true;
 }
 
-uint8_t get_asynchronous_msgnumber( void )
+uint32_t modem_event_get_overflow_count( void )
 {
-    return ( asynchronous_msgnumber );
+    return overflow_count;
 }
 
-void increment_asynchronous_msgnumber( uint8_t event_type, uint8_t status, uint8_t stack_id )
-{
-    // Next condition should never append because only one asynch msg by type of message
-    if( asynchronous_msgnumber >= MODEM_NUMBER_OF_EVENTS )
-    {
-        return;
-    }
-    uint8_t tmp;
-    tmp = get_modem_event_count( event_type );
+/*
+ * -----------------------------------------------------------------------------
+ * --- PRIVATE FUNCTIONS DEFINITION --------------------------------------------
+ */
 
-    if( tmp == 0 )
+static bool modem_event_coalesce( uint8_t event_type, uint8_t status, uint8_t stack_id,
+                                  const modem_event_payload_t* payload )
+{
+    uint8_t idx = queue_wr;
+    while( idx != queue_rd )
     {
-        asynch_msg[asynchronous_msgnumber] = event_type;
-        asynchronous_msgnumber++;
-    }
-
-    increment_modem_event_count_and_status( event_type, status );
-    modem_event_stack_id[event_type] = stack_id;
+        idx = ( idx + MODEM_EVENT_QUEUE_SIZE ) % ( MODEM_EVENT_QUEUE_SIZE + 1 );
 
-    if( *app_callback != NULL )
-    {
-        app_callback( );
+        modem_event_record_t* record = &queue[idx];
+        if( ( record->event_type == event_type ) && ( record->stack_id == stack_id ) )
+        {
+            if( record->missed_events < 255 )
+            {
+                record->missed_events++;
+            }
+            // Keep the last status as the previous implementation did, the timestamp stays the one of the first
+            // occurrence so that the queue remains ordered
+            record->status = status;
+            if( payload != NULL )
+            {
+                record->payload = *payload;
+            }
+            return true;
+        }
     }
+    return false;
 }
 
-uint8_t get_last_msg_event( uint8_t* stack_id )
-{
-    if( asynchronous_msgnumber > 0 )
-    {
-        *stack_id = modem_event_stack_id[asynch_msg[asynchronous_msgnumber - 1]];
-        return asynch_msg[asynchronous_msgnumber - 1];
-    }
-    *stack_id = 0xFF;
-    return 0xFF;
-}
+/* --- EOF ------------------------------------------------------------------ */
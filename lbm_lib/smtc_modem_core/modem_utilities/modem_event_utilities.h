@@ -45,6 +45,51 @@ extern "C" {
 
 #define MODEM_NUMBER_OF_EVENTS SMTC_MODEM_EVENT_MAX  // number of possible events in modem
 
+// Each event type is pushed either for a stack or for no stack (RESET, ALARM): at most one record per key is needed
+#define MODEM_EVENT_RECORD_KEYS ( MODEM_NUMBER_OF_EVENTS * NUMBER_OF_STACKS )
+
+#ifndef MODEM_EVENT_QUEUE_HEADROOM
+#define MODEM_EVENT_QUEUE_HEADROOM 8  // number of records kept for repeated events before they are merged
+#endif
+
+#ifndef MODEM_EVENT_QUEUE_SIZE
+#define MODEM_EVENT_QUEUE_SIZE ( MODEM_EVENT_RECORD_KEYS + MODEM_EVENT_QUEUE_HEADROOM )  // number of pending records
+#endif
+
+#if( MODEM_EVENT_QUEUE_SIZE < MODEM_EVENT_RECORD_KEYS ) || ( MODEM_EVENT_QUEUE_SIZE > 254 )
+#error "MODEM_EVENT_QUEUE_SIZE must hold one record per event type and stack, and at most 254 records"
+#endif
+
+/**
+ * @brief Per-occurrence data carried inline by the event records, zeroed for the events without data
+ */
+typedef union modem_event_payload_u
+{
+    struct
+    {
+        uint32_t fcnt_up;  // frame counter of the uplink
+    } txdone;
+    struct
+    {
+        int8_t  rssi;   // signed value in dBm + 64, as in the downlink metadata
+        int8_t  snr;    // signed value in dB given in 0.25dB step, as in the downlink metadata
+        uint8_t fport;  // FPort of the downlink
+    } downdata;
+} modem_event_payload_t;
+
+/**
+ * @brief Event record stored in the event queue, in the order the events occurred
+ */
+typedef struct modem_event_record_s
+{
+    uint32_t              timestamp_ms;   // modem time when the event occurred (first occurrence if events were merged)
+    uint8_t               event_type;     // type of event as defined in @ref smtc_modem_event_type_t
+    uint8_t               status;         // status of event
+    uint8_t               stack_id;       // stack identifier, 0xFF if not linked to a stack
+    uint8_t               missed_events;  // number of events of the same type and stack merged in this record
+    modem_event_payload_t payload;        // data of the event (last occurrence if events were merged)
+} modem_event_record_t;
+
 /*!
  * \brief init context of event
  *
@@ -53,68 +98,53 @@ extern "C" {
  * \return clear the context
  */
 void modem_event_init( void ( *callback )( void ) );
-/*!
- * \brief For each type of event have to manage a counter in case of overrun
- *
- * \param [in] event_type Type of event
- *
- * \return The number of asynchronous events for this type of event since the last get event cmd
- */
-uint8_t get_modem_event_count( smtc_modem_event_type_t event_type );
-/*!
- * \brief For each type of event have to manage a status
- *
- * \param [in] event_type  type of event
- *
- * \return The last status of asynchronous event for this type of event since the last get event cmd
- */
-uint8_t get_modem_event_status( uint8_t event_type );
 
 /*!
- * \brief set a value in the counter of a type of asynchronous event
+ * \brief push an asynchronous event at the tail of the event queue
  *
- * \param [in] event_type type of event
- * \param [in] value      value's type of event
- * \param [in] status     status of event
- */
-void set_modem_event_count_and_status( uint8_t event_type, uint8_t value, uint8_t status );
-
-/*!
- * \brief increment the counter of a type of asynchronous event
+ * \remark Once MODEM_EVENT_QUEUE_SIZE - MODEM_EVENT_RECORD_KEYS records are pending, an event is merged into the last
+ *         pending record of the same type and stack if there is one, and increments the overflow counter. The slots
+ *         left are enough for one record per type and stack, so an event type is never dropped.
  *
  * \param [in] event_type type of asynchronous message
  * \param [in] status     status of asynchronous message
+ * \param [in] stack_id   stack identifier
  */
-void increment_modem_event_count_and_status( uint8_t event_type, uint8_t status );
-
-/*!
- * \brief decrement the asynchronous message number
- * \retval void
- */
-void decrement_asynchronous_msgnumber( void );
+void increment_asynchronous_msgnumber( uint8_t event_type, uint8_t status, uint8_t stack_id );
 
 /*!
- * \brief increment the asynchronous message number
+ * \brief push an asynchronous event with its inline data at the tail of the event queue
+ *
+ * \remark Same merge behavior as increment_asynchronous_msgnumber, a merged record takes the new data
  *
  * \param [in] event_type type of asynchronous message
  * \param [in] status     status of asynchronous message
+ * \param [in] stack_id   stack identifier
+ * \param [in] payload    data of the event, NULL if the event has none
  */
-void increment_asynchronous_msgnumber( uint8_t event_type, uint8_t status, uint8_t stack_id );
+void modem_event_push( uint8_t event_type, uint8_t status, uint8_t stack_id, const modem_event_payload_t* payload );
 
 /*!
  * \brief get asynchronous message number
  *
- * \return The number of asynchronous message
+ * \return The number of pending records in the event queue
  */
 uint8_t get_asynchronous_msgnumber( void );
 
 /**
- * @brief Get the last message event if asynchronous msgnumber is positive
+ * @brief Pop the oldest event record from the event queue
+ *
+ * @param [out] record The oldest pending event record
+ * @return true if a record has been popped, false if the queue is empty
+ */
+bool modem_event_pop( modem_event_record_t* record );
+
+/**
+ * @brief Get the number of events that did not get their own record since the modem init
  *
- * @param stack_id The Stack Identifier
- * @return uint8_t the last available modem event
+ * @return uint32_t overflow counter
  */
-uint8_t get_last_msg_event( uint8_t* stack_id );
+uint32_t modem_event_get_overflow_count( void );
 
 #ifdef __cplusplus
 }
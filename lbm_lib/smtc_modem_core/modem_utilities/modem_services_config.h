@@ -99,6 +99,11 @@ extern "C" {
 #include "store_and_forward.h"
 #endif
 
+/**
+ * @brief Value of downlink_fport for a service whose downlink handler is called on every downlink event
+ */
+#define MODEM_SERVICE_ANY_FPORT 0
+
 typedef struct modem_service_config_s
 {
     uint8_t service_id;  // Start to 0 for new type of services, increment this number for multiple instantiation of the
@@ -108,6 +113,8 @@ typedef struct modem_service_config_s
                                       uint8_t ( **callback )( lr1_stack_mac_down_data_t* ),
                                       void ( **callback_on_launch )( void* ), void ( **callback_on_update )( void* ),
                                       void** callback_context );
+    uint8_t downlink_fport;  // FPort of the only downlinks handled by the service, MODEM_SERVICE_ANY_FPORT to receive
+                             // every downlink event (join accept, no downlink, beacon, other FPorts)
 
 } modem_service_config_t;
 
@@ -123,13 +130,25 @@ static modem_service_config_t modem_service_config[] = {
     { .service_id = 0, .stack_id = 0, .callbacks_init_service = lorawan_alcsync_services_init },
 #endif
 #ifdef ADD_FUOTA
-    { .service_id = 0, .stack_id = 0, .callbacks_init_service = lorawan_fragmentation_package_services_init },
-    { .service_id = 0, .stack_id = 0, .callbacks_init_service = lorawan_remote_multicast_setup_package_services_init },
+    { .service_id             = 0,
+      .stack_id               = 0,
+      .callbacks_init_service = lorawan_fragmentation_package_services_init,
+      .downlink_fport         = FRAGMENTATION_PORT },
+    { .service_id             = 0,
+      .stack_id               = 0,
+      .callbacks_init_service = lorawan_remote_multicast_setup_package_services_init,
+      .downlink_fport         = REMOTE_MULTICAST_SETUP_PORT },
 #ifdef ENABLE_FUOTA_FMP
-    { .service_id = 0, .stack_id = 0, .callbacks_init_service = lorawan_fmp_package_services_init },
+    { .service_id             = 0,
+      .stack_id               = 0,
+      .callbacks_init_service = lorawan_fmp_package_services_init,
+      .downlink_fport         = FMP_PORT },
 #endif
 #ifdef ENABLE_FUOTA_MPA
-    { .service_id = 0, .stack_id = 0, .callbacks_init_service = lorawan_mpa_package_services_init },
+    { .service_id             = 0,
+      .stack_id               = 0,
+      .callbacks_init_service = lorawan_mpa_package_services_init,
+      .downlink_fport         = MPA_PORT },
 #endif
 #endif
 #ifdef ADD_ALMANAC
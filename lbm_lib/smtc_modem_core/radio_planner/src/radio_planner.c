@@ -882,6 +882,7 @@ static void rp_task_launch_current( radio_planner_t* rp )
     {
         rp_task_print( rp, &rp->tasks[id] );
         rp->radio = TARGET_RADIO;
+        rp->launched_task_cnt++;
         rp->tasks[id].launch_task_callbacks( ( void* ) rp );
     }
 }
@@ -98,6 +98,7 @@ typedef struct radio_planner_s
     const ralf_t*          radio;
     const ralf_t*          radio_target_attached_to_this_hook[RP_NB_HOOKS];
     uint32_t               margin_delay;
+    uint32_t               launched_task_cnt;  // number of launched tasks, tells a hook if others used the radio
 } radio_planner_t;
 
 /*
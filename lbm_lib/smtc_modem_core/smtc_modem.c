@@ -555,7 +555,8 @@ smtc_modem_return_code_t smtc_modem_adr_set_profile(
         }
     }
     if( ( adr_profile == SMTC_MODEM_ADR_PROFILE_MOBILE_LONG_RANGE ) ||
-        ( adr_profile == SMTC_MODEM_ADR_PROFILE_MOBILE_LOW_POWER ) || ( adr_profile == SMTC_MODEM_ADR_PROFILE_CUSTOM ) )
+        ( adr_profile == SMTC_MODEM_ADR_PROFILE_MOBILE_LOW_POWER ) || ( adr_profile == SMTC_MODEM_ADR_PROFILE_CUSTOM ) ||
+        ( adr_profile == SMTC_MODEM_ADR_PROFILE_MOBILE_LINK_ADAPTIVE ) )
     {
         // reset current adr mobile count
         lorawan_api_reset_no_rx_packet_in_mobile_mode_cnt( stack_id );
@@ -576,6 +577,10 @@ smtc_modem_return_code_t smtc_modem_adr_set_profile(
         // update profile in lorawan stack
         status = lorawan_api_dr_strategy_set( MOBILE_LOWPER_DR_DISTRIBUTION, stack_id );
         break;
+    case SMTC_MODEM_ADR_PROFILE_MOBILE_LINK_ADAPTIVE:
+        // update profile in lorawan stack
+        status = lorawan_api_dr_strategy_set( MOBILE_LINK_ADAPTIVE_DR, stack_id );
+        break;
     case SMTC_MODEM_ADR_PROFILE_CUSTOM: {
         uint16_t mask_dr_allowed = lorawan_api_mask_tx_dr_channel_up_dwell_time_check( stack_id );
         uint8_t  adr_distribution_tab[SMTC_MODEM_CUSTOM_ADR_DATA_LENGTH] = { 0 };
@@ -639,6 +644,9 @@ smtc_modem_return_code_t smtc_modem_adr_get_profile( uint8_t stack_id, smtc_mode
     case USER_DR_DISTRIBUTION:
         *adr_profile = SMTC_MODEM_ADR_PROFILE_CUSTOM;
         break;
+    case MOBILE_LINK_ADAPTIVE_DR:
+        *adr_profile = SMTC_MODEM_ADR_PROFILE_MOBILE_LINK_ADAPTIVE;
+        break;
     default:
         return_code = SMTC_MODEM_RC_FAIL;
         break;
@@ -711,20 +719,16 @@ smtc_modem_return_code_t smtc_modem_get_event( smtc_modem_event_t* event, uint8_
     RETURN_INVALID_IF_NULL( event_pending_count );
 
     smtc_modem_return_code_t return_code = SMTC_MODEM_RC_OK;
-    const uint8_t            event_count = get_asynchronous_msgnumber( );
+    modem_event_record_t     record;
 
-    if( event_count > MODEM_NUMBER_OF_EVENTS )
-    {
-        SMTC_MODEM_HAL_PANIC( "asynchronous_msgnumber overlap" );
-    }
-    else if( event_count > 0 )
+    if( modem_event_pop( &record ) == true )
     {
-        uint8_t stack_id;
-        event->event_type    = ( smtc_modem_event_type_t ) get_last_msg_event( &stack_id );
-        event->stack_id      = stack_id;
-        event->missed_events = get_modem_event_count( event->event_type ) - 1;
+        event->event_type    = ( smtc_modem_event_type_t ) record.event_type;
+        event->stack_id      = record.stack_id;
+        event->missed_events = record.missed_events;
+        event->timestamp_ms  = record.timestamp_ms;
 
-        *event_pending_count = event_count - 1;
+        *event_pending_count = get_asynchronous_msgnumber( );
 
         switch( event->event_type )
         {
@@ -732,80 +736,76 @@ smtc_modem_return_code_t smtc_modem_get_event( smtc_modem_event_t* event, uint8_
             event->event_data.reset.count = ( uint16_t ) modem_get_reset_counter( );
             break;
         case SMTC_MODEM_EVENT_TXDONE:
-            event->event_data.txdone.status =
-                ( smtc_modem_event_txdone_status_t ) get_modem_event_status( event->event_type );
+            event->event_data.txdone.status  = ( smtc_modem_event_txdone_status_t ) record.status;
+            event->event_data.txdone.fcnt_up = record.payload.txdone.fcnt_up;
+            break;
+        case SMTC_MODEM_EVENT_DOWNDATA:
+            event->event_data.downdata.rssi  = record.payload.downdata.rssi;
+            event->event_data.downdata.snr   = record.payload.downdata.snr;
+            event->event_data.downdata.fport = record.payload.downdata.fport;
             break;
 
         case SMTC_MODEM_EVENT_LINK_CHECK:
-            event->event_data.link_check.status =
-                ( smtc_modem_event_mac_request_status_t ) get_modem_event_status( event->event_type );
+            event->event_data.link_check.status = ( smtc_modem_event_mac_request_status_t ) record.status;
             break;
 
         case SMTC_MODEM_EVENT_CLASS_B_PING_SLOT_INFO:
-            event->event_data.class_b_ping_slot_info.status =
-                ( smtc_modem_event_mac_request_status_t ) get_modem_event_status( event->event_type );
+            event->event_data.class_b_ping_slot_info.status = ( smtc_modem_event_mac_request_status_t ) record.status;
             break;
 
         case SMTC_MODEM_EVENT_CLASS_B_STATUS:
-            event->event_data.class_b_status.status =
-                ( smtc_modem_event_class_b_status_t ) get_modem_event_status( event->event_type );
+            event->event_data.class_b_status.status = ( smtc_modem_event_class_b_status_t ) record.status;
             break;
 
         case SMTC_MODEM_EVENT_LORAWAN_MAC_TIME:
-            event->event_data.lorawan_mac_time.status =
-                ( smtc_modem_event_mac_request_status_t ) get_modem_event_status( event->event_type );
+            event->event_data.lorawan_mac_time.status = ( smtc_modem_event_mac_request_status_t ) record.status;
             break;
         case SMTC_MODEM_EVENT_LORAWAN_FUOTA_DONE:
-            event->event_data.fuota_status.successful =
-                ( get_modem_event_status( event->event_type ) == 0 ) ? true : false;
+            event->event_data.fuota_status.successful = ( record.status == 0 ) ? true : false;
             break;
 
         case SMTC_MODEM_EVENT_NEW_MULTICAST_SESSION_CLASS_C:
-            event->event_data.new_multicast_class_c.group_id = get_modem_event_status( event->event_type );
+            event->event_data.new_multicast_class_c.group_id = record.status;
             break;
 
         case SMTC_MODEM_EVENT_NEW_MULTICAST_SESSION_CLASS_B:
-            event->event_data.new_multicast_class_b.group_id = get_modem_event_status( event->event_type );
+            event->event_data.new_multicast_class_b.group_id = record.status;
             break;
 
 #if defined( ENABLE_FUOTA_FMP )
         case SMTC_MODEM_EVENT_FIRMWARE_MANAGEMENT:
-            event->event_data.fmp.status = get_modem_event_status( event->event_type );
+            event->event_data.fmp.status = record.status;
             break;
 #endif
 
 #if defined( ADD_SMTC_CLOUD_DEVICE_MANAGEMENT )
         case SMTC_MODEM_EVENT_DM_SET_CONF:
-            event->event_data.setconf.opcode =
-                ( smtc_modem_event_setconf_opcode_t ) get_modem_event_status( event->event_type );
+            event->event_data.setconf.opcode = ( smtc_modem_event_setconf_opcode_t ) record.status;
             break;
         case SMTC_MODEM_EVENT_MUTE:
-            event->event_data.mute.status =
-                ( smtc_modem_event_mute_status_t ) get_modem_event_status( event->event_type );
+            event->event_data.mute.status = ( smtc_modem_event_mute_status_t ) record.status;
             break;
 #endif
+#if defined( ADD_SMTC_STREAM )
+        case SMTC_MODEM_EVENT_STREAM_DONE:
+            event->event_data.streamdone.stream_id = record.status;
+            break;
+#endif  // ADD_SMTC_STREAM
 #if defined( ADD_SMTC_LFU )
         case SMTC_MODEM_EVENT_UPLOAD_DONE:
-            event->event_data.uploaddone.status = get_modem_event_status( event->event_type );
+            event->event_data.uploaddone.status = record.status;
             break;
 #endif  // ADD_SMTC_LFU
 
-        case SMTC_MODEM_EVENT_DOWNDATA:
         case SMTC_MODEM_EVENT_ALARM:
         case SMTC_MODEM_EVENT_JOINED:
         case SMTC_MODEM_EVENT_JOINFAIL:
         case SMTC_MODEM_EVENT_ALCSYNC_TIME:
         case SMTC_MODEM_EVENT_NO_MORE_MULTICAST_SESSION_CLASS_C:
         case SMTC_MODEM_EVENT_NO_MORE_MULTICAST_SESSION_CLASS_B:
-#if defined( ADD_SMTC_STREAM )
-        case SMTC_MODEM_EVENT_STREAM_DONE:
-#endif
         default:
             break;
         }
-        // Reset the status after get the value
-        set_modem_event_count_and_status( event->event_type, 0, 0 );
-        decrement_asynchronous_msgnumber( );
     }
     else
     {
@@ -1278,6 +1278,25 @@ smtc_modem_return_code_t smtc_modem_lbt_get_state( uint8_t stack_id, bool* enabl
     return SMTC_MODEM_RC_OK;
 }
 
+smtc_modem_return_code_t smtc_modem_get_channel_access_stats( uint8_t stack_id, uint8_t index,
+                                                              smtc_modem_channel_access_stats_t* stats )
+{
+    RETURN_BUSY_IF_TEST_MODE( );
+    RETURN_INVALID_IF_NULL( stats );
+
+    smtc_ch_access_channel_stats_t channel_stats;
+    if( lorawan_api_get_channel_access_stats( index, &channel_stats, stack_id ) == false )
+    {
+        return SMTC_MODEM_RC_INVALID;
+    }
+    stats->freq_hz            = channel_stats.freq_hz;
+    stats->nb_listen          = channel_stats.nb_listen;
+    stats->nb_busy            = channel_stats.nb_busy;
+    stats->busy_ratio_percent = ( uint8_t ) ( channel_stats.busy_ratio_q8 >> 8 );
+    stats->noise_floor_dbm    = channel_stats.noise_floor_dbm;
+    return SMTC_MODEM_RC_OK;
+}
+
 #if defined( ADD_CSMA )
 smtc_modem_return_code_t smtc_modem_csma_set_state( uint8_t stack_id, bool enable )
 {
@@ -1498,6 +1517,26 @@ smtc_modem_return_code_t smtc_modem_set_class( uint8_t stack_id, smtc_modem_clas
     return SMTC_MODEM_RC_OK;
 }
 
+smtc_modem_return_code_t smtc_modem_class_c_get_deaf_time_stats( uint8_t                               stack_id,
+                                                                 smtc_modem_class_c_deaf_time_stats_t* stats )
+{
+#ifdef ADD_CLASS_C
+    RETURN_BUSY_IF_TEST_MODE( );
+    RETURN_INVALID_IF_NULL( stats );
+
+    lr1mac_class_c_deaf_stats_t deaf_stats;
+    lorawan_api_class_c_get_deaf_stats( &deaf_stats, stack_id );
+    stats->nb_interruption = deaf_stats.nb_interruption;
+    stats->nb_fast_rearm   = deaf_stats.nb_fast_rearm;
+    stats->last_deaf_ms    = deaf_stats.last_deaf_ms;
+    stats->max_deaf_ms     = deaf_stats.max_deaf_ms;
+    stats->total_deaf_ms   = deaf_stats.total_deaf_ms;
+    return SMTC_MODEM_RC_OK;
+#else   // ADD_CLASS_C
+    return SMTC_MODEM_RC_FAIL;
+#endif  // ADD_CLASS_C
+}
+
 smtc_modem_return_code_t smtc_modem_class_b_set_ping_slot_periodicity(
     uint8_t stack_id, smtc_modem_class_b_ping_slot_periodicity_t ping_slot_periodicity )
 {
@@ -2140,10 +2179,67 @@ smtc_modem_return_code_t smtc_modem_almanac_stop( uint8_t stack_id )
 smtc_modem_return_code_t smtc_modem_stream_init( uint8_t stack_id, uint8_t f_port,
                                                  smtc_modem_stream_cipher_mode_t cipher_mode,
                                                  uint8_t                         redundancy_ratio_percent )
+{
+    return smtc_modem_stream_object_init( stack_id, 0, f_port, cipher_mode, redundancy_ratio_percent, ROSE_DEFAULT_WL,
+                                          NULL, 0 );
+}
+
+smtc_modem_return_code_t smtc_modem_stream_add_data( uint8_t stack_id, const uint8_t* data, uint8_t len )
+{
+    RETURN_BUSY_IF_TEST_MODE( );
+    RETURN_INVALID_IF_NULL( data );
+
+    // Check if modem is joined, not suspended or muted
+    smtc_modem_status_mask_t status_mask = modem_get_status( stack_id );
+    if( ( ( status_mask & SMTC_MODEM_STATUS_JOINED ) != SMTC_MODEM_STATUS_JOINED ) ||
+        ( ( status_mask & SMTC_MODEM_STATUS_MUTE ) == SMTC_MODEM_STATUS_MUTE ) ||
+        ( ( status_mask & SMTC_MODEM_STATUS_SUSPEND ) == SMTC_MODEM_STATUS_SUSPEND ) )
+    {
+        return SMTC_MODEM_RC_FAIL;
+    }
+
+    // No existing stream
+    if( stream_get_init_status( stack_id, 0 ) == false )
+    {
+        smtc_modem_return_code_t rc;
+        // Start new unencrypted session with rr to 110% on dm port
+
+        uint8_t dm_port;
+#if defined( ADD_SMTC_CLOUD_DEVICE_MANAGEMENT )
+        dm_port = cloud_dm_get_dm_port( stack_id );
+#else
+        dm_port = DM_PORT;
+#endif
+
+        rc = smtc_modem_stream_init( stack_id, dm_port, SMTC_MODEM_STREAM_NO_CIPHER, ROSE_DEFAULT_RR );
+        if( rc != SMTC_MODEM_RC_OK )
+        {
+            SMTC_MODEM_HAL_TRACE_ERROR( "Stream implicit init failed\n" );
+            return rc;
+        }
+    }
+
+    return smtc_modem_stream_object_add_data( stack_id, 0, data, len );
+}
+
+smtc_modem_return_code_t smtc_modem_stream_status( uint8_t stack_id, uint16_t* pending, uint16_t* free )
+{
+    return smtc_modem_stream_object_status( stack_id, 0, pending, free );
+}
+
+smtc_modem_return_code_t smtc_modem_stream_object_init( uint8_t stack_id, uint8_t stream_id, uint8_t f_port,
+                                                        smtc_modem_stream_cipher_mode_t cipher_mode,
+                                                        uint8_t redundancy_ratio_percent, uint16_t window_length,
+                                                        uint8_t* fifo, uint16_t fifo_size )
 {
     RETURN_BUSY_IF_TEST_MODE( );
 
     // Check parameters validity
+    if( stream_id >= STREAM_NB_OBJECTS )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "STREAM_INIT stream_id invalid\n" );
+        return SMTC_MODEM_RC_INVALID;
+    }
     if( f_port >= 224 )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "STREAM_INIT f_port invalid\n" );
@@ -2154,6 +2250,16 @@ smtc_modem_return_code_t smtc_modem_stream_init( uint8_t stack_id, uint8_t f_por
         SMTC_MODEM_HAL_TRACE_ERROR( "STREAM_INIT encryption mode invalid\n" );
         return SMTC_MODEM_RC_INVALID;
     }
+    if( ( window_length == 0 ) || ( window_length > ROSE_MAX_WL ) )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "STREAM_INIT window length invalid\n" );
+        return SMTC_MODEM_RC_INVALID;
+    }
+    if( ( ( fifo == NULL ) && ( stream_id != 0 ) ) || ( ( ( uintptr_t ) fifo & 3 ) != 0 ) )
+    {
+        SMTC_MODEM_HAL_TRACE_ERROR( "STREAM_INIT buffer invalid\n" );
+        return SMTC_MODEM_RC_INVALID;
+    }
 
     // If parameter f_port is set to 0 => use current dm port
     if( f_port == 0 )
@@ -2168,8 +2274,8 @@ smtc_modem_return_code_t smtc_modem_stream_init( uint8_t stack_id, uint8_t f_por
     }
 
     // initialize stream session
-    if( stream_init( stack_id, f_port, ( cipher_mode == SMTC_MODEM_STREAM_AES_WITH_APPSKEY ),
-                     redundancy_ratio_percent ) != STREAM_OK )
+    if( stream_init( stack_id, stream_id, f_port, ( cipher_mode == SMTC_MODEM_STREAM_AES_WITH_APPSKEY ),
+                     redundancy_ratio_percent, window_length, fifo, fifo_size ) != STREAM_OK )
     {
         SMTC_MODEM_HAL_TRACE_ERROR( "STREAM_INIT FAILED\n" );
         return SMTC_MODEM_RC_FAIL;
@@ -2178,11 +2284,17 @@ smtc_modem_return_code_t smtc_modem_stream_init( uint8_t stack_id, uint8_t f_por
     return SMTC_MODEM_RC_OK;
 }
 
-smtc_modem_return_code_t smtc_modem_stream_add_data( uint8_t stack_id, const uint8_t* data, uint8_t len )
+smtc_modem_return_code_t smtc_modem_stream_object_add_data( uint8_t stack_id, uint8_t stream_id, const uint8_t* data,
+                                                            uint8_t len )
 {
     RETURN_BUSY_IF_TEST_MODE( );
     RETURN_INVALID_IF_NULL( data );
 
+    if( stream_id >= STREAM_NB_OBJECTS )
+    {
+        return SMTC_MODEM_RC_INVALID;
+    }
+
     // Check if modem is joined, not suspended or muted
     smtc_modem_status_mask_t status_mask = modem_get_status( stack_id );
     if( ( ( status_mask & SMTC_MODEM_STATUS_JOINED ) != SMTC_MODEM_STATUS_JOINED ) ||
@@ -2192,28 +2304,12 @@ smtc_modem_return_code_t smtc_modem_stream_add_data( uint8_t stack_id, const uin
         return SMTC_MODEM_RC_FAIL;
     }
 
-    // No existing stream
-    if( stream_get_init_status( stack_id ) == false )
+    if( stream_get_init_status( stack_id, stream_id ) == false )
     {
-        smtc_modem_return_code_t rc;
-        // Start new unencrypted session with rr to 110% on dm port
-
-        uint8_t dm_port;
-#if defined( ADD_SMTC_CLOUD_DEVICE_MANAGEMENT )
-        dm_port = cloud_dm_get_dm_port( stack_id );
-#else
-        dm_port = DM_PORT;
-#endif
-
-        rc = smtc_modem_stream_init( stack_id, dm_port, SMTC_MODEM_STREAM_NO_CIPHER, ROSE_DEFAULT_RR );
-        if( rc != SMTC_MODEM_RC_OK )
-        {
-            SMTC_MODEM_HAL_TRACE_ERROR( "Stream implicit init failed\n" );
-            return rc;
-        }
+        return SMTC_MODEM_RC_NOT_INIT;
     }
 
-    stream_return_code_t stream_rc = stream_add_data( stack_id, data, len );
+    stream_return_code_t stream_rc = stream_add_data( stack_id, stream_id, data, len );
 
     switch( stream_rc )
     {
@@ -2234,18 +2330,24 @@ smtc_modem_return_code_t smtc_modem_stream_add_data( uint8_t stack_id, const uin
     return SMTC_MODEM_RC_OK;
 }
 
-smtc_modem_return_code_t smtc_modem_stream_status( uint8_t stack_id, uint16_t* pending, uint16_t* free )
+smtc_modem_return_code_t smtc_modem_stream_object_status( uint8_t stack_id, uint8_t stream_id, uint16_t* pending,
+                                                          uint16_t* free )
 {
     RETURN_BUSY_IF_TEST_MODE( );
     RETURN_INVALID_IF_NULL( pending );
     RETURN_INVALID_IF_NULL( free );
 
-    if( stream_get_init_status( stack_id ) == false )
+    if( stream_id >= STREAM_NB_OBJECTS )
+    {
+        return SMTC_MODEM_RC_INVALID;
+    }
+
+    if( stream_get_init_status( stack_id, stream_id ) == false )
     {
         return SMTC_MODEM_RC_NOT_INIT;
     }
 
-    stream_status( stack_id, pending, free );
+    stream_status( stack_id, stream_id, pending, free );
     return SMTC_MODEM_RC_OK;
 }
 #endif  // ADD_SMTC_STREAM
@@ -2442,6 +2544,23 @@ smtc_modem_return_code_t smtc_modem_file_upload_init( uint8_t stack_id, uint8_t
                                         ( uint8_t ) cipher_mode )];
 }
 
+smtc_modem_return_code_t smtc_modem_file_upload_init_from_callback( uint8_t stack_id, uint8_t index,
+                                                                    smtc_modem_file_upload_cipher_mode_t cipher_mode,
+                                                                    smtc_modem_file_upload_read_f read_callback,
+                                                                    uint16_t file_length, uint32_t average_delay_s )
+{
+    RETURN_BUSY_IF_TEST_MODE( );
+    RETURN_INVALID_IF_NULL( read_callback );
+
+    if( cipher_mode > SMTC_MODEM_FILE_UPLOAD_AES_WITH_APPSKEY )
+    {
+        return SMTC_MODEM_RC_INVALID;
+    }
+
+    return lfu_rc_lut[file_upload_init_from_callback( stack_id, read_callback, ( uint32_t ) file_length,
+                                                      average_delay_s, index, ( uint8_t ) cipher_mode )];
+}
+
 smtc_modem_return_code_t smtc_modem_file_upload_start( uint8_t stack_id )
 {
     RETURN_BUSY_IF_TEST_MODE( );
@@ -66,6 +66,11 @@
  */
 #define MIC_BLOCK_BX_SIZE 16
 
+// The lr11xx key storage has slots for 4 multicast groups only
+#if( SMTC_SE_MC_NB_KEY_GROUPS > 4 )
+#error "lr11xx crypto engine supports 4 multicast groups at most, use the soft secure element"
+#endif
+
 /**
  * Maximum size of the message that can be handled by the crypto operations
  */
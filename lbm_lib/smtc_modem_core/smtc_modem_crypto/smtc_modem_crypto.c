@@ -58,7 +58,7 @@
 /*
  * Number multicast security contexts
  */
-#define NUM_OF_MC_SEC_CTX 4
+#define NUM_OF_MC_SEC_CTX SMTC_SE_MC_NB_KEY_GROUPS
 
 /*
  * Maximum size of the message that can be handled by the crypto operations
@@ -80,6 +80,11 @@
  */
 #define LORAWAN_VERSION_1_0_X_MINOR_VALUE 0
 
+/*
+ * Number of key stream blocks requested from the secure element at once by the service encryption
+ */
+#define SERVICE_ENCRYPT_BATCH_BLOCKS 4
+
 /*
  * -----------------------------------------------------------------------------
  * --- PRIVATE TYPES -----------------------------------------------------------
@@ -103,16 +108,6 @@ typedef struct smtc_crypto_key_addr_s
  *--- PRIVATE VARIABLES -------------------------------------------------------------
  */
 
-/*
- * Key-Address list
- */
-static smtc_crypto_key_addr_t smtc_crypto_key_addr_list[NUM_OF_MC_SEC_CTX] = {
-    { SMTC_MODEM_CRYPTO_MULTICAST_0_ADDR, SMTC_SE_MC_APP_S_KEY_0, SMTC_SE_MC_NWK_S_KEY_0, SMTC_SE_MC_KEY_0 },
-    { SMTC_MODEM_CRYPTO_MULTICAST_1_ADDR, SMTC_SE_MC_APP_S_KEY_1, SMTC_SE_MC_NWK_S_KEY_1, SMTC_SE_MC_KEY_1 },
-    { SMTC_MODEM_CRYPTO_MULTICAST_2_ADDR, SMTC_SE_MC_APP_S_KEY_2, SMTC_SE_MC_NWK_S_KEY_2, SMTC_SE_MC_KEY_2 },
-    { SMTC_MODEM_CRYPTO_MULTICAST_3_ADDR, SMTC_SE_MC_APP_S_KEY_3, SMTC_SE_MC_NWK_S_KEY_3, SMTC_SE_MC_KEY_3 },
-};
-
 /*
  *-----------------------------------------------------------------------------------
  *--- PRIVATE FUNCTIONS DECLARATION -------------------------------------------------
@@ -177,12 +172,12 @@ static smtc_modem_crypto_return_code_t derive_multicast_key_encryption_key( uint
 /**
  * @brief Get key addr item from address
  *
- * @param [in] addr_id Address identifier
- * @param [in] itemKey item reference
+ * @param [in]  addr_id Address identifier
+ * @param [out] item    Keys of the address
  * @return smtc_modem_crypto_return_code_t
  */
 static smtc_modem_crypto_return_code_t get_key_addr_item( smtc_modem_crypto_addr_id_t addr_id,
-                                                          smtc_crypto_key_addr_t**    item );
+                                                          smtc_crypto_key_addr_t*     item );
 
 /*
  *-----------------------------------------------------------------------------------
@@ -382,7 +377,7 @@ smtc_modem_crypto_return_code_t smtc_modem_crypto_derive_multicast_session_keys(
     {
         return SMTC_MODEM_CRYPTO_RC_ERROR_NPE;
     }
-    if( addr_id > SMTC_MODEM_CRYPTO_MULTICAST_3_ADDR )
+    if( addr_id >= NUM_OF_MC_SEC_CTX )
     {
         return SMTC_MODEM_CRYPTO_RC_ERROR_INVALID_ADDR_ID;
     }
@@ -390,7 +385,7 @@ smtc_modem_crypto_return_code_t smtc_modem_crypto_derive_multicast_session_keys(
     smtc_modem_crypto_return_code_t rc = SMTC_MODEM_CRYPTO_RC_ERROR;
 
     // Determine current security context
-    smtc_crypto_key_addr_t* cur_item;
+    smtc_crypto_key_addr_t cur_item;
     rc = get_key_addr_item( addr_id, &cur_item );
     if( rc != SMTC_MODEM_CRYPTO_RC_SUCCESS )
     {
@@ -415,13 +410,13 @@ smtc_modem_crypto_return_code_t smtc_modem_crypto_derive_multicast_session_keys(
     comp_base_nwk_s[3] = ( mc_addr >> 16 ) & 0xFF;
     comp_base_nwk_s[4] = ( mc_addr >> 24 ) & 0xFF;
 
-    if( smtc_secure_element_derive_and_store_key( comp_base_app_s, cur_item->root_key, cur_item->app_skey, stack_id ) !=
+    if( smtc_secure_element_derive_and_store_key( comp_base_app_s, cur_item.root_key, cur_item.app_skey, stack_id ) !=
         SMTC_SE_RC_SUCCESS )
     {
         return SMTC_MODEM_CRYPTO_RC_ERROR_SECURE_ELEMENT;
     }
 
-    if( smtc_secure_element_derive_and_store_key( comp_base_nwk_s, cur_item->root_key, cur_item->nwk_skey, stack_id ) !=
+    if( smtc_secure_element_derive_and_store_key( comp_base_nwk_s, cur_item.root_key, cur_item.nwk_skey, stack_id ) !=
         SMTC_SE_RC_SUCCESS )
     {
         return SMTC_MODEM_CRYPTO_RC_ERROR_SECURE_ELEMENT;
@@ -464,39 +459,55 @@ smtc_modem_crypto_return_code_t smtc_modem_crypto_get_class_b_rand( uint32_t bea
 smtc_modem_crypto_return_code_t smtc_modem_crypto_service_encrypt( const uint8_t* clear_buff, uint16_t len,
                                                                    uint8_t nonce[14], uint8_t* enc_buff,
                                                                    uint8_t stack_id )
+{
+    return smtc_modem_crypto_service_encrypt_from_block( clear_buff, len, nonce, 0, enc_buff, stack_id );
+}
+
+smtc_modem_crypto_return_code_t smtc_modem_crypto_service_encrypt_from_block( const uint8_t* clear_buff, uint16_t len,
+                                                                              uint8_t nonce[14], uint16_t first_block,
+                                                                              uint8_t* enc_buff, uint8_t stack_id )
 {
     if( ( clear_buff == 0 ) || ( enc_buff == 0 ) )
     {
         return SMTC_MODEM_CRYPTO_RC_ERROR_NPE;
     }
 
-    uint16_t index       = 0;
-    uint16_t ctr         = 1;
-    uint8_t  s_block[16] = { 0 };
-    uint8_t  a_block[16] = { 0 };
-    int16_t  local_size  = len;
-
-    // first copy the 14 bytes of nonce into a_block first 14 bytes
-    memcpy( a_block, nonce, 14 );
+    uint16_t index = 0;
+    uint16_t ctr   = 1 + first_block;
+    uint8_t  s_blocks[SERVICE_ENCRYPT_BATCH_BLOCKS * 16];
+    uint8_t  a_blocks[SERVICE_ENCRYPT_BATCH_BLOCKS * 16];
+    int16_t  local_size = len;
 
     while( local_size > 0 )
     {
-        a_block[15] = ctr & 0xFF;
-        a_block[14] = ( ctr >> 8 ) & 0xFF;
-
-        ctr++;
+        // Build the a blocks of a whole batch so the key stream is produced by a single secure element request
+        uint16_t nb_blocks = ( local_size + 15 ) >> 4;
+        if( nb_blocks > SERVICE_ENCRYPT_BATCH_BLOCKS )
+        {
+            nb_blocks = SERVICE_ENCRYPT_BATCH_BLOCKS;
+        }
+        for( uint16_t b = 0; b < nb_blocks; b++ )
+        {
+            uint8_t* a_block = &a_blocks[b << 4];
+            memcpy( a_block, nonce, 14 );
+            a_block[15] = ctr & 0xFF;
+            a_block[14] = ( ctr >> 8 ) & 0xFF;
+            ctr++;
+        }
 
-        if( smtc_secure_element_aes_encrypt( a_block, 16, SMTC_SE_APP_S_KEY, s_block, stack_id ) != SMTC_SE_RC_SUCCESS )
+        if( smtc_secure_element_aes_encrypt( a_blocks, nb_blocks << 4, SMTC_SE_APP_S_KEY, s_blocks, stack_id ) !=
+            SMTC_SE_RC_SUCCESS )
         {
             return SMTC_MODEM_CRYPTO_RC_ERROR_SECURE_ELEMENT;
         }
 
-        for( uint8_t i = 0; i < ( ( local_size > 16 ) ? 16 : local_size ); i++ )
+        uint8_t batch_len = ( local_size > ( nb_blocks << 4 ) ) ? ( nb_blocks << 4 ) : local_size;
+        for( uint8_t i = 0; i < batch_len; i++ )
         {
-            enc_buff[index + i] = clear_buff[index + i] ^ s_block[i];
+            enc_buff[index + i] = clear_buff[index + i] ^ s_blocks[i];
         }
-        local_size -= 16;
-        index += 16;
+        local_size -= batch_len;
+        index += batch_len;
     }
 
     return SMTC_MODEM_CRYPTO_RC_SUCCESS;
@@ -635,17 +646,17 @@ static smtc_modem_crypto_return_code_t derive_multicast_key_encryption_key( uint
 }
 
 static smtc_modem_crypto_return_code_t get_key_addr_item( smtc_modem_crypto_addr_id_t addr_id,
-                                                          smtc_crypto_key_addr_t**    item )
+                                                          smtc_crypto_key_addr_t*     item )
 {
-    for( uint8_t i = 0; i < NUM_OF_MC_SEC_CTX; i++ )
+    if( addr_id >= NUM_OF_MC_SEC_CTX )
     {
-        if( smtc_crypto_key_addr_list[i].addr_id == addr_id )
-        {
-            *item = &( smtc_crypto_key_addr_list[i] );
-            return SMTC_MODEM_CRYPTO_RC_SUCCESS;
-        }
+        return SMTC_MODEM_CRYPTO_RC_ERROR_INVALID_ADDR_ID;
     }
-    return SMTC_MODEM_CRYPTO_RC_ERROR_INVALID_ADDR_ID;
+    item->addr_id  = addr_id;
+    item->app_skey = SMTC_SE_MC_APP_S_KEY( addr_id );
+    item->nwk_skey = SMTC_SE_MC_NWK_S_KEY( addr_id );
+    item->root_key = SMTC_SE_MC_KEY( addr_id );
+    return SMTC_MODEM_CRYPTO_RC_SUCCESS;
 }
 
 /* --- EOF ------------------------------------------------------------------ */
@@ -109,11 +109,11 @@ typedef enum smtc_modem_crypto_return_code_e
  */
 typedef enum smtc_modem_crypto_addr_id_e
 {
-    SMTC_MODEM_CRYPTO_MULTICAST_0_ADDR = 0,  //!< Multicast Address 0
-    SMTC_MODEM_CRYPTO_MULTICAST_1_ADDR = 1,  //!< Multicast Address 1
-    SMTC_MODEM_CRYPTO_MULTICAST_2_ADDR = 2,  //!< Multicast Address 2
-    SMTC_MODEM_CRYPTO_MULTICAST_3_ADDR = 3,  //!< Multicast Address 3
-    SMTC_MODEM_CRYPTO_UNICAST_DEV_ADDR = 4,  //!< Unicast End-device address
+    SMTC_MODEM_CRYPTO_MULTICAST_0_ADDR = 0,     //!< Multicast Address 0
+    SMTC_MODEM_CRYPTO_MULTICAST_1_ADDR = 1,     //!< Multicast Address 1
+    SMTC_MODEM_CRYPTO_MULTICAST_2_ADDR = 2,     //!< Multicast Address 2
+    SMTC_MODEM_CRYPTO_MULTICAST_3_ADDR = 3,     //!< Multicast Address 3, up to SMTC_MULTICAST_NB_GROUPS - 1
+    SMTC_MODEM_CRYPTO_UNICAST_DEV_ADDR = 0xFF,  //!< Unicast End-device address
 } smtc_modem_crypto_addr_id_t;
 
 /*
@@ -262,6 +262,23 @@ smtc_modem_crypto_return_code_t smtc_modem_crypto_get_class_b_rand( uint32_t bea
 smtc_modem_crypto_return_code_t smtc_modem_crypto_service_encrypt( const uint8_t* clear_buff, uint16_t len,
                                                                    uint8_t nonce[14], uint8_t* enc_buff, uint8_t stack_id );
 
+/**
+ * @brief Encryption function for modem services, starting at a given 16 bytes block of the encrypted data
+ *
+ * @remark Encrypting a buffer piece by piece at the block offset of each piece gives the same result as
+ * smtc_modem_crypto_service_encrypt on the whole buffer
+ *
+ * @param [in]  clear_buff  Clear buffer
+ * @param [in]  len         Buffer length
+ * @param [in]  nonce       Nonce to be used
+ * @param [in]  first_block Index of the 16 bytes block of the encrypted data clear_buff starts at
+ * @param [out] enc_buff    Encrypted buffer
+ * @return smtc_modem_crypto_return_code_t
+ */
+smtc_modem_crypto_return_code_t smtc_modem_crypto_service_encrypt_from_block( const uint8_t* clear_buff, uint16_t len,
+                                                                              uint8_t nonce[14], uint16_t first_block,
+                                                                              uint8_t* enc_buff, uint8_t stack_id );
+
 #ifdef __cplusplus
 }
 #endif
@@ -49,6 +49,13 @@ extern "C" {
  * --- PUBLIC MACROS -----------------------------------------------------------
  */
 
+/*!
+ * Multicast group key identifiers, the three keys of a group follow each other in @ref smtc_se_key_identifier_t
+ */
+#define SMTC_SE_MC_KEY( grp )       ( ( smtc_se_key_identifier_t ) ( SMTC_SE_MC_KEY_0 + ( 3 * ( grp ) ) ) )
+#define SMTC_SE_MC_APP_S_KEY( grp ) ( ( smtc_se_key_identifier_t ) ( SMTC_SE_MC_APP_S_KEY_0 + ( 3 * ( grp ) ) ) )
+#define SMTC_SE_MC_NWK_S_KEY( grp ) ( ( smtc_se_key_identifier_t ) ( SMTC_SE_MC_NWK_S_KEY_0 + ( 3 * ( grp ) ) ) )
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC CONSTANTS --------------------------------------------------------
@@ -74,6 +81,25 @@ extern "C" {
  */
 #define SMTC_SE_MULTICAST_KEYS 127
 
+/*!
+ * Number of multicast groups supported by the stack, can be overridden at build time
+ */
+#ifndef SMTC_MULTICAST_NB_GROUPS
+#define SMTC_MULTICAST_NB_GROUPS 4
+#endif
+#if( SMTC_MULTICAST_NB_GROUPS < 1 )
+#error "SMTC_MULTICAST_NB_GROUPS shall be at least 1"
+#endif
+
+/*!
+ * Number of multicast groups with keys in the secure element, groups 0 to 3 are always present
+ */
+#if( SMTC_MULTICAST_NB_GROUPS > 4 )
+#define SMTC_SE_MC_NB_KEY_GROUPS SMTC_MULTICAST_NB_GROUPS
+#else
+#define SMTC_SE_MC_NB_KEY_GROUPS 4
+#endif
+
 /*
  * -----------------------------------------------------------------------------
  * --- PUBLIC TYPES ------------------------------------------------------------
@@ -139,6 +165,9 @@ typedef enum smtc_se_key_identifier_e
     SMTC_SE_MC_KEY_3,                            //!< Multicast root key index 3
     SMTC_SE_MC_APP_S_KEY_3,                      //!< Multicast Application session key index 3
     SMTC_SE_MC_NWK_S_KEY_3,                      //!< Multicast Network session key index 3
+#if( SMTC_SE_MC_NB_KEY_GROUPS > 4 )
+    SMTC_SE_MC_NWK_S_KEY_LAST = SMTC_SE_MC_NWK_S_KEY_0 + ( 3 * ( SMTC_SE_MC_NB_KEY_GROUPS - 1 ) ),  //!< Groups above 3
+#endif
     SMTC_RELAY_ROOT_WOR_S_KEY,                   //!< Relay Root Session Key
     SMTC_RELAY_WOR_S_INT_KEY,                    //!< Relay WOR Integrity Session Key
     SMTC_RELAY_WOR_S_ENC_KEY,                    //!< Relay WOR Encryption Session Key
@@ -61,9 +61,14 @@
  */
 
 /*!
- * Number of keys supported in soft secure element
+ * Number of keys in the static key list
  */
-#define SOFT_SE_NUMBER_OF_KEYS 26
+#define SOFT_SE_NUMBER_OF_STATIC_KEYS 26
+
+/*!
+ * Number of keys supported in soft secure element, keys of multicast groups above 3 follow the static key list
+ */
+#define SOFT_SE_NUMBER_OF_KEYS ( SOFT_SE_NUMBER_OF_STATIC_KEYS + ( 3 * ( SMTC_SE_MC_NB_KEY_GROUPS - 4 ) ) )
 
 /*!
  * JoinAccept frame maximum size
@@ -400,6 +405,14 @@ smtc_se_return_code_t smtc_secure_element_init( void )
                                   .joineui  = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
                                   .pin      = { 0x00, 0x00, 0x00, 0x00 },
                                   .key_list = SOFT_SE_KEY_LIST };
+    for( uint8_t grp = 4; grp < SMTC_SE_MC_NB_KEY_GROUPS; grp++ )
+    {
+        soft_se_key_t* mc_keys = &local_data.key_list[SOFT_SE_NUMBER_OF_STATIC_KEYS + ( 3 * ( grp - 4 ) )];
+
+        mc_keys[0].key_id = SMTC_SE_MC_KEY( grp );
+        mc_keys[1].key_id = SMTC_SE_MC_APP_S_KEY( grp );
+        mc_keys[2].key_id = SMTC_SE_MC_NWK_S_KEY( grp );
+    }
     // init soft secure element data euis and pin to 0 and key_list with empty lut
     for( uint8_t stack_id = 0; stack_id < NUMBER_OF_STACKS; stack_id++ )
     {
@@ -422,8 +435,8 @@ smtc_se_return_code_t smtc_secure_element_set_key( smtc_se_key_identifier_t key_
     {
         if( soft_se_data[stack_id].key_list[i].key_id == key_id )
         {
-            if( ( key_id == SMTC_SE_MC_KEY_0 ) || ( key_id == SMTC_SE_MC_KEY_1 ) || ( key_id == SMTC_SE_MC_KEY_2 ) ||
-                ( key_id == SMTC_SE_MC_KEY_3 ) )
+            if( ( key_id >= SMTC_SE_MC_KEY_0 ) && ( key_id <= SMTC_SE_MC_KEY( SMTC_SE_MC_NB_KEY_GROUPS - 1 ) ) &&
+                ( ( ( key_id - SMTC_SE_MC_KEY_0 ) % 3 ) == 0 ) )
             {  // Decrypt the key if its a Mckey
                 smtc_se_return_code_t rc                = SMTC_SE_RC_ERROR;
                 uint8_t               decrypted_key[16] = { 0 };
@@ -105,6 +105,8 @@ typedef enum
     CONTEXT_FUOTA,
     CONTEXT_SECURE_ELEMENT,
     CONTEXT_STORE_AND_FORWARD,
+    CONTEXT_LORAWAN_STACK_JOURNAL,
+    CONTEXT_FUOTA_MATRIX,
 } modem_context_type_t;
 
 /*
@@ -219,7 +221,8 @@ void smtc_modem_hal_context_store( const modem_context_type_t ctx_type, uint32_t
 
 /**
  * @brief Erase a chosen number of flash pages of a context
- * @remark This function is only used with CONTEXT_STORE_AND_FORWARD
+ * @remark This function is only used with CONTEXT_STORE_AND_FORWARD, CONTEXT_LORAWAN_STACK_JOURNAL and
+ * CONTEXT_FUOTA_MATRIX
  *
  * @param [in] ctx_type   Type of modem context that need to be erased
  * @param [in] offset     Memory offset after ctx_type address